@@ -27,6 +27,10 @@ complex_mode = (sys.argv[-1] == "1")
 # Directories to scan
 subdirs = ["demo", "test"]
 
+# Directories with forms for single precision, which are compiled for
+# float in both real and complex mode
+float_dirs = [os.path.join("demo", "single-precision")]
+
 # Compile all form files
 topdir = os.getcwd()
 failures = []
@@ -42,7 +46,9 @@ for subdir in subdirs:
         print("Compiling %d forms in %s..." % (len(formfiles), root))
         for f in set(formfiles):
             args = []
-            if complex_mode:
+            if root in float_dirs:
+                args += ["--scalar_type", "float"]
+            elif complex_mode:
                 args += ["--scalar_type", "double complex"]
             args.append(f)
             try:
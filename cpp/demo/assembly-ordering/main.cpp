@@ -0,0 +1,184 @@
+// Assembly cell ordering benchmark (C++)
+// ======================================
+//
+// This program measures the effect of the cell traversal order used in
+// assembly (see mesh::compute_cell_traversal_order) on the assembly of
+// the Laplace operator and a source term on a tetrahedral mesh of the
+// unit cube. For the storage order, the Morton order and the reverse
+// Cuthill-McKee order it reports the assembly times and, on Linux where
+// hardware performance counters are accessible, the number of cache
+// misses of the calling thread (run with ``OMP_NUM_THREADS=1`` for
+// comparable numbers).
+//
+// Usage: ``demo_assembly-ordering [n]``, where ``n`` is the number of
+// cells in each direction (default 24).
+
+#include "laplace.h"
+#include <chrono>
+#include <cstdlib>
+#include <dolfinx.h>
+#include <dolfinx/fem/petsc.h>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace dolfinx;
+
+namespace
+{
+// Counter for hardware cache misses of the calling thread, using Linux
+// perf events. Returns -1 if the counter is not available.
+class CacheMissCounter
+{
+public:
+  CacheMissCounter()
+  {
+#ifdef __linux__
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    _fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~CacheMissCounter()
+  {
+#ifdef __linux__
+    if (_fd >= 0)
+      close(_fd);
+#endif
+  }
+
+  void start()
+  {
+#ifdef __linux__
+    if (_fd >= 0)
+    {
+      ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  long long stop()
+  {
+    long long count = -1;
+#ifdef __linux__
+    if (_fd >= 0)
+    {
+      ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(_fd, &count, sizeof(count)) != sizeof(count))
+        count = -1;
+    }
+#endif
+    return count;
+  }
+
+private:
+  int _fd = -1;
+};
+
+// Assemble the matrix and vector, and return the time (s) and number of
+// cache misses for each
+std::array<std::pair<double, long long>, 2>
+assemble(const fem::Form<PetscScalar>& a, const fem::Form<PetscScalar>& L,
+         Mat A, Vec b, CacheMissCounter& counter)
+{
+  std::array<std::pair<double, long long>, 2> result;
+
+  MatZeroEntries(A);
+  auto t0 = std::chrono::steady_clock::now();
+  counter.start();
+  fem::assemble_matrix(la::PETScMatrix::add_fn(A), a, {});
+  result[0].second = counter.stop();
+  auto t1 = std::chrono::steady_clock::now();
+  result[0].first = std::chrono::duration<double>(t1 - t0).count();
+  MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
+  MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
+
+  VecSet(b, 0.0);
+  t0 = std::chrono::steady_clock::now();
+  counter.start();
+  fem::assemble_vector_petsc(b, L);
+  result[1].second = counter.stop();
+  t1 = std::chrono::steady_clock::now();
+  result[1].first = std::chrono::duration<double>(t1 - t0).count();
+
+  return result;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  const std::size_t n = argc > 1 ? std::atoi(argv[1]) : 24;
+
+  // Create mesh and function space
+  auto cmap = fem::create_coordinate_map(create_coordinate_map_laplace);
+  std::array pt{Eigen::Vector3d(0.0, 0.0, 0.0), Eigen::Vector3d(1.0, 1.0, 1.0)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::BoxMesh::create(
+      MPI_COMM_WORLD, pt, {{n, n, n}}, cmap, mesh::GhostMode::none));
+  auto V = fem::create_functionspace(create_functionspace_form_laplace_a, "u",
+                                     mesh);
+
+  auto f = std::make_shared<function::Function<PetscScalar>>(V);
+  f->interpolate([](auto& x) { return x.row(0) * x.row(1) + x.row(2); });
+
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  if (rank == 0)
+  {
+    std::cout << "Cells (global): "
+              << mesh->topology().index_map(3)->size_global() << std::endl;
+    std::cout << std::left << std::setw(24) << "Ordering" << std::setw(14)
+              << "Matrix (s)" << std::setw(18) << "Matrix misses"
+              << std::setw(14) << "Vector (s)" << std::setw(18)
+              << "Vector misses" << std::endl;
+  }
+
+  CacheMissCounter counter;
+  const std::vector<std::pair<std::string, std::optional<mesh::CellOrdering>>>
+      orderings = {{"storage", std::nullopt},
+                   {"morton", mesh::CellOrdering::morton},
+                   {"reverse_cuthill_mckee",
+                    mesh::CellOrdering::reverse_cuthill_mckee}};
+  for (const auto& [name, ordering] : orderings)
+  {
+    // Set traversal order before creating the forms
+    std::vector<std::int32_t> order;
+    if (ordering)
+      order = mesh::compute_cell_traversal_order(*mesh, *ordering);
+    mesh->topology_mutable().set_cell_traversal_order(order);
+
+    auto a = fem::create_form<PetscScalar>(create_form_laplace_a, {V, V});
+    auto L = fem::create_form<PetscScalar>(create_form_laplace_L, {V});
+    L->set_coefficients({{"f", f}});
+
+    la::PETScMatrix A = fem::create_matrix(*a);
+    la::PETScVector b(*V->dofmap()->index_map);
+
+    // Warm up, then measure
+    assemble(*a, *L, A.mat(), b.vec(), counter);
+    const auto [mat, vec] = assemble(*a, *L, A.mat(), b.vec(), counter);
+    if (rank == 0)
+    {
+      std::cout << std::left << std::setw(24) << name << std::setw(14)
+                << mat.first << std::setw(18) << mat.second << std::setw(14)
+                << vec.first << std::setw(18) << vec.second << std::endl;
+    }
+  }
+
+  return 0;
+}
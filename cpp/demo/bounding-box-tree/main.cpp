@@ -0,0 +1,94 @@
+// Bounding box tree benchmark (C++)
+// =================================
+//
+// This program measures the construction of a bounding box tree for the
+// cells of a tetrahedral mesh of the unit cube with the median split
+// builder (``geometry::TreeBuilder::median``) and the linear BVH
+// builder (``geometry::TreeBuilder::lbvh``), and the location of a set
+// of random points in the mesh with each tree using the batched point
+// queries (``geometry::compute_collisions`` and
+// ``geometry::select_colliding_cells``). Run with ``OMP_NUM_THREADS``
+// set to measure the threaded construction and queries.
+//
+// Usage: ``demo_bounding-box-tree [num_cells] [num_points]``, where
+// ``num_cells`` is the approximate number of cells (default 10000)
+// and ``num_points`` is the number of points (default 10000). The
+// mesh has :math:`6 n^3` cells, with :math:`n` the number of cubes in
+// each direction. The defaults are a quick check, e.g. for testing.
+// For benchmarking, pass large sizes, e.g.
+// ``demo_bounding-box-tree 1e7 1000000``.
+
+#include "mesh.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <dolfinx.h>
+#include <dolfinx/geometry/utils.h>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace dolfinx;
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  const double num_cells = argc > 1 ? std::atof(argv[1]) : 1.0e4;
+  const int num_points = argc > 2 ? std::atof(argv[2]) : 10000;
+  const std::size_t n = std::max(1.0, std::round(std::cbrt(num_cells / 6)));
+
+  // Create mesh on a single process
+  auto cmap = fem::create_coordinate_map(create_coordinate_map_mesh);
+  std::array pt{Eigen::Vector3d(0.0, 0.0, 0.0), Eigen::Vector3d(1.0, 1.0, 1.0)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::BoxMesh::create(
+      MPI_COMM_SELF, pt, {{n, n, n}}, cmap, mesh::GhostMode::none));
+  mesh->topology_mutable().create_connectivity(3, 3);
+
+  // Random points in the unit cube
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> points(num_points,
+                                                                  3);
+  for (Eigen::Index i = 0; i < points.size(); ++i)
+    points.data()[i] = dist(engine);
+
+  std::cout << "Cells: " << mesh->topology().index_map(3)->size_local()
+            << std::endl;
+  std::cout << "Points: " << num_points << std::endl;
+  std::cout << std::left << std::setw(10) << "Builder" << std::setw(14)
+            << "Build (s)" << std::setw(14) << "Query (s)" << std::setw(14)
+            << "Select (s)" << std::setw(14) << "Candidates" << std::endl;
+
+  const std::vector<std::pair<std::string, geometry::TreeBuilder>> builders
+      = {{"median", geometry::TreeBuilder::median},
+         {"lbvh", geometry::TreeBuilder::lbvh}};
+  for (const auto& [name, builder] : builders)
+  {
+    auto t0 = std::chrono::steady_clock::now();
+    geometry::BoundingBoxTree tree(*mesh, 3, builder);
+    auto t1 = std::chrono::steady_clock::now();
+    const double t_build = std::chrono::duration<double>(t1 - t0).count();
+
+    t0 = std::chrono::steady_clock::now();
+    const graph::AdjacencyList<std::int32_t> candidates
+        = geometry::compute_collisions(tree, points);
+    t1 = std::chrono::steady_clock::now();
+    const double t_query = std::chrono::duration<double>(t1 - t0).count();
+
+    t0 = std::chrono::steady_clock::now();
+    const graph::AdjacencyList<std::int32_t> cells
+        = geometry::select_colliding_cells(*mesh, candidates, points, 1);
+    t1 = std::chrono::steady_clock::now();
+    const double t_select = std::chrono::duration<double>(t1 - t0).count();
+
+    std::cout << std::left << std::setw(10) << name << std::setw(14)
+              << t_build << std::setw(14) << t_query << std::setw(14)
+              << t_select << std::setw(14) << candidates.array().rows()
+              << std::endl;
+  }
+
+  return 0;
+}
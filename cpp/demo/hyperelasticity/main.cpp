@@ -21,7 +21,7 @@ public:
       std::vector<std::shared_ptr<const fem::DirichletBC<PetscScalar>>> bcs)
       : _u(u), _l(L), _j(J), _bcs(bcs),
         _b(L->function_space(0)->dofmap()->index_map),
-        _matA(fem::create_matrix(*J))
+        _matA(fem::create_matrix(*J, true))
   {
     auto map = L->function_space(0)->dofmap()->index_map;
     const int bs = map->block_size();
@@ -46,21 +46,35 @@ public:
       VecDestroy(&_b_petsc);
   }
 
+  /// Update the ghost values of x and assemble the residual and the
+  /// Jacobian together in a single pass over the cells
   void form(Vec x) final
   {
     la::PETScVector _x(x, true);
     _x.update_ghosts();
-  }
 
-  /// Compute F at current point x
-  Vec F(const Vec x) final
-  {
-    // Assemble b and update ghosts
+    // Insert element matrices block-wise into the BAIJ matrix
+    const fem::DofMap& dofmap = *_j->function_space(0)->dofmap();
+    const int bs = dofmap.bs();
+    const int num_nodes = dofmap.element_dof_layout->num_dofs() / bs;
+    const auto mat_add = la::PETScMatrix::add_block_fn(
+        _matA.mat(), {bs, bs}, {num_nodes, num_nodes});
+
     _b.array().setZero();
-    fem::assemble_vector<PetscScalar>(_b.array(), *_l);
+    MatZeroEntries(_matA.mat());
+    fem::assemble_fused<PetscScalar>({mat_add}, {_j.get()}, {_b.array()},
+                                     {_l.get()}, _bcs);
     VecGhostUpdateBegin(_b_petsc, ADD_VALUES, SCATTER_REVERSE);
+    fem::add_diagonal(la::PETScMatrix::add_fn(_matA.mat()),
+                      *_j->function_space(0), _bcs);
+    _matA.apply(la::PETScMatrix::AssemblyType::FINAL);
     VecGhostUpdateEnd(_b_petsc, ADD_VALUES, SCATTER_REVERSE);
+  }
 
+  /// Compute F at current point x. The residual has been assembled in
+  /// form(), and only the boundary conditions are applied here.
+  Vec F(const Vec x) final
+  {
     // Set bcs
     Vec x_local;
     VecGhostGetLocalForm(x, &x_local);
@@ -76,16 +90,9 @@ public:
     return _b_petsc;
   }
 
-  /// Compute J = F' at current point x
-  Mat J(const Vec) final
-  {
-    MatZeroEntries(_matA.mat());
-    fem::assemble_matrix(la::PETScMatrix::add_fn(_matA.mat()), *_j, _bcs);
-    fem::add_diagonal(la::PETScMatrix::add_fn(_matA.mat()),
-                      *_j->function_space(0), _bcs);
-    _matA.apply(la::PETScMatrix::AssemblyType::FINAL);
-    return _matA.mat();
-  }
+  /// Compute J = F' at current point x. The Jacobian has been assembled
+  /// in form().
+  Mat J(const Vec) final { return _matA.mat(); }
 
 private:
   std::shared_ptr<function::Function<PetscScalar>> _u;
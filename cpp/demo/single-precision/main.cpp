@@ -0,0 +1,105 @@
+// Single precision assembly (C++)
+// ===============================
+//
+// This demo assembles a functional, a load vector and a mass matrix
+// with forms that are generated for the scalar type ``float``, and
+// writes a single precision Function to XDMF. The assembled values are
+// checked against their exact values, so that the program fails if the
+// single precision forms are not usable.
+//
+// The forms in ``projection.ufl`` are compiled with the FFCX option
+// ``scalar_type="float"``, and must be created with
+// ``fem::create_form<float>``.
+
+#include "projection.h"
+#include <cmath>
+#include <dolfinx.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/io/XDMFFile.h>
+#include <dolfinx/la/Vector.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace dolfinx;
+
+namespace
+{
+// Throw if the single precision value is not close to the exact value
+void check(const std::string& name, float value, double exact)
+{
+  if (std::abs(value - exact) > 1.0e-5)
+  {
+    throw std::runtime_error(name + " is " + std::to_string(value)
+                             + ", expected " + std::to_string(exact));
+  }
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  // Create mesh and function space
+  auto cmap = fem::create_coordinate_map(create_coordinate_map_projection);
+  std::array pt{Eigen::Vector3d(0.0, 0.0, 0.0), Eigen::Vector3d(1.0, 1.0, 0.0)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::RectangleMesh::create(
+      MPI_COMM_WORLD, pt, {{32, 32}}, cmap, mesh::GhostMode::none));
+
+  auto V = fem::create_functionspace(create_functionspace_form_projection_a,
+                                     "u", mesh);
+
+  // Interpolate f = 1 + x0 into a single precision Function
+  auto f = std::make_shared<function::Function<float>>(V);
+  f->interpolate(
+      [](auto& x) { return 1.0f + x.row(0).template cast<float>(); });
+
+  // Create single precision forms
+  auto a = fem::create_form<float>(create_form_projection_a, {V, V});
+  auto L = fem::create_form<float>(create_form_projection_L, {V});
+  auto M = fem::create_form<float>(create_form_projection_M, {});
+  L->set_coefficients({{"f", f}});
+  M->set_coefficients({{"f", f}});
+  M->set_mesh(mesh);
+
+  // Assemble the functional: the integral of f is 3/2
+  float m = fem::assemble_scalar(*M);
+  MPI_Allreduce(MPI_IN_PLACE, &m, 1, dolfinx::MPI::mpi_type<float>(),
+                MPI_SUM, mesh->mpi_comm());
+  check("Functional", m, 1.5);
+
+  // Assemble the load vector. The sum of its owned entries is the
+  // integral of f.
+  la::Vector<float> b(V->dofmap()->index_map);
+  b.set(0.0);
+  fem::assemble_vector(b, *L);
+  const std::int32_t size_owned = V->dofmap()->index_map->size_local();
+  float b_sum = b.array().head(size_owned).sum();
+  MPI_Allreduce(MPI_IN_PLACE, &b_sum, 1, dolfinx::MPI::mpi_type<float>(),
+                MPI_SUM, mesh->mpi_comm());
+  check("Sum of vector entries", b_sum, 1.5);
+
+  // Assemble the mass matrix. The sum of its entries is the area of the
+  // domain.
+  Eigen::SparseMatrix<float, Eigen::RowMajor> A
+      = fem::assemble_matrix_eigen<float>(*a, {});
+  float A_sum = A.sum();
+  MPI_Allreduce(MPI_IN_PLACE, &A_sum, 1, dolfinx::MPI::mpi_type<float>(),
+                MPI_SUM, mesh->mpi_comm());
+  check("Sum of matrix entries", A_sum, 1.0);
+
+  // Write the single precision Function to file
+  io::XDMFFile file(mesh->mpi_comm(), "f.xdmf", "w");
+  file.write_mesh(*mesh);
+  file.write_function(*f, 0.0);
+
+  if (dolfinx::MPI::rank(mesh->mpi_comm()) == 0)
+  {
+    std::cout << "Functional: " << m << std::endl;
+    std::cout << "Sum of vector entries: " << b_sum << std::endl;
+    std::cout << "Sum of matrix entries: " << A_sum << std::endl;
+  }
+
+  return 0;
+}
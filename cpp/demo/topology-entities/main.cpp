@@ -0,0 +1,74 @@
+// Topology entities benchmark (C++)
+// =================================
+//
+// This program measures the creation of the edges
+// (``Topology::create_entities(1)``) and facets
+// (``Topology::create_entities(2)``) of a distributed tetrahedral mesh
+// of the unit cube. The entity creation includes the parallel
+// computation of the entity ownership and of the entity index maps. It
+// reports the number of created entities and the maximum time over all
+// processes.
+//
+// Usage: ``demo_topology-entities [num_cells]``, where ``num_cells`` is
+// the approximate global number of cells. The mesh has :math:`6 n^3`
+// cells, with :math:`n` the number of cubes in each direction. The
+// default (10000 cells) is a quick check, e.g. for testing. For
+// benchmarking, pass a large mesh and run in parallel, e.g.
+// ``mpirun -n 64 demo_topology-entities 1e8``.
+
+#include "mesh.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <dolfinx.h>
+#include <iomanip>
+#include <iostream>
+
+using namespace dolfinx;
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  const double num_cells = argc > 1 ? std::atof(argv[1]) : 1.0e4;
+  const std::size_t n = std::max(1.0, std::round(std::cbrt(num_cells / 6)));
+
+  // Create mesh
+  auto cmap = fem::create_coordinate_map(create_coordinate_map_mesh);
+  std::array pt{Eigen::Vector3d(0.0, 0.0, 0.0), Eigen::Vector3d(1.0, 1.0, 1.0)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::BoxMesh::create(
+      MPI_COMM_WORLD, pt, {{n, n, n}}, cmap, mesh::GhostMode::none));
+
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  if (rank == 0)
+  {
+    std::cout << "Processes: " << dolfinx::MPI::size(MPI_COMM_WORLD)
+              << std::endl;
+    std::cout << "Cells (global): "
+              << mesh->topology().index_map(3)->size_global() << std::endl;
+    std::cout << std::left << std::setw(12) << "Dimension" << std::setw(20)
+              << "Entities (global)" << std::setw(14) << "Time (s)"
+              << std::endl;
+  }
+
+  for (int dim : {1, 2})
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    const auto t0 = std::chrono::steady_clock::now();
+    mesh->topology_mutable().create_entities(dim);
+    const auto t1 = std::chrono::steady_clock::now();
+    double t = std::chrono::duration<double>(t1 - t0).count();
+    MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    const std::int64_t num_entities
+        = mesh->topology().index_map(dim)->size_global();
+    if (rank == 0)
+    {
+      std::cout << std::left << std::setw(12) << dim << std::setw(20)
+                << num_entities << std::setw(14) << t << std::endl;
+    }
+  }
+
+  return 0;
+}
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "IndexMap.h"
+#include "ScatterPlan.h"
 #include <algorithm>
 #include <numeric>
 #include <unordered_map>
@@ -216,7 +217,6 @@ compute_asymmetric_communicators(MPI_Comm comm,
 
   return comms;
 }
-//-----------------------------------------------------------------------------
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -806,6 +806,86 @@ void IndexMap::scatter_rev(std::vector<std::int32_t>& local_data,
   scatter_rev_impl(local_data, remote_data, n, op);
 }
 //-----------------------------------------------------------------------------
+void IndexMap::scatter_fwd(
+    Eigen::Ref<Eigen::Matrix<double, Eigen::Dynamic, 1>> data, int n) const
+{
+  scatter_fwd_inplace(data, n);
+}
+//-----------------------------------------------------------------------------
+void IndexMap::scatter_fwd(
+    Eigen::Ref<Eigen::Matrix<float, Eigen::Dynamic, 1>> data, int n) const
+{
+  scatter_fwd_inplace(data, n);
+}
+//-----------------------------------------------------------------------------
+void IndexMap::scatter_fwd(
+    Eigen::Ref<Eigen::Matrix<std::complex<double>, Eigen::Dynamic, 1>> data,
+    int n) const
+{
+  scatter_fwd_inplace(data, n);
+}
+//-----------------------------------------------------------------------------
+void IndexMap::scatter_rev(
+    Eigen::Ref<Eigen::Matrix<double, Eigen::Dynamic, 1>> data, int n,
+    IndexMap::Mode op) const
+{
+  scatter_rev_inplace(data, n, op);
+}
+//-----------------------------------------------------------------------------
+void IndexMap::scatter_rev(
+    Eigen::Ref<Eigen::Matrix<float, Eigen::Dynamic, 1>> data, int n,
+    IndexMap::Mode op) const
+{
+  scatter_rev_inplace(data, n, op);
+}
+//-----------------------------------------------------------------------------
+void IndexMap::scatter_rev(
+    Eigen::Ref<Eigen::Matrix<std::complex<double>, Eigen::Dynamic, 1>> data,
+    int n, IndexMap::Mode op) const
+{
+  scatter_rev_inplace(data, n, op);
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+ScatterPlan<T>& IndexMap::scatter_plan(int n) const
+{
+  auto& plans = std::get<std::map<int, std::shared_ptr<ScatterPlan<T>>>>(
+      _scatter_plans);
+  std::shared_ptr<ScatterPlan<T>>& plan = plans[n];
+  if (!plan)
+    plan = std::make_shared<ScatterPlan<T>>(*this, n);
+  return *plan;
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+void IndexMap::scatter_fwd_inplace(
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> data, int n) const
+{
+  const std::int32_t size_owned = n * size_local();
+  const std::int32_t size_ghost = n * num_ghosts();
+  if (data.rows() != size_owned + size_ghost)
+    throw std::runtime_error("Data size does not match the index map.");
+
+  ScatterPlan<T>& plan = scatter_plan<T>(n);
+  plan.scatter_fwd_begin(data.head(size_owned));
+  plan.scatter_fwd_end(data.tail(size_ghost));
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+void IndexMap::scatter_rev_inplace(
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> data, int n,
+    IndexMap::Mode op) const
+{
+  const std::int32_t size_owned = n * size_local();
+  const std::int32_t size_ghost = n * num_ghosts();
+  if (data.rows() != size_owned + size_ghost)
+    throw std::runtime_error("Data size does not match the index map.");
+
+  ScatterPlan<T>& plan = scatter_plan<T>(n);
+  plan.scatter_rev_begin(data.tail(size_ghost));
+  plan.scatter_rev_end(data.head(size_owned), op);
+}
+//-----------------------------------------------------------------------------
 template <typename T>
 void IndexMap::scatter_fwd_impl(const std::vector<T>& local_data,
                                 std::vector<T>& remote_data, int n) const
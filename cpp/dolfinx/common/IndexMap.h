@@ -8,16 +8,20 @@
 
 #include <Eigen/Dense>
 #include <array>
+#include <complex>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <map>
+#include <memory>
 #include <tuple>
 #include <vector>
 
 namespace dolfinx::common
 {
-// Forward declaration
+// Forward declarations
 class IndexMap;
+template <typename T>
+class ScatterPlan;
 
 /// Compute layout data and ghost indices for a stacked (concatenated)
 /// index map, i.e. 'splice' multiple maps into one. Communication is
@@ -40,6 +44,11 @@ stack_index_maps(
 /// processes. On a given process, the IndexMap stores a portion of the
 /// index set using local indices [0, 1, . . . , n], and a map from the
 /// local block indices  to a unique global block index.
+///
+/// The in-place scatters of Eigen arrays use a ScatterPlan that is
+/// created on first use for each scalar type and number of items per
+/// index and then cached on the map. They are therefore not
+/// thread-safe.
 
 class IndexMap
 {
@@ -291,6 +300,71 @@ public:
                    const std::vector<std::int32_t>& remote_data, int n,
                    IndexMap::Mode op) const;
 
+  /// Send n values for each owned index to the processes that have
+  /// the index as a ghost, updating the ghost values in place
+  ///
+  /// @param[in,out] data Owned values followed by ghost values. Size
+  ///   must be n * (size_local() + num_ghosts()). The ghost values are
+  ///   set to the values received from the owning processes.
+  /// @param[in] n Number of data items per index
+  void scatter_fwd(Eigen::Ref<Eigen::Matrix<double, Eigen::Dynamic, 1>> data,
+                   int n) const;
+
+  /// Send n values for each owned index to the processes that have
+  /// the index as a ghost, updating the ghost values in place
+  ///
+  /// @param[in,out] data Owned values followed by ghost values. Size
+  ///   must be n * (size_local() + num_ghosts()). The ghost values are
+  ///   set to the values received from the owning processes.
+  /// @param[in] n Number of data items per index
+  void scatter_fwd(Eigen::Ref<Eigen::Matrix<float, Eigen::Dynamic, 1>> data,
+                   int n) const;
+
+  /// Send n values for each owned index to the processes that have
+  /// the index as a ghost, updating the ghost values in place
+  ///
+  /// @param[in,out] data Owned values followed by ghost values. Size
+  ///   must be n * (size_local() + num_ghosts()). The ghost values are
+  ///   set to the values received from the owning processes.
+  /// @param[in] n Number of data items per index
+  void scatter_fwd(
+      Eigen::Ref<Eigen::Matrix<std::complex<double>, Eigen::Dynamic, 1>> data,
+      int n) const;
+
+  /// Send n values for each ghost index to the owning process,
+  /// updating the owned values in place
+  ///
+  /// @param[in,out] data Owned values followed by ghost values. Size
+  ///   must be n * (size_local() + num_ghosts()). The received values
+  ///   are summed into or set on the owned values.
+  /// @param[in] n Number of data items per index
+  /// @param[in] op Sum or set received values in the owned values
+  void scatter_rev(Eigen::Ref<Eigen::Matrix<double, Eigen::Dynamic, 1>> data,
+                   int n, IndexMap::Mode op) const;
+
+  /// Send n values for each ghost index to the owning process,
+  /// updating the owned values in place
+  ///
+  /// @param[in,out] data Owned values followed by ghost values. Size
+  ///   must be n * (size_local() + num_ghosts()). The received values
+  ///   are summed into or set on the owned values.
+  /// @param[in] n Number of data items per index
+  /// @param[in] op Sum or set received values in the owned values
+  void scatter_rev(Eigen::Ref<Eigen::Matrix<float, Eigen::Dynamic, 1>> data,
+                   int n, IndexMap::Mode op) const;
+
+  /// Send n values for each ghost index to the owning process,
+  /// updating the owned values in place
+  ///
+  /// @param[in,out] data Owned values followed by ghost values. Size
+  ///   must be n * (size_local() + num_ghosts()). The received values
+  ///   are summed into or set on the owned values.
+  /// @param[in] n Number of data items per index
+  /// @param[in] op Sum or set received values in the owned values
+  void scatter_rev(
+      Eigen::Ref<Eigen::Matrix<std::complex<double>, Eigen::Dynamic, 1>> data,
+      int n, IndexMap::Mode op) const;
+
 private:
   int _block_size;
 
@@ -344,6 +418,29 @@ private:
   // rank i, where i is the ith outgoing edge on _comm_owner_to_ghost.
   std::vector<std::int32_t> _shared_disp;
 
+  // Scatter plans for the in-place scatters, for each scalar type and
+  // keyed by the number of data items per index (created on demand)
+  mutable std::tuple<
+      std::map<int, std::shared_ptr<ScatterPlan<double>>>,
+      std::map<int, std::shared_ptr<ScatterPlan<float>>>,
+      std::map<int, std::shared_ptr<ScatterPlan<std::complex<double>>>>>
+      _scatter_plans;
+
+  template <typename T>
+  friend class ScatterPlan;
+
+  // Get (create if required) the cached scatter plan for n data items
+  // per index
+  template <typename T>
+  ScatterPlan<T>& scatter_plan(int n) const;
+
+  template <typename T>
+  void scatter_fwd_inplace(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> data,
+                           int n) const;
+  template <typename T>
+  void scatter_rev_inplace(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> data,
+                           int n, IndexMap::Mode op) const;
+
   template <typename T>
   void scatter_fwd_impl(const std::vector<T>& local_data,
                         std::vector<T>& remote_data, int n) const;
@@ -9,6 +9,27 @@
 #include <algorithm>
 #include <numeric>
 
+namespace
+{
+// Communicator and exchange count cached on a communicator for
+// MPI::sparse_all_to_all
+struct SparseExchangeComm
+{
+  MPI_Comm comm;
+  std::uint64_t count;
+};
+
+// Free the cached communicator when the communicator it is attached
+// to is freed
+int delete_sparse_exchange_comm(MPI_Comm, int, void* attr, void*)
+{
+  auto c = static_cast<SparseExchangeComm*>(attr);
+  MPI_Comm_free(&c->comm);
+  delete c;
+  return MPI_SUCCESS;
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 dolfinx::MPI::Comm::Comm(MPI_Comm comm, bool duplicate)
 {
@@ -136,25 +157,47 @@ int dolfinx::MPI::index_owner(int size, std::size_t index, std::size_t N)
   return r + (index - r * (n + 1)) / n;
 }
 //-----------------------------------------------------------------------------
-std::vector<int> dolfinx::MPI::compute_graph_edges(MPI_Comm comm,
-                                                   const std::set<int>& edges)
+std::pair<MPI_Comm, int> dolfinx::MPI::sparse_exchange_comm(MPI_Comm comm)
 {
-  // Send '1' to ranks that I have a edge to
-  std::vector<std::uint8_t> edge_count(dolfinx::MPI::size(comm), 0);
-  for (auto e : edges)
-    edge_count[e] = 1;
-  std::vector<std::uint8_t> in_edge_count(dolfinx::MPI::size(comm), -1);
-  MPI_Alltoall(edge_count.data(), 1, MPI_UINT8_T, in_edge_count.data(), 1,
-               MPI_UINT8_T, comm);
+  static int keyval = MPI_KEYVAL_INVALID;
+  if (keyval == MPI_KEYVAL_INVALID)
+  {
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, delete_sparse_exchange_comm,
+                           &keyval, nullptr);
+  }
 
-  // Build list of rank that had an edge to me
-  std::vector<int> edges1;
-  for (std::size_t i = 0; i < in_edge_count.size(); ++i)
+  void* attr = nullptr;
+  int flag = 0;
+  MPI_Comm_get_attr(comm, keyval, &attr, &flag);
+  if (!flag)
   {
-    if (in_edge_count[i] > 0)
-      edges1.push_back(i);
+    auto c = new SparseExchangeComm{MPI_COMM_NULL, 0};
+    if (MPI_Comm_dup(comm, &c->comm) != MPI_SUCCESS)
+    {
+      delete c;
+      throw std::runtime_error(
+          "Duplication of MPI communicator failed (MPI_Comm_dup)");
+    }
+    MPI_Comm_set_attr(comm, keyval, c);
+    attr = c;
   }
-  return edges1;
+
+  auto c = static_cast<SparseExchangeComm*>(attr);
+  const int tag = c->count % 2;
+  ++c->count;
+  return {c->comm, tag};
+}
+//-----------------------------------------------------------------------------
+std::vector<int> dolfinx::MPI::compute_graph_edges(MPI_Comm comm,
+                                                   const std::set<int>& edges)
+{
+  // Send an empty message to the ranks that I have an edge to. The
+  // ranks that had an edge to me are the sources of the messages I
+  // receive.
+  const std::vector<int> dest(edges.begin(), edges.end());
+  const graph::AdjacencyList<int> data(
+      std::vector<int>(), std::vector<std::int32_t>(dest.size() + 1, 0));
+  return dolfinx::MPI::sparse_all_to_all(comm, dest, data).first;
 }
 //-----------------------------------------------------------------------------
 std::tuple<std::vector<int>, std::vector<int>>
@@ -74,13 +74,45 @@ public:
   static graph::AdjacencyList<T>
   all_to_all(MPI_Comm comm, const graph::AdjacencyList<T>& send_data);
 
+  /// Send data to a set of destination ranks and receive the data sent
+  /// to this rank, using the non-blocking consensus (NBX) algorithm of
+  /// Hoefler et al. Ranks only communicate with the ranks they exchange
+  /// data with, plus a non-blocking barrier, so the cost does not grow
+  /// with the size of the communicator.
+  /// @note Collective over @p comm
+  /// @param[in] comm The MPI communicator
+  /// @param[in] dest The destination ranks, which must be unique
+  /// @param[in] send_data The data to send to each destination rank,
+  ///   i.e. send_data.links(i) is sent to rank dest[i]
+  /// @return The ranks that sent data to this rank (sorted) and the
+  ///   data received from each of these ranks
+  template <typename T>
+  static std::pair<std::vector<int>, graph::AdjacencyList<T>>
+  sparse_all_to_all(MPI_Comm comm, const std::vector<int>& dest,
+                    const graph::AdjacencyList<T>& send_data);
+
+  /// Get the communicator and tag for the messages of the next
+  /// MPI::sparse_all_to_all exchange on a communicator. The
+  /// communicator is a duplicate of @p comm, so that the messages
+  /// cannot match other messages on @p comm. It is created on the first
+  /// call and cached as an attribute of @p comm, and freed when @p comm
+  /// is freed. The tag alternates between consecutive exchanges, so
+  /// that messages sent by a rank that has already completed an
+  /// exchange cannot be received in the same exchange on a slower rank.
+  /// @note Collective over @p comm on the first call
+  /// @param[in] comm The MPI communicator
+  /// @return The communicator and the tag for the exchange
+  static std::pair<MPI_Comm, int> sparse_exchange_comm(MPI_Comm comm);
+
   /// @todo Experimental. Maybe be moved or removed.
   ///
   /// Compute communication graph edges. The caller provides edges that
   /// it can define, and will receive edges to it that are defined by
   /// other ranks.
   ///
-  /// @note This function involves global communication
+  /// @note This function is collective, but uses only communication
+  /// along the edges and a non-blocking barrier (see
+  /// MPI::sparse_all_to_all)
   ///
   /// @param[in] comm The MPI communicator
   /// @param[in] edges Communication edges between the caller and the
@@ -237,6 +269,86 @@ dolfinx::MPI::all_to_all(MPI_Comm comm,
 }
 //-----------------------------------------------------------------------------
 template <typename T>
+std::pair<std::vector<int>, graph::AdjacencyList<T>>
+dolfinx::MPI::sparse_all_to_all(MPI_Comm comm, const std::vector<int>& dest,
+                                const graph::AdjacencyList<T>& send_data)
+{
+  assert((int)dest.size() == send_data.num_nodes());
+
+  // Use the cached duplicate communicator and a tag that separates the
+  // messages from those of other exchanges
+  const auto [_comm, tag] = sparse_exchange_comm(comm);
+
+  // Start synchronous sends to the destination ranks
+  std::vector<MPI_Request> send_requests(dest.size());
+  for (std::size_t i = 0; i < dest.size(); ++i)
+  {
+    auto data = send_data.links(i);
+    MPI_Issend(data.data(), data.rows(), mpi_type<T>(), dest[i], tag,
+               _comm, &send_requests[i]);
+  }
+
+  // Receive messages until all ranks have completed their sends. A
+  // rank enters the barrier once its sends have been received, so the
+  // barrier completes once all messages have been received.
+  std::vector<std::pair<int, std::vector<T>>> recv;
+  MPI_Request barrier_request = MPI_REQUEST_NULL;
+  bool barrier_active = false;
+  int done = 0;
+  while (!done)
+  {
+    int flag = 0;
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, tag, _comm, &flag, &status);
+    if (flag)
+    {
+      int count = 0;
+      MPI_Get_count(&status, mpi_type<T>(), &count);
+      std::vector<T>& data
+          = recv.emplace_back(status.MPI_SOURCE, std::vector<T>(count)).second;
+      MPI_Recv(data.data(), count, mpi_type<T>(), status.MPI_SOURCE, tag,
+               _comm, MPI_STATUS_IGNORE);
+    }
+
+    if (barrier_active)
+      MPI_Test(&barrier_request, &done, MPI_STATUS_IGNORE);
+    else
+    {
+      int sent = 0;
+      MPI_Testall(send_requests.size(), send_requests.data(), &sent,
+                  MPI_STATUSES_IGNORE);
+      if (sent)
+      {
+        MPI_Ibarrier(_comm, &barrier_request);
+        barrier_active = true;
+      }
+    }
+  }
+
+  // Order received data by source rank
+  std::sort(recv.begin(), recv.end(), [](auto& a, auto& b) {
+    return a.first < b.first;
+  });
+  std::vector<int> src(recv.size());
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> offsets(recv.size() + 1);
+  offsets[0] = 0;
+  for (std::size_t i = 0; i < recv.size(); ++i)
+  {
+    src[i] = recv[i].first;
+    offsets[i + 1] = offsets[i] + recv[i].second.size();
+  }
+  Eigen::Array<T, Eigen::Dynamic, 1> data(offsets[recv.size()]);
+  for (std::size_t i = 0; i < recv.size(); ++i)
+  {
+    std::copy(recv[i].second.begin(), recv[i].second.end(),
+              data.data() + offsets[i]);
+  }
+
+  return {std::move(src),
+          graph::AdjacencyList<T>(std::move(data), std::move(offsets))};
+}
+//-----------------------------------------------------------------------------
+template <typename T>
 graph::AdjacencyList<T>
 dolfinx::MPI::neighbor_all_to_all(MPI_Comm neighbor_comm,
                                   const std::vector<int>& send_offsets,
@@ -0,0 +1,219 @@
+// Copyright (C) 2026 The DOLFINX authors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "IndexMap.h"
+#include <Eigen/Dense>
+#include <cassert>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::common
+{
+
+/// Persistent plan for scattering data between the owned and the ghost
+/// entries of an IndexMap, with n data items per index.
+///
+/// The plan caches the neighbour communication sizes and displacements,
+/// the packing positions of the shared and ghost entries, and the
+/// communication buffers, so that repeated scatters do not query the
+/// neighbourhood communicators or allocate memory. Scatters are split
+/// into begin and end phases that use non-blocking neighbourhood
+/// communication (MPI_Ineighbor_alltoallv), so that computation can be
+/// overlapped with communication. Only one scatter can be in progress
+/// at a time for a plan.
+///
+/// The IndexMap must outlive the plan.
+
+template <typename T>
+class ScatterPlan
+{
+public:
+  /// Create a scatter plan
+  /// @param[in] map The index map
+  /// @param[in] n Number of data items per index
+  ScatterPlan(const IndexMap& map, int n)
+      : _comm_fwd(map._comm_owner_to_ghost.comm()),
+        _comm_rev(map._comm_ghost_to_owner.comm()), _n(n)
+  {
+    // Get number of neighbours on forward communicator
+    int indegree(-1), outdegree(-2), weighted(-1);
+    MPI_Dist_graph_neighbors_count(_comm_fwd, &indegree, &outdegree,
+                                   &weighted);
+
+    // Sizes and displacements of shared data, i.e. data sent to ranks
+    // that ghost owned indices (forward) or received from them
+    // (reverse)
+    assert((int)map._shared_disp.size() == outdegree + 1);
+    _sizes_shared.resize(outdegree);
+    _displs_shared.resize(outdegree + 1);
+    for (int i = 0; i < outdegree; ++i)
+      _sizes_shared[i] = (map._shared_disp[i + 1] - map._shared_disp[i]) * n;
+    std::partial_sum(_sizes_shared.begin(), _sizes_shared.end(),
+                     _displs_shared.begin() + 1);
+
+    // Sizes and displacements of ghost data, i.e. data received from
+    // owners (forward) or sent to them (reverse)
+    const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& owners
+        = map._ghost_owners;
+    _sizes_ghost.resize(indegree, 0);
+    _displs_ghost.resize(indegree + 1, 0);
+    for (Eigen::Index i = 0; i < owners.rows(); ++i)
+      _sizes_ghost[owners[i]] += n;
+    std::partial_sum(_sizes_ghost.begin(), _sizes_ghost.end(),
+                     _displs_ghost.begin() + 1);
+
+    // Position in the local data of each shared data item
+    const std::vector<std::int32_t>& shared = map._shared_indices;
+    _pos_shared.resize(shared.size() * n);
+    for (std::size_t i = 0; i < shared.size(); ++i)
+      for (int j = 0; j < n; ++j)
+        _pos_shared[i * n + j] = shared[i] * n + j;
+
+    // Position in the ghost buffer of each ghost data item
+    std::vector<std::int32_t> displs(_displs_ghost.begin(),
+                                     _displs_ghost.end() - 1);
+    _pos_ghost.resize(owners.rows() * n);
+    for (Eigen::Index i = 0; i < owners.rows(); ++i)
+    {
+      for (int j = 0; j < n; ++j)
+        _pos_ghost[i * n + j] = displs[owners[i]] + j;
+      displs[owners[i]] += n;
+    }
+
+    _buffer_shared.resize(_displs_shared.back());
+    _buffer_ghost.resize(_displs_ghost.back());
+  }
+
+  /// Copy constructor
+  ScatterPlan(const ScatterPlan& plan) = delete;
+
+  /// Move constructor
+  ScatterPlan(ScatterPlan&& plan)
+      : _comm_fwd(plan._comm_fwd), _comm_rev(plan._comm_rev), _n(plan._n),
+        _sizes_shared(std::move(plan._sizes_shared)),
+        _displs_shared(std::move(plan._displs_shared)),
+        _sizes_ghost(std::move(plan._sizes_ghost)),
+        _displs_ghost(std::move(plan._displs_ghost)),
+        _pos_shared(std::move(plan._pos_shared)),
+        _pos_ghost(std::move(plan._pos_ghost)),
+        _buffer_shared(std::move(plan._buffer_shared)),
+        _buffer_ghost(std::move(plan._buffer_ghost)),
+        _request(std::exchange(plan._request, MPI_REQUEST_NULL))
+  {
+    // Do nothing
+  }
+
+  /// Destructor. Waits for a scatter in progress to complete.
+  ~ScatterPlan()
+  {
+    if (_request != MPI_REQUEST_NULL)
+      MPI_Wait(&_request, MPI_STATUS_IGNORE);
+  }
+
+  /// Assignment
+  ScatterPlan& operator=(const ScatterPlan& plan) = delete;
+
+  /// Number of data items per index
+  int block_size() const { return _n; }
+
+  /// Start sending the data of owned indices to the ranks that ghost
+  /// them. @p local_data can be modified once the call returns.
+  /// @param[in] local_data Data for the owned indices. Size must be at
+  ///   least n * size_local().
+  void scatter_fwd_begin(
+      const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, 1>>&
+          local_data)
+  {
+    if (_request != MPI_REQUEST_NULL)
+      throw std::runtime_error("Scatter already in progress.");
+    for (std::size_t i = 0; i < _pos_shared.size(); ++i)
+      _buffer_shared[i] = local_data[_pos_shared[i]];
+    MPI_Ineighbor_alltoallv(
+        _buffer_shared.data(), _sizes_shared.data(), _displs_shared.data(),
+        MPI::mpi_type<T>(), _buffer_ghost.data(), _sizes_ghost.data(),
+        _displs_ghost.data(), MPI::mpi_type<T>(), _comm_fwd, &_request);
+  }
+
+  /// Complete a forward scatter started with scatter_fwd_begin
+  /// @param[in,out] remote_data Data for the ghost indices, received
+  ///   from the owners. Size must be at least n * num_ghosts().
+  void scatter_fwd_end(
+      Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> remote_data)
+  {
+    MPI_Wait(&_request, MPI_STATUS_IGNORE);
+    for (std::size_t i = 0; i < _pos_ghost.size(); ++i)
+      remote_data[i] = _buffer_ghost[_pos_ghost[i]];
+  }
+
+  /// Start sending the data of ghost indices to the owning ranks. @p
+  /// remote_data can be modified once the call returns.
+  /// @param[in] remote_data Data for the ghost indices. Size must be
+  ///   at least n * num_ghosts().
+  void scatter_rev_begin(
+      const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, 1>>&
+          remote_data)
+  {
+    if (_request != MPI_REQUEST_NULL)
+      throw std::runtime_error("Scatter already in progress.");
+    for (std::size_t i = 0; i < _pos_ghost.size(); ++i)
+      _buffer_ghost[_pos_ghost[i]] = remote_data[i];
+    MPI_Ineighbor_alltoallv(
+        _buffer_ghost.data(), _sizes_ghost.data(), _displs_ghost.data(),
+        MPI::mpi_type<T>(), _buffer_shared.data(), _sizes_shared.data(),
+        _displs_shared.data(), MPI::mpi_type<T>(), _comm_rev, &_request);
+  }
+
+  /// Complete a reverse scatter started with scatter_rev_begin
+  /// @param[in,out] local_data Data for the owned indices. Size must be
+  ///   at least n * size_local().
+  /// @param[in] op Sum or set received values in @p local_data
+  void
+  scatter_rev_end(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> local_data,
+                  IndexMap::Mode op)
+  {
+    MPI_Wait(&_request, MPI_STATUS_IGNORE);
+    if (op == IndexMap::Mode::insert)
+    {
+      for (std::size_t i = 0; i < _pos_shared.size(); ++i)
+        local_data[_pos_shared[i]] = _buffer_shared[i];
+    }
+    else if (op == IndexMap::Mode::add)
+    {
+      for (std::size_t i = 0; i < _pos_shared.size(); ++i)
+        local_data[_pos_shared[i]] += _buffer_shared[i];
+    }
+  }
+
+private:
+  // Neighbourhood communicators (owned by the IndexMap)
+  MPI_Comm _comm_fwd, _comm_rev;
+
+  // Number of data items per index
+  int _n;
+
+  // Sizes and displacements per neighbour of the data for shared
+  // (owned) indices and for ghost indices
+  std::vector<int> _sizes_shared, _displs_shared;
+  std::vector<int> _sizes_ghost, _displs_ghost;
+
+  // Position in the local data of each item in the shared buffer, and
+  // position in the ghost buffer of each item of the ghost data
+  std::vector<std::int32_t> _pos_shared, _pos_ghost;
+
+  // Communication buffers
+  std::vector<T> _buffer_shared, _buffer_ghost;
+
+  // Request for scatter in progress
+  MPI_Request _request = MPI_REQUEST_NULL;
+};
+
+} // namespace dolfinx::common
@@ -0,0 +1,154 @@
+// Copyright (C) 2026 The DOLFINX authors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
+namespace dolfinx::common
+{
+
+/// Spread the lower 21 bits of @p x such that there are two zero bits
+/// between each bit
+/// @param[in] x The bits to spread
+/// @return The spread bits
+inline std::uint64_t spread_bits(std::uint64_t x)
+{
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffff;
+  x = (x | x << 16) & 0x1f0000ff0000ff;
+  x = (x | x << 8) & 0x100f00f00f00f00f;
+  x = (x | x << 4) & 0x10c30c30c30c30c3;
+  x = (x | x << 2) & 0x1249249249249249;
+  return x;
+}
+
+/// Compute the Morton (Z-order) code of a point in the unit cube, by
+/// interleaving the bits of the point coordinates on a 2^21 grid
+/// @param[in] p The point, with coordinates in [0, 1]
+/// @return The 63-bit Morton code
+inline std::uint64_t morton_code(const Eigen::Array3d& p)
+{
+  std::uint64_t code = 0;
+  for (int j = 0; j < 3; ++j)
+    code |= spread_bits(p[j] * 0x1fffff) << j;
+  return code;
+}
+
+/// Perform one pass of a least significant digit radix sort, i.e. a
+/// stable counting sort of (key, value) pairs by the 11-bit digit of
+/// the keys at @p shift. The pairs are scattered to @p keys_out and @p
+/// values_out, unless all keys have the same digit. Large arrays are
+/// split into contiguous chunks that are counted and scattered by
+/// different threads.
+/// @param[in] keys The keys (non-negative)
+/// @param[in] values The values
+/// @param[out] keys_out The keys sorted by digit
+/// @param[out] values_out The values sorted by digit
+/// @param[in] shift The bit position of the digit
+/// @return True if the pairs were scattered, false if the digit is the
+///   same for all keys and the pairs are already sorted by it
+template <typename K, typename V>
+bool radix_pass(const std::vector<K>& keys, const std::vector<V>& values,
+                std::vector<K>& keys_out, std::vector<V>& values_out,
+                int shift)
+{
+  constexpr int radix_bits = 11;
+  constexpr std::int32_t num_buckets = 1 << radix_bits;
+  constexpr K mask = num_buckets - 1;
+  const std::int32_t n = keys.size();
+  assert(values.size() == keys.size());
+  assert(keys_out.size() == keys.size());
+  assert(values_out.size() == keys.size());
+
+  // Threads work on contiguous chunks. Small arrays are sorted serially.
+#ifdef HAS_OPENMP
+  const int num_threads = n > 100000 ? omp_get_max_threads() : 1;
+#else
+  const int num_threads = 1;
+#endif
+
+  // Bucket counts for each thread, converted into scatter offsets
+  std::vector<std::int32_t> offsets(num_threads * num_buckets, 0);
+  bool scatter = true;
+#pragma omp parallel num_threads(num_threads)
+  {
+#ifdef HAS_OPENMP
+    const int t = omp_get_thread_num();
+#else
+    const int t = 0;
+#endif
+    const std::int32_t i0 = (std::int64_t)n * t / num_threads;
+    const std::int32_t i1 = (std::int64_t)n * (t + 1) / num_threads;
+    std::int32_t* count = offsets.data() + t * num_buckets;
+    for (std::int32_t i = i0; i < i1; ++i)
+      ++count[(keys[i] >> shift) & mask];
+
+#pragma omp barrier
+#pragma omp single
+    {
+      // Offsets ordered by bucket, then by thread, so that the sort
+      // is stable
+      std::int32_t offset = 0;
+      for (std::int32_t b = 0; b < num_buckets; ++b)
+      {
+        std::int32_t bucket_count = 0;
+        for (int p = 0; p < num_threads; ++p)
+        {
+          const std::int32_t c = offsets[p * num_buckets + b];
+          offsets[p * num_buckets + b] = offset;
+          offset += c;
+          bucket_count += c;
+        }
+        if (bucket_count == n)
+          scatter = false;
+      }
+    }
+
+    if (scatter)
+    {
+      for (std::int32_t i = i0; i < i1; ++i)
+      {
+        const std::int32_t pos = count[(keys[i] >> shift) & mask]++;
+        keys_out[pos] = keys[i];
+        values_out[pos] = values[i];
+      }
+    }
+  }
+
+  return scatter;
+}
+
+/// Sort (key, value) pairs by the lower @p num_bits bits of the keys,
+/// using a stable least significant digit radix sort. Digits that are
+/// the same for all keys are skipped.
+/// @param[in,out] keys The keys (non-negative)
+/// @param[in,out] values The values
+/// @param[in] num_bits The number of bits of the keys to sort by
+template <typename K, typename V>
+void radix_sort(std::vector<K>& keys, std::vector<V>& values, int num_bits)
+{
+  constexpr int radix_bits = 11;
+  std::vector<K> keys_tmp(keys.size());
+  std::vector<V> values_tmp(values.size());
+  for (int shift = 0; shift < num_bits; shift += radix_bits)
+  {
+    if (radix_pass(keys, values, keys_tmp, values_tmp, shift))
+    {
+      keys.swap(keys_tmp);
+      values.swap(values_tmp);
+    }
+  }
+}
+
+} // namespace dolfinx::common
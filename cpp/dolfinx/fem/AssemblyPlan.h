@@ -0,0 +1,268 @@
+// Copyright (C) 2026 The DOLFINX authors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "Form.h"
+#include "FormIntegrals.h"
+#include <algorithm>
+#include <cstdint>
+#include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace dolfinx::fem
+{
+
+/// Insertion plan for the repeated assembly of a bilinear form into a
+/// matrix with a fixed sparsity pattern
+///
+/// The plan holds a la::MatrixCSR with the layout of the sparsity
+/// pattern, and the positions in the CSR value array of the element
+/// matrix entries of every cell (used for cell and exterior facet
+/// integrals) and of every interior facet in the form's integration
+/// domains. Assembly with a plan adds element matrices directly at
+/// these positions, without translating or searching for indices (see
+/// fem::assemble_matrix). The plan also holds the position of each
+/// owned row entry in the diagonal and off-diagonal blocks of a
+/// distributed AIJ matrix, which is used to add the plan matrix
+/// directly to the value arrays of a PETSc matrix with the same
+/// pattern (see fem::assemble_matrix_petsc).
+///
+/// A plan can be used with a form that has the same mesh, dofmaps and
+/// interior facet integration domains as the form it was created
+/// from, e.g. the same form with updated coefficients or constants
+/// (see AssemblyPlan::compatible).
+
+template <typename T>
+class AssemblyPlan
+{
+public:
+  /// Create an assembly plan
+  /// @param[in] a The bilinear form
+  /// @param[in] pattern The sparsity pattern of the form. It must be
+  ///   finalised.
+  AssemblyPlan(const Form<T>& a, const la::SparsityPattern& pattern)
+      : _matrix(pattern), _mesh(a.mesh()),
+        _dofmaps({a.function_space(0)->dofmap(),
+                  a.function_space(1)->dofmap()}),
+        _cell_positions(0)
+  {
+    assert(_mesh);
+    assert(_dofmaps[0]);
+    assert(_dofmaps[1]);
+    const graph::AdjacencyList<std::int32_t>& dofs0 = _dofmaps[0]->list();
+    const graph::AdjacencyList<std::int32_t>& dofs1 = _dofmaps[1]->list();
+
+    // Positions of the element matrix entries for all cells
+    const FormIntegrals<T>& integrals = a.integrals();
+    _has_cell_positions
+        = integrals.num_integrals(IntegralType::cell) > 0
+          or integrals.num_integrals(IntegralType::exterior_facet) > 0;
+    if (_has_cell_positions)
+      _cell_positions = _matrix.compute_block_positions(dofs0, dofs1);
+
+    // Positions of the element matrix entries for the interior facets
+    // of each integral, using the dofs of both attached cells
+    const int num_interior
+        = integrals.num_integrals(IntegralType::interior_facet);
+    if (num_interior > 0)
+    {
+      const int tdim = _mesh->topology().dim();
+      _mesh->topology_mutable().create_entities(tdim - 1);
+      _mesh->topology_mutable().create_connectivity(tdim - 1, tdim);
+      auto f_to_c = _mesh->topology().connectivity(tdim - 1, tdim);
+      assert(f_to_c);
+      for (int i = 0; i < num_interior; ++i)
+      {
+        const std::vector<std::int32_t>& facets
+            = integrals.integral_domains(IntegralType::interior_facet, i);
+        _interior_facets.push_back(facets);
+
+        std::vector<std::int32_t> joint0, joint1;
+        std::vector<std::int32_t> offsets0(1, 0), offsets1(1, 0);
+        for (std::int32_t f : facets)
+        {
+          auto cells = f_to_c->links(f);
+          assert(cells.rows() == 2);
+          for (int j = 0; j < 2; ++j)
+          {
+            auto d0 = dofs0.links(cells[j]);
+            auto d1 = dofs1.links(cells[j]);
+            joint0.insert(joint0.end(), d0.data(), d0.data() + d0.rows());
+            joint1.insert(joint1.end(), d1.data(), d1.data() + d1.rows());
+          }
+          offsets0.push_back(joint0.size());
+          offsets1.push_back(joint1.size());
+        }
+
+        _interior_facet_positions.push_back(_matrix.compute_block_positions(
+            graph::AdjacencyList<std::int32_t>(joint0, offsets0),
+            graph::AdjacencyList<std::int32_t>(joint1, offsets1)));
+      }
+    }
+
+    // Position of each entry of the owned rows in its row of the
+    // diagonal block (owned columns) or the off-diagonal block (ghost
+    // columns, ordered by global index). Owned columns come first in
+    // each row of the plan matrix.
+    const std::vector<std::int32_t>& row_ptr = _matrix.row_ptr();
+    const std::vector<std::int32_t>& cols = _matrix.cols();
+    const std::vector<std::int64_t>& ghost_cols = _matrix.ghost_cols();
+    const common::IndexMap& map1 = *_matrix.index_maps()[1];
+    const std::int32_t local_size1 = map1.block_size() * map1.size_local();
+    const std::int32_t num_owned_rows = _matrix.num_owned_rows();
+    _block_row_positions.resize(row_ptr[num_owned_rows]);
+    _num_diagonal.resize(num_owned_rows);
+    std::vector<std::int32_t> off;
+    for (std::int32_t r = 0; r < num_owned_rows; ++r)
+    {
+      std::int32_t k = row_ptr[r];
+      for (; k < row_ptr[r + 1] and cols[k] < local_size1; ++k)
+        _block_row_positions[k] = k - row_ptr[r];
+      _num_diagonal[r] = k - row_ptr[r];
+
+      off.resize(row_ptr[r + 1] - k);
+      std::iota(off.begin(), off.end(), k);
+      std::sort(off.begin(), off.end(), [&](auto k0, auto k1) {
+        return ghost_cols[cols[k0] - local_size1]
+               < ghost_cols[cols[k1] - local_size1];
+      });
+      for (std::size_t j = 0; j < off.size(); ++j)
+        _block_row_positions[off[j]] = j;
+    }
+  }
+
+  /// Move constructor
+  AssemblyPlan(AssemblyPlan&& plan) = default;
+
+  /// Destructor
+  ~AssemblyPlan() = default;
+
+  /// Move assignment
+  AssemblyPlan& operator=(AssemblyPlan&& plan) = default;
+
+  /// Check if the plan can be used to assemble a form, i.e. if the
+  /// form has the same mesh and dofmaps as the form the plan was
+  /// created from, and its integrals touch only entries for which
+  /// positions have been computed
+  /// @param[in] a The bilinear form
+  /// @return True if the plan can be used to assemble @p a
+  bool compatible(const Form<T>& a) const
+  {
+    if (a.mesh() != _mesh or a.function_space(0)->dofmap() != _dofmaps[0]
+        or a.function_space(1)->dofmap() != _dofmaps[1])
+    {
+      return false;
+    }
+
+    const FormIntegrals<T>& integrals = a.integrals();
+    if (!_has_cell_positions
+        and (integrals.num_integrals(IntegralType::cell) > 0
+             or integrals.num_integrals(IntegralType::exterior_facet) > 0))
+    {
+      return false;
+    }
+
+    const int num_interior
+        = integrals.num_integrals(IntegralType::interior_facet);
+    if (num_interior != (int)_interior_facets.size())
+      return false;
+    for (int i = 0; i < num_interior; ++i)
+    {
+      if (integrals.integral_domains(IntegralType::interior_facet, i)
+          != _interior_facets[i])
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /// Return a function that adds the element matrix of a cell to the
+  /// plan matrix (see impl::assemble_matrix). The function can be
+  /// called concurrently for cells that share no row dofs.
+  std::function<void(std::int32_t, const T*)> cell_add()
+  {
+    if (!_has_cell_positions)
+      return nullptr;
+    return [this](std::int32_t c, const T* Ae) {
+      auto pos = _cell_positions.links(c);
+      std::vector<T>& values = _matrix.values();
+      for (Eigen::Index k = 0; k < pos.rows(); ++k)
+        values[pos[k]] += Ae[k];
+    };
+  }
+
+  /// Return a function that adds the element matrix of an interior
+  /// facet to the plan matrix (see impl::assemble_matrix). It is called
+  /// with the integral index, the position of the facet in the
+  /// integration domain and the element matrix.
+  std::function<void(int, std::int32_t, const T*)> interior_facet_add()
+  {
+    return [this](int i, std::int32_t f, const T* Ae) {
+      auto pos = _interior_facet_positions[i].links(f);
+      std::vector<T>& values = _matrix.values();
+      for (Eigen::Index k = 0; k < pos.rows(); ++k)
+        values[pos[k]] += Ae[k];
+    };
+  }
+
+  /// Position of each entry of the owned rows of the plan matrix within
+  /// its row of the diagonal block (owned columns) or of the
+  /// off-diagonal block (ghost columns, ordered by increasing global
+  /// index), i.e. the layout of distributed AIJ matrices, e.g. in PETSc
+  const std::vector<std::int32_t>& block_row_positions() const
+  {
+    return _block_row_positions;
+  }
+
+  /// Number of entries in the diagonal block (owned columns) of each
+  /// owned row of the plan matrix
+  const std::vector<std::int32_t>& num_diagonal() const
+  {
+    return _num_diagonal;
+  }
+
+  /// The matrix that the plan assembles into
+  la::MatrixCSR<T>& matrix() { return _matrix; }
+
+  /// The matrix that the plan assembles into (const version)
+  const la::MatrixCSR<T>& matrix() const { return _matrix; }
+
+private:
+  // Matrix with the layout of the sparsity pattern
+  la::MatrixCSR<T> _matrix;
+
+  // Mesh and dofmaps of the form
+  std::shared_ptr<const mesh::Mesh> _mesh;
+  std::array<std::shared_ptr<const fem::DofMap>, 2> _dofmaps;
+
+  // Positions in the value array for the element matrix of each cell
+  bool _has_cell_positions;
+  graph::AdjacencyList<std::int32_t> _cell_positions;
+
+  // Integration domain of each interior facet integral, and positions
+  // in the value array for the element matrix of each facet in the
+  // domain
+  std::vector<std::vector<std::int32_t>> _interior_facets;
+  std::vector<graph::AdjacencyList<std::int32_t>> _interior_facet_positions;
+
+  // Position of each owned row entry in the diagonal or off-diagonal
+  // block, and the number of diagonal block entries in each owned row
+  std::vector<std::int32_t> _block_row_positions, _num_diagonal;
+};
+
+} // namespace dolfinx::fem
@@ -191,3 +191,63 @@ void CoordinateElement::compute_reference_geometry(
   }
 }
 //-----------------------------------------------------------------------------
+Eigen::Tensor<double, 3, Eigen::RowMajor>
+CoordinateElement::tabulate_basis_derivatives(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                        Eigen::RowMajor>>& X) const
+{
+  assert(X.cols() == _tdim);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> dphi(X.rows(),
+                                                 _dof_layout.num_dofs(), _tdim);
+  if (X.rows() > 0)
+    _evaluate_basis_derivatives(dphi.data(), 1, X.rows(), X.data());
+  return dphi;
+}
+//-----------------------------------------------------------------------------
+void CoordinateElement::compute_jacobian_data(
+    Eigen::Tensor<double, 3, Eigen::RowMajor>& J,
+    Eigen::Ref<Eigen::Array<double, Eigen::Dynamic, 1>> detJ,
+    Eigen::Tensor<double, 3, Eigen::RowMajor>& K,
+    const Eigen::Tensor<double, 3, Eigen::RowMajor>& dphi,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                        Eigen::RowMajor>>& cell_geometry) const
+{
+  const int num_points = dphi.dimension(0);
+  const int d = dphi.dimension(1);
+  assert(dphi.dimension(2) == _tdim);
+  assert(cell_geometry.rows() == d);
+  assert(cell_geometry.cols() == _gdim);
+  assert(J.dimension(0) == num_points);
+  assert(J.dimension(1) == _gdim);
+  assert(J.dimension(2) == _tdim);
+  assert(detJ.rows() == num_points);
+  assert(K.dimension(0) == num_points);
+  assert(K.dimension(1) == _tdim);
+  assert(K.dimension(2) == _gdim);
+
+  for (int ip = 0; ip < num_points; ++ip)
+  {
+    Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                                   Eigen::RowMajor>>
+        dphi_ip(dphi.data() + ip * d * _tdim, d, _tdim);
+    Eigen::Map<
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+        Jview(J.data() + ip * _gdim * _tdim, _gdim, _tdim);
+    Eigen::Map<
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+        Kview(K.data() + ip * _gdim * _tdim, _tdim, _gdim);
+    Jview = cell_geometry.matrix().transpose() * dphi_ip;
+    if (_gdim == _tdim)
+    {
+      Kview = Jview.inverse();
+      detJ.row(ip) = Jview.determinant();
+    }
+    else
+    {
+      // Penrose-Moore pseudo-inverse
+      Kview = (Jview.transpose() * Jview).inverse() * Jview.transpose();
+      detJ.row(ip) = std::sqrt((Jview.transpose() * Jview).determinant());
+    }
+  }
+}
+//-----------------------------------------------------------------------------
@@ -85,6 +85,34 @@ public:
                                           Eigen::Dynamic, Eigen::RowMajor>>&
           cell_geometry) const;
 
+  /// Tabulate the first derivatives of the basis functions at points on
+  /// the reference cell, for use with
+  /// CoordinateElement::compute_jacobian_data
+  /// @param[in] X The points on the reference cell (num_points, tdim)
+  /// @return The derivatives (num_points, num_dofs, tdim)
+  Eigen::Tensor<double, 3, Eigen::RowMajor> tabulate_basis_derivatives(
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic,
+                                          Eigen::Dynamic, Eigen::RowMajor>>& X)
+      const;
+
+  /// Compute J, detJ and K at given points on the reference cell. The
+  /// reference points are known, so unlike compute_reference_geometry
+  /// no pull-back of physical points is computed.
+  /// @param[out] J The Jacobian (num_points, gdim, tdim)
+  /// @param[out] detJ The (pseudo-)determinant of J (num_points)
+  /// @param[out] K The (pseudo-)inverse of J (num_points, tdim, gdim)
+  /// @param[in] dphi The derivatives of the basis functions at the
+  ///   points, from CoordinateElement::tabulate_basis_derivatives
+  /// @param[in] cell_geometry The cell node coordinates (physical)
+  void compute_jacobian_data(
+      Eigen::Tensor<double, 3, Eigen::RowMajor>& J,
+      Eigen::Ref<Eigen::Array<double, Eigen::Dynamic, 1>> detJ,
+      Eigen::Tensor<double, 3, Eigen::RowMajor>& K,
+      const Eigen::Tensor<double, 3, Eigen::RowMajor>& dphi,
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic,
+                                          Eigen::Dynamic, Eigen::RowMajor>>&
+          cell_geometry) const;
+
 private:
   // Topological and geometric dimensions
   int _tdim, _gdim;
@@ -199,7 +199,7 @@ public:
   {
     // FIXME: This one excludes ghosts. Need to straighten out.
     assert(_g);
-    auto& g = _g->x()->array();
+    const Eigen::Matrix<T, Eigen::Dynamic, 1>& g = _g->x()->array();
     for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
     {
       if (_dofs(i, 0) < x.rows())
@@ -215,7 +215,7 @@ public:
   {
     // FIXME: This one excludes ghosts. Need to straighten out.
     assert(_g);
-    auto& g = _g->x()->array();
+    const Eigen::Matrix<T, Eigen::Dynamic, 1>& g = _g->x()->array();
     assert(x.rows() <= x0.rows());
     for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
     {
@@ -230,7 +230,7 @@ public:
   void dof_values(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> values) const
   {
     assert(_g);
-    auto& g = _g->x()->array();
+    const Eigen::Matrix<T, Eigen::Dynamic, 1>& g = _g->x()->array();
     for (Eigen::Index i = 0; i < _dofs.rows(); ++i)
       values[_dofs(i, 0)] = g[_dofs(i, 1)];
   }
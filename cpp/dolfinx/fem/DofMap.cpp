@@ -11,9 +11,12 @@
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/BoostGraphColoring.h>
 #include <dolfinx/mesh/Topology.h>
+#include <numeric>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
@@ -162,10 +165,38 @@ DofMap::DofMap(std::shared_ptr<const ElementDofLayout> element_dof_layout,
                std::shared_ptr<const common::IndexMap> index_map,
                const graph::AdjacencyList<std::int32_t>& dofmap)
     : element_dof_layout(element_dof_layout), index_map(index_map),
-      _dofmap(dofmap)
+      _dofmap(dofmap), _dofmap_blocked(0)
 {
   // Dofmap data is copied as the types for dofmap and _dofmap may
   // differ, typically 32- vs 64-bit integers
+
+  // Keep the node indices of each cell if the dofmap is blocked
+  const int bs = element_dof_layout ? element_dof_layout->block_size() : 1;
+  if (bs > 1 and index_map and index_map->block_size() == bs)
+  {
+    const std::int32_t num_cells = _dofmap.num_nodes();
+    const int num_nodes = element_dof_layout->num_dofs() / bs;
+    Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        nodes(num_cells, num_nodes);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      auto dofs = _dofmap.links(c);
+      if (dofs.rows() != bs * num_nodes)
+        return;
+      for (int j = 0; j < num_nodes; ++j)
+      {
+        nodes(c, j) = dofs[j] / bs;
+        for (int b = 0; b < bs; ++b)
+        {
+          // Not a blocked layout, so keep block size of one
+          if (dofs[b * num_nodes + j] != bs * nodes(c, j) + b)
+            return;
+        }
+      }
+    }
+    _bs = bs;
+    _dofmap_blocked = graph::AdjacencyList<std::int32_t>(nodes);
+  }
 }
 //-----------------------------------------------------------------------------
 DofMap DofMap::extract_sub_dofmap(const std::vector<int>& component) const
@@ -252,3 +283,72 @@ DofMap::collapse(MPI_Comm comm, const mesh::Topology& topology) const
   return {std::move(dofmap_new), std::move(collapsed_map)};
 }
 //-----------------------------------------------------------------------------
+const std::vector<std::int32_t>& DofMap::cell_colors() const
+{
+  if (!_cell_colors.empty() or _dofmap.num_nodes() == 0)
+    return _cell_colors;
+
+  common::Timer timer("Compute cell colouring of dofmap");
+
+  // Build dof-to-cell map
+  const std::int32_t num_cells = _dofmap.num_nodes();
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& dofs = _dofmap.array();
+  const std::int32_t num_dofs = dofs.rows() > 0 ? dofs.maxCoeff() + 1 : 0;
+  std::vector<std::int32_t> dof_offsets(num_dofs + 1, 0);
+  for (Eigen::Index i = 0; i < dofs.rows(); ++i)
+    ++dof_offsets[dofs[i] + 1];
+  std::partial_sum(dof_offsets.begin(), dof_offsets.end(),
+                   dof_offsets.begin());
+  std::vector<std::int32_t> dof_cells(dof_offsets.back());
+  std::vector<std::int32_t> pos(dof_offsets.begin(), dof_offsets.end() - 1);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto cell_dofs = _dofmap.links(c);
+    for (Eigen::Index i = 0; i < cell_dofs.rows(); ++i)
+      dof_cells[pos[cell_dofs[i]]++] = c;
+  }
+
+  // Build cell-to-cell conflict graph, i.e. cells that share a dof
+  std::vector<std::int32_t> graph_data, graph_offsets(1, 0);
+  std::vector<std::int32_t> marker(num_cells, -1);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto cell_dofs = _dofmap.links(c);
+    for (Eigen::Index i = 0; i < cell_dofs.rows(); ++i)
+    {
+      const std::int32_t dof = cell_dofs[i];
+      for (std::int32_t j = dof_offsets[dof]; j < dof_offsets[dof + 1]; ++j)
+      {
+        const std::int32_t c1 = dof_cells[j];
+        if (c1 != c and marker[c1] != c)
+        {
+          marker[c1] = c;
+          graph_data.push_back(c1);
+        }
+      }
+    }
+    graph_offsets.push_back(graph_data.size());
+  }
+
+  const graph::AdjacencyList<std::int32_t> graph(graph_data, graph_offsets);
+  graph::BoostGraphColoring::compute_local_vertex_coloring(graph,
+                                                           _cell_colors);
+  return _cell_colors;
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::int8_t>& DofMap::ghost_cell_markers() const
+{
+  const std::int32_t num_cells = _dofmap.num_nodes();
+  if ((std::int32_t)_ghost_cell_markers.size() == num_cells)
+    return _ghost_cell_markers;
+
+  assert(index_map);
+  const std::int32_t size_owned
+      = index_map->block_size() * index_map->size_local();
+  _ghost_cell_markers.resize(num_cells);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    _ghost_cell_markers[c] = (_dofmap.links(c) >= size_owned).any();
+
+  return _ghost_cell_markers;
+}
+//-----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 
 #include "ElementDofLayout.h"
 #include <Eigen/Dense>
+#include <cstdint>
 #include <cstdlib>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <memory>
@@ -87,6 +88,38 @@ public:
   /// @return The adjacency list with dof indices for each cell
   const graph::AdjacencyList<std::int32_t>& list() const { return _dofmap; }
 
+  /// Block size of the dofmap, i.e. the number of dofs co-located at
+  /// each node. The block size is greater than one only if the dofs of
+  /// each cell have the layout created by DofMapBuilder for blocked
+  /// elements, i.e. dof b * n + j of a cell is bs * node_j + b, where n
+  /// is the number of nodes of the cell.
+  int bs() const { return _bs; }
+
+  /// Get the blocked dofmap, i.e. the node indices for each cell. Node
+  /// i holds the dofs bs * i, ..., bs * i + bs - 1.
+  /// @return The adjacency list with node indices for each cell. If the
+  ///   block size is one, this is the same as list().
+  const graph::AdjacencyList<std::int32_t>& list_blocked() const
+  {
+    return _bs == 1 ? _dofmap : _dofmap_blocked;
+  }
+
+  /// Colouring of the cells such that no two cells of the same colour
+  /// share a degree-of-freedom. Cells of one colour can therefore be
+  /// assembled concurrently. The colouring is computed on the first
+  /// call and cached.
+  /// @note Not thread-safe on first call
+  /// @return The colour of each cell (owned and ghost)
+  const std::vector<std::int32_t>& cell_colors() const;
+
+  /// Markers for the cells with one or more ghost dofs, i.e. dofs that
+  /// are not owned by this process (see fem::split_cells_by_ownership).
+  /// The markers are computed on the first call and cached.
+  /// @note Not thread-safe on first call
+  /// @return 1 for each cell (owned and ghost) with ghost dofs and 0
+  ///   otherwise
+  const std::vector<std::int8_t>& ghost_cell_markers() const;
+
   /// Layout of dofs on an element
   std::shared_ptr<const ElementDofLayout> element_dof_layout;
 
@@ -96,6 +129,17 @@ public:
 private:
   // Cell-local-to-dof map (dofs for cell dofmap[i])
   graph::AdjacencyList<std::int32_t> _dofmap;
+
+  // Block size and cell-local-to-node map (empty if the block size is
+  // one)
+  int _bs = 1;
+  graph::AdjacencyList<std::int32_t> _dofmap_blocked;
+
+  // Cell colours (computed on demand)
+  mutable std::vector<std::int32_t> _cell_colors;
+
+  // Markers for cells with ghost dofs (computed on demand)
+  mutable std::vector<std::int8_t> _ghost_cell_markers;
 };
 } // namespace fem
 } // namespace dolfinx
@@ -8,11 +8,15 @@
 
 #include "FormCoefficients.h"
 #include "FormIntegrals.h"
+#include <Eigen/Dense>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 // Forward declaration
@@ -221,6 +225,7 @@ public:
   void set_mesh(const std::shared_ptr<const mesh::Mesh>& mesh)
   {
     _mesh = mesh;
+    _packed_state.clear();
     // Set markers for default integrals
     _integrals.set_default_domains(*_mesh);
   }
@@ -257,6 +262,16 @@ public:
       _integrals.set_default_domains(*_mesh);
   }
 
+  /// Register a batched 'tabulate_tensor' function for existing cell
+  /// integral i. See FormIntegrals::set_batch_tabulate_tensor.
+  void set_batch_tabulate_tensor(
+      IntegralType type, int i,
+      const std::function<void(T*, const T*, const T*, const double*,
+                               const std::uint32_t*, int)>& fn)
+  {
+    _integrals.set_batch_tabulate_tensor(type, i, fn);
+  }
+
   /// Access coefficients
   FormCoefficients<T>& coefficients() { return _coefficients; }
 
@@ -266,6 +281,97 @@ public:
   /// Access form integrals
   const FormIntegrals<T>& integrals() const { return _integrals; }
 
+  /// Get packed coefficient values for all cells, in the layout
+  /// returned by fem::pack_coefficients. The packed array is cached on
+  /// the Form and on each call only coefficients that have been
+  /// replaced, or whose values have changed (see
+  /// function::Function::version), since the previous call are
+  /// repacked. If an array has been supplied with
+  /// Form::set_packed_coefficients, it is returned unchanged.
+  /// @return Packed coefficients, shape (num_cells, offsets.back())
+  const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+  packed_coefficients() const
+  {
+    if (_packed_coefficients_user)
+      return _packed_coefficients;
+
+    assert(_mesh);
+    const int tdim = _mesh->topology().dim();
+    std::shared_ptr<const common::IndexMap> map
+        = _mesh->topology().index_map(tdim);
+    assert(map);
+    const std::int32_t num_cells = map->size_local() + map->num_ghosts();
+    const std::vector<int> offsets = _coefficients.offsets();
+
+    // Discard cached data if the layout has changed
+    if (_packed_coefficients.rows() != num_cells
+        or _packed_coefficients.cols() != offsets.back()
+        or (int)_packed_state.size() != _coefficients.size())
+    {
+      _packed_coefficients.resize(num_cells, offsets.back());
+      _packed_state.assign(_coefficients.size(),
+                           {std::numeric_limits<std::size_t>::max(), 0});
+    }
+
+    // Repack coefficients that are new or have changed
+    for (int i = 0; i < _coefficients.size(); ++i)
+    {
+      std::shared_ptr<const function::Function<T>> f = _coefficients.get(i);
+      const std::pair<std::size_t, std::uint64_t> state(f->id(),
+                                                        f->version());
+      if (state == _packed_state[i])
+        continue;
+
+      const fem::DofMap& dofmap = *f->function_space()->dofmap();
+      const Eigen::Matrix<T, Eigen::Dynamic, 1>& v = f->x()->array();
+      for (std::int32_t cell = 0; cell < num_cells; ++cell)
+      {
+        auto dofs = dofmap.cell_dofs(cell);
+        for (Eigen::Index k = 0; k < dofs.size(); ++k)
+          _packed_coefficients(cell, k + offsets[i]) = v[dofs[k]];
+      }
+      _packed_state[i] = state;
+    }
+
+    return _packed_coefficients;
+  }
+
+  /// Supply packed coefficient values to be used in assembly in place
+  /// of the values packed from the Form coefficients. This avoids
+  /// packing for repeated assembly with data that is already available
+  /// in packed form. The array is used until
+  /// Form::clear_packed_coefficients is called.
+  /// @param[in] coefficients Packed coefficients, in the layout
+  ///   returned by fem::pack_coefficients
+  void set_packed_coefficients(
+      const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+          coefficients)
+  {
+    assert(_mesh);
+    const int tdim = _mesh->topology().dim();
+    std::shared_ptr<const common::IndexMap> map
+        = _mesh->topology().index_map(tdim);
+    assert(map);
+    if (coefficients.rows() != map->size_local() + map->num_ghosts()
+        or coefficients.cols() != _coefficients.offsets().back())
+    {
+      throw std::runtime_error("Packed coefficient array has wrong shape");
+    }
+
+    _packed_coefficients = coefficients;
+    _packed_coefficients_user = true;
+    _packed_state.clear();
+  }
+
+  /// Discard packed coefficients supplied with
+  /// Form::set_packed_coefficients and revert to packing from the Form
+  /// coefficients
+  void clear_packed_coefficients()
+  {
+    _packed_coefficients_user = false;
+    _packed_state.clear();
+  }
+
   /// Access constants
   /// @return Vector of attached constants with their names. Names are
   ///   used to set constants in user's c++ code. Index in the vector is
@@ -294,6 +400,16 @@ private:
 
   // The mesh (needed for functionals when we don't have any spaces)
   std::shared_ptr<const mesh::Mesh> _mesh;
+
+  // Cached packed coefficients
+  mutable Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      _packed_coefficients;
+
+  // (Function id, version) of each coefficient when it was last packed
+  mutable std::vector<std::pair<std::size_t, std::uint64_t>> _packed_state;
+
+  // True if the packed coefficients have been supplied by the user
+  bool _packed_coefficients_user = false;
 };
 } // namespace fem
 } // namespace dolfinx
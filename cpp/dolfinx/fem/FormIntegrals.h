@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <dolfinx/mesh/MeshTags.h>
 #include <functional>
@@ -53,6 +54,20 @@ public:
     return _integrals.at(static_cast<int>(type)).at(i).tabulate;
   }
 
+  /// Get the batched function for 'tabulate_tensor' for integral i of
+  /// given type. See FormIntegrals::set_batch_tabulate_tensor for the
+  /// function signature and data layout.
+  /// @param[in] type Integral type
+  /// @param[in] i Integral number
+  /// @return Function to call for tabulate_tensor on a batch of
+  ///   cells. The function is empty if no batched kernel has been set.
+  const std::function<void(T*, const T*, const T*, const double*,
+                           const std::uint32_t*, int)>&
+  get_batch_tabulate_tensor(IntegralType type, int i) const
+  {
+    return _integrals.at(static_cast<int>(type)).at(i).batch_tabulate;
+  }
+
   /// Set the function for 'tabulate_tensor' for integral i of
   /// given type
   /// @param[in] type Integral type
@@ -82,7 +97,54 @@ public:
     }
 
     // Insert new Integral
-    integrals.insert(integrals.begin() + pos, {fn, i, {}});
+    integrals.insert(integrals.begin() + pos, {fn, nullptr, i, {}});
+  }
+
+  /// Set a batched 'tabulate_tensor' function for an existing cell
+  /// integral with ID i. Assemblers call the batched function, when
+  /// set, in place of the per-cell function.
+  ///
+  /// The function computes the element tensors of n cells in one call,
+  /// fn(A, w, c, coordinate_dofs, cell_info, n). All arrays holding
+  /// per-cell data use a structure-of-arrays layout with the cell
+  /// index running fastest, i.e.
+  ///
+  ///  - A[k * n + q]: entry k of the (row-major) element tensor of
+  ///    cell q
+  ///  - w[k * n + q]: packed coefficient value k of cell q
+  ///  - coordinate_dofs[(j * gdim + d) * n + q]: component d of
+  ///    coordinate dof j of cell q
+  ///  - cell_info[q]: permutation info of cell q
+  ///
+  /// The constants c are shared by all cells. The array A is zeroed
+  /// before the call. This layout allows generated kernels to
+  /// vectorise across cells.
+  ///
+  /// @param[in] type Integral type. Must be IntegralType::cell.
+  /// @param[in] i Integral ID
+  /// @param[in] fn Batched tabulate function
+  void set_batch_tabulate_tensor(
+      IntegralType type, int i,
+      std::function<void(T*, const T*, const T*, const double*,
+                         const std::uint32_t*, int)>
+          fn)
+  {
+    if (type != IntegralType::cell)
+    {
+      throw std::runtime_error(
+          "Batched tabulate_tensor is only supported for cell integrals");
+    }
+
+    std::vector<struct FormIntegrals::Integral>& integrals
+        = _integrals.at(static_cast<int>(type));
+    auto it = std::find_if(integrals.begin(), integrals.end(),
+                           [i](const auto& q) { return q.id == i; });
+    if (it == integrals.end())
+    {
+      throw std::runtime_error("Integral with ID " + std::to_string(i)
+                               + " does not exist");
+    }
+    it->batch_tabulate = fn;
   }
 
   /// Get types of integrals in the form
@@ -246,6 +308,23 @@ public:
           integrals[it->second].active_entities.push_back(*e);
         }
       }
+
+      // Sort cells by the traversal order of the topology if set
+      const std::vector<std::int32_t>& order = topology.cell_traversal_order();
+      if (type == IntegralType::cell and !order.empty())
+      {
+        std::vector<std::int32_t> position(order.size());
+        for (std::size_t j = 0; j < order.size(); ++j)
+          position[order[j]] = j;
+        for (auto& integral : integrals)
+        {
+          std::sort(integral.active_entities.begin(),
+                    integral.active_entities.end(),
+                    [&position](auto c0, auto c1) {
+                      return position[c0] < position[c1];
+                    });
+        }
+      }
     }
   }
 
@@ -261,13 +340,19 @@ public:
     std::vector<struct Integral>& cell_integrals
         = _integrals[static_cast<int>(IntegralType::cell)];
 
-    // Cells. If there is a default integral, define it on all owned cells
+    // Cells. If there is a default integral, define it on all owned
+    // cells, in the traversal order of the topology if set
     if (cell_integrals.size() > 0 and cell_integrals[0].id == -1)
     {
       const int num_cells = topology.index_map(tdim)->size_local();
-      cell_integrals[0].active_entities.resize(num_cells);
-      std::iota(cell_integrals[0].active_entities.begin(),
-                cell_integrals[0].active_entities.end(), 0);
+      if (!topology.cell_traversal_order().empty())
+        cell_integrals[0].active_entities = topology.cell_traversal_order();
+      else
+      {
+        cell_integrals[0].active_entities.resize(num_cells);
+        std::iota(cell_integrals[0].active_entities.begin(),
+                  cell_integrals[0].active_entities.end(), 0);
+      }
     }
 
     // Exterior facets. If there is a default integral, define it only on
@@ -333,6 +418,9 @@ private:
     std::function<void(T*, const T*, const T*, const double*, const int*,
                        const std::uint8_t*, const std::uint32_t)>
         tabulate;
+    std::function<void(T*, const T*, const T*, const double*,
+                       const std::uint32_t*, int)>
+        batch_tabulate;
     int id;
     std::vector<std::int32_t> active_entities;
   };
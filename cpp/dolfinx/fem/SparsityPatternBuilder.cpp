@@ -10,10 +10,139 @@
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/mesh/Topology.h>
+#include <numeric>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Compute the sparsity pattern of the dense blocks rows.links(e) x
+// cols.links(e) for all elements e, using local (process-wise) indices.
+// The pattern is computed in two passes over the rows of the index map
+// of the pattern: the first counts the unique columns of each row, and
+// the second fills the columns into a single buffer. Rows are
+// processed concurrently by OpenMP threads. For a blocked pattern the
+// indices are block indices.
+graph::AdjacencyList<std::int32_t>
+compute_pattern(const la::SparsityPattern& pattern,
+                const graph::AdjacencyList<std::int32_t>& rows,
+                const graph::AdjacencyList<std::int32_t>& cols)
+{
+  assert(rows.num_nodes() == cols.num_nodes());
+  std::array<std::int32_t, 2> size;
+  for (int i = 0; i < 2; ++i)
+  {
+    auto map = pattern.index_map(i);
+    assert(map);
+    const int bs = pattern.blocked() ? 1 : map->block_size();
+    size[i] = bs * (map->size_local() + map->num_ghosts());
+  }
+
+  // Compute the elements that contribute to each row
+  std::vector<std::int32_t> offsets(size[0] + 1, 0);
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& row_array
+      = rows.array();
+  for (Eigen::Index i = 0; i < row_array.rows(); ++i)
+    ++offsets[row_array[i] + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::int32_t> row_elements(offsets.back());
+  std::vector<std::int32_t> pos(offsets.begin(), offsets.end() - 1);
+  for (std::int32_t e = 0; e < rows.num_nodes(); ++e)
+  {
+    auto r = rows.links(e);
+    for (Eigen::Index i = 0; i < r.rows(); ++i)
+      row_elements[pos[r[i]]++] = e;
+  }
+
+  // Count unique columns in each row. A column is counted once per row
+  // by marking it with the row index.
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> row_ptr(size[0] + 1);
+  row_ptr[0] = 0;
+#pragma omp parallel
+  {
+    std::vector<std::int32_t> marker(size[1], -1);
+#pragma omp for schedule(static)
+    for (std::int32_t r = 0; r < size[0]; ++r)
+    {
+      std::int32_t num_cols = 0;
+      for (std::int32_t k = offsets[r]; k < offsets[r + 1]; ++k)
+      {
+        auto c = cols.links(row_elements[k]);
+        for (Eigen::Index j = 0; j < c.rows(); ++j)
+        {
+          if (marker[c[j]] != r)
+          {
+            marker[c[j]] = r;
+            ++num_cols;
+          }
+        }
+      }
+      row_ptr[r + 1] = num_cols;
+    }
+  }
+  std::partial_sum(row_ptr.data(), row_ptr.data() + row_ptr.rows(),
+                   row_ptr.data());
+
+  // Fill and sort columns of each row
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> data(row_ptr[size[0]]);
+#pragma omp parallel
+  {
+    std::vector<std::int32_t> marker(size[1], -1);
+#pragma omp for schedule(static)
+    for (std::int32_t r = 0; r < size[0]; ++r)
+    {
+      std::int32_t* row = data.data() + row_ptr[r];
+      std::int32_t* p = row;
+      for (std::int32_t k = offsets[r]; k < offsets[r + 1]; ++k)
+      {
+        auto c = cols.links(row_elements[k]);
+        for (Eigen::Index j = 0; j < c.rows(); ++j)
+        {
+          if (marker[c[j]] != r)
+          {
+            marker[c[j]] = r;
+            *p++ = c[j];
+          }
+        }
+      }
+      std::sort(row, p);
+    }
+  }
+
+  return graph::AdjacencyList<std::int32_t>(std::move(data),
+                                            std::move(row_ptr));
+}
+//-----------------------------------------------------------------------------
+// Get the dofmaps to insert into the pattern, i.e. the node indices of
+// each cell for a blocked pattern and the dof indices otherwise
+std::array<const graph::AdjacencyList<std::int32_t>*, 2>
+get_dofmaps(const la::SparsityPattern& pattern,
+            const std::array<const fem::DofMap*, 2>& dofmaps)
+{
+  std::array<const graph::AdjacencyList<std::int32_t>*, 2> lists;
+  for (int i = 0; i < 2; ++i)
+  {
+    assert(dofmaps[i]);
+    if (pattern.blocked())
+    {
+      if (dofmaps[i]->bs() != pattern.index_map(i)->block_size())
+      {
+        throw std::runtime_error("Cannot insert into blocked sparsity "
+                                 "pattern. Dofmap is not blocked.");
+      }
+      lists[i] = &dofmaps[i]->list_blocked();
+    }
+    else
+      lists[i] = &dofmaps[i]->list();
+  }
+  return lists;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 void SparsityPatternBuilder::cells(
     la::SparsityPattern& pattern, const mesh::Topology& topology,
@@ -24,17 +153,16 @@ void SparsityPatternBuilder::cells(
   const int D = topology.dim();
   auto cells = topology.connectivity(D, 0);
   assert(cells);
-  for (int c = 0; c < cells->num_nodes(); ++c)
-    pattern.insert(dofmaps[0]->cell_dofs(c), dofmaps[1]->cell_dofs(c));
+  assert(dofmaps[0]->list().num_nodes() == cells->num_nodes());
+  const auto [list0, list1] = get_dofmaps(pattern, dofmaps);
+  pattern.insert_csr(compute_pattern(pattern, *list0, *list1));
 }
 //-----------------------------------------------------------------------------
 void SparsityPatternBuilder::interior_facets(
     la::SparsityPattern& pattern, const mesh::Topology& topology,
     const std::array<const fem::DofMap*, 2> dofmaps)
 {
-  assert(dofmaps[0]);
-  assert(dofmaps[1]);
-
+  const auto lists = get_dofmaps(pattern, dofmaps);
   const int D = topology.dim();
   if (!topology.connectivity(D - 1, 0))
     throw std::runtime_error("Topology facets have not been created.");
@@ -43,8 +171,9 @@ void SparsityPatternBuilder::interior_facets(
   if (!connectivity)
     throw std::runtime_error("Facet-cell connectivity has not been computed.");
 
-  // Array to store macro-dofs, if required (for interior facets)
-  std::array<Eigen::Array<std::int32_t, Eigen::Dynamic, 1>, 2> macro_dofs;
+  // Macro-dofs of the two cells attached to each interior facet
+  std::array<std::vector<std::int32_t>, 2> macro_dofs;
+  std::array<std::vector<std::int32_t>, 2> macro_offsets = {{{0}, {0}}};
 
   // Loop over owned facets
   auto map = topology.index_map(D - 1);
@@ -61,27 +190,29 @@ void SparsityPatternBuilder::interior_facets(
 
     // Tabulate dofs for each dimension on macro element
     assert(cells.rows() == 2);
-    const int cell0 = cells[0];
-    const int cell1 = cells[1];
     for (std::size_t i = 0; i < 2; i++)
     {
-      auto cell_dofs0 = dofmaps[i]->cell_dofs(cell0);
-      auto cell_dofs1 = dofmaps[i]->cell_dofs(cell1);
-      macro_dofs[i].resize(cell_dofs0.size() + cell_dofs1.size());
-      std::copy(cell_dofs0.data(), cell_dofs0.data() + cell_dofs0.size(),
-                macro_dofs[i].data());
-      std::copy(cell_dofs1.data(), cell_dofs1.data() + cell_dofs1.size(),
-                macro_dofs[i].data() + cell_dofs0.size());
+      for (int j = 0; j < 2; ++j)
+      {
+        auto cell_dofs = lists[i]->links(cells[j]);
+        macro_dofs[i].insert(macro_dofs[i].end(), cell_dofs.data(),
+                             cell_dofs.data() + cell_dofs.size());
+      }
+      macro_offsets[i].push_back(macro_dofs[i].size());
     }
-
-    pattern.insert(macro_dofs[0], macro_dofs[1]);
   }
+
+  pattern.insert_csr(compute_pattern(
+      pattern,
+      graph::AdjacencyList<std::int32_t>(macro_dofs[0], macro_offsets[0]),
+      graph::AdjacencyList<std::int32_t>(macro_dofs[1], macro_offsets[1])));
 }
 //-----------------------------------------------------------------------------
 void SparsityPatternBuilder::exterior_facets(
     la::SparsityPattern& pattern, const mesh::Topology& topology,
     const std::array<const fem::DofMap*, 2> dofmaps)
 {
+  const auto lists = get_dofmaps(pattern, dofmaps);
   const int D = topology.dim();
   if (!topology.connectivity(D - 1, 0))
     throw std::runtime_error("Topology facets have not been created.");
@@ -95,6 +226,8 @@ void SparsityPatternBuilder::exterior_facets(
   assert(map);
   assert(map->block_size() == 1);
   const std::int32_t num_facets = map->size_local();
+  std::array<std::vector<std::int32_t>, 2> dofs;
+  std::array<std::vector<std::int32_t>, 2> offsets = {{{0}, {0}}};
   for (int f = 0; f < num_facets; ++f)
   {
     // Proceed to next facet if we have an interior facet
@@ -103,8 +236,18 @@ void SparsityPatternBuilder::exterior_facets(
 
     auto cells = connectivity->links(f);
     assert(cells.rows() == 1);
-    pattern.insert(dofmaps[0]->cell_dofs(cells[0]),
-                   dofmaps[1]->cell_dofs(cells[0]));
+    for (std::size_t i = 0; i < 2; i++)
+    {
+      auto cell_dofs = lists[i]->links(cells[0]);
+      dofs[i].insert(dofs[i].end(), cell_dofs.data(),
+                     cell_dofs.data() + cell_dofs.size());
+      offsets[i].push_back(dofs[i].size());
+    }
   }
+
+  pattern.insert_csr(
+      compute_pattern(pattern,
+                      graph::AdjacencyList<std::int32_t>(dofs[0], offsets[0]),
+                      graph::AdjacencyList<std::int32_t>(dofs[1], offsets[1])));
 }
 //-----------------------------------------------------------------------------
@@ -0,0 +1,289 @@
+// Copyright (C) 2026 The DOLFINX authors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "Form.h"
+#include "assemble_matrix_impl.h"
+#include "assemble_vector_impl.h"
+#include "utils.h"
+#include <Eigen/Dense>
+#include <array>
+#include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace dolfinx::fem::impl
+{
+
+/// Assemble bilinear forms into matrices and linear forms into vectors
+/// in a single pass over the cells. Cell integrals of all forms with
+/// the same integration domain are executed together for each cell,
+/// so that the cell geometry is gathered and the cell list traversed
+/// once. Facet integrals are assembled form by form.
+///
+/// The matrices and vectors use local (process-wise) indexing. Rows
+/// (bc0) and columns (bc1) of Dirichlet dofs of the matrices are
+/// zeroed. If assembly is threaded, @p mat_add must be safe to call
+/// concurrently for element matrices that share no rows.
+///
+/// @param[in] mat_add Functions that add element matrices to the
+///   matrix of each bilinear form
+/// @param[in] a The bilinear forms
+/// @param[in] bcs Markers for the rows and columns with Dirichlet
+///   conditions of each bilinear form
+/// @param[in,out] b The vector for each linear form. They are not
+///   zeroed before assembly.
+/// @param[in] L The linear forms. All forms must be defined on the same
+///   mesh.
+template <typename T>
+void assemble_fused(
+    const std::vector<std::function<int(std::int32_t, const std::int32_t*,
+                                        std::int32_t, const std::int32_t*,
+                                        const T*)>>& mat_add,
+    const std::vector<const Form<T>*>& a,
+    const std::vector<std::array<std::vector<bool>, 2>>& bcs,
+    std::vector<Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>>> b,
+    const std::vector<const Form<T>*>& L)
+{
+  assert(mat_add.size() == a.size());
+  assert(bcs.size() == a.size());
+  assert(b.size() == L.size());
+
+  // All forms, with the bilinear forms first
+  std::vector<const Form<T>*> forms(a.begin(), a.end());
+  forms.insert(forms.end(), L.begin(), L.end());
+  const std::size_t num_bilinear = a.size();
+  if (forms.empty())
+    return;
+
+  std::shared_ptr<const mesh::Mesh> mesh = forms[0]->mesh();
+  assert(mesh);
+  for (const Form<T>* form : forms)
+  {
+    assert(form);
+    if (form->mesh() != mesh)
+      throw std::runtime_error("Forms must be defined on the same mesh.");
+  }
+
+  // Dofmaps, constants and coefficients of each form
+  std::vector<std::array<const graph::AdjacencyList<std::int32_t>*, 2>>
+      dofmaps;
+  std::vector<Eigen::Array<T, Eigen::Dynamic, 1>> constants;
+  std::vector<const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
+                                 Eigen::RowMajor>*>
+      coeffs;
+  for (std::size_t k = 0; k < forms.size(); ++k)
+  {
+    const Form<T>& form = *forms[k];
+    if (!form.all_constants_set())
+      throw std::runtime_error("Unset constant in Form");
+    constants.push_back(pack_constants(form));
+    coeffs.push_back(&form.packed_coefficients());
+    const graph::AdjacencyList<std::int32_t>* dofs0
+        = &form.function_space(0)->dofmap()->list();
+    dofmaps.push_back(
+        {dofs0, k < num_bilinear ? &form.function_space(1)->dofmap()->list()
+                                 : dofs0});
+  }
+
+  // Group cell integrals with the same integration domain
+  using kernel_fn
+      = std::function<void(T*, const T*, const T*, const double*, const int*,
+                           const std::uint8_t*, const std::uint32_t)>;
+  std::vector<const std::vector<std::int32_t>*> domains;
+  std::vector<std::vector<std::pair<std::size_t, const kernel_fn*>>> kernels;
+  for (std::size_t k = 0; k < forms.size(); ++k)
+  {
+    const FormIntegrals<T>& integrals = forms[k]->integrals();
+    for (int i = 0; i < integrals.num_integrals(IntegralType::cell); ++i)
+    {
+      const std::vector<std::int32_t>& cells
+          = integrals.integral_domains(IntegralType::cell, i);
+      std::size_t g = 0;
+      while (g < domains.size() and *domains[g] != cells)
+        ++g;
+      if (g == domains.size())
+      {
+        domains.push_back(&cells);
+        kernels.emplace_back();
+      }
+      kernels[g].emplace_back(
+          k, &integrals.get_tabulate_tensor(IntegralType::cell, i));
+    }
+  }
+
+  // Colour cells if assembly will be threaded and all forms have the
+  // same row dofmap
+  std::shared_ptr<const fem::DofMap> dofmap0
+      = forms[0]->function_space(0)->dofmap();
+  bool same_rows = true;
+  for (const Form<T>* form : forms)
+    same_rows = same_rows and form->function_space(0)->dofmap() == dofmap0;
+  const std::vector<std::int32_t> no_colors;
+  const std::vector<std::int32_t>& cell_colors
+      = (num_assembly_threads() > 1 and same_rows and !domains.empty())
+            ? dofmap0->cell_colors()
+            : no_colors;
+
+  const int gdim = mesh->geometry().dim();
+  mesh->topology_mutable().create_entity_permutations();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap
+      = mesh->geometry().dofmap();
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh->geometry().x();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh->topology().get_cell_permutation_info();
+
+  for (std::size_t g = 0; g < domains.size(); ++g)
+  {
+    // Gather the geometry of cell c and execute all kernels of the
+    // group, using the work arrays coordinate_dofs and Ae
+    auto assemble_cell
+        = [&](std::int32_t c,
+              Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                           Eigen::RowMajor>& coordinate_dofs,
+              Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic,
+                            Eigen::RowMajor>& Ae) {
+            auto x_dofs = x_dofmap.links(c);
+            for (int i = 0; i < x_dofs.rows(); ++i)
+              coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+            for (const auto& [k, kernel] : kernels[g])
+            {
+              auto dofs0 = dofmaps[k][0]->links(c);
+              auto coeff_cell = coeffs[k]->row(c);
+              if (k < num_bilinear)
+              {
+                auto dofs1 = dofmaps[k][1]->links(c);
+                Ae.setZero(dofs0.size(), dofs1.size());
+                (*kernel)(Ae.data(), coeff_cell.data(), constants[k].data(),
+                          coordinate_dofs.data(), nullptr, nullptr,
+                          cell_info[c]);
+
+                // Zero rows/columns for essential bcs
+                const auto& [bc0, bc1] = bcs[k];
+                if (!bc0.empty())
+                {
+                  for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+                    if (bc0[dofs0[i]])
+                      Ae.row(i).setZero();
+                }
+                if (!bc1.empty())
+                {
+                  for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+                    if (bc1[dofs1[j]])
+                      Ae.col(j).setZero();
+                }
+
+                mat_add[k](dofs0.size(), dofs0.data(), dofs1.size(),
+                           dofs1.data(), Ae.data());
+              }
+              else
+              {
+                Ae.setZero(dofs0.size(), 1);
+                (*kernel)(Ae.data(), coeff_cell.data(), constants[k].data(),
+                          coordinate_dofs.data(), nullptr, nullptr,
+                          cell_info[c]);
+                auto& _b = b[k - num_bilinear];
+                for (Eigen::Index i = 0; i < dofs0.size(); ++i)
+                  _b[dofs0[i]] += Ae(i, 0);
+              }
+            }
+          };
+
+    if (cell_colors.empty())
+    {
+      Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+          coordinate_dofs(num_dofs_g, gdim);
+      Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Ae;
+      for (std::int32_t c : *domains[g])
+        assemble_cell(c, coordinate_dofs, Ae);
+    }
+    else
+    {
+      // Cells of the same colour share no row dofs of any form
+      const graph::AdjacencyList<std::int32_t> colored_cells
+          = group_by_color(*domains[g], cell_colors);
+#pragma omp parallel
+      {
+        Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+            coordinate_dofs(num_dofs_g, gdim);
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Ae;
+        for (std::int32_t color = 0; color < colored_cells.num_nodes();
+             ++color)
+        {
+          auto cells = colored_cells.links(color);
+#pragma omp for schedule(static)
+          for (Eigen::Index i = 0; i < cells.rows(); ++i)
+            assemble_cell(cells[i], coordinate_dofs, Ae);
+        }
+      }
+    }
+  }
+
+  // Facet integrals
+  for (std::size_t k = 0; k < forms.size(); ++k)
+  {
+    const Form<T>& form = *forms[k];
+    const FormIntegrals<T>& integrals = form.integrals();
+    const fem::DofMap& dofmap = *form.function_space(0)->dofmap();
+    const std::vector<int> c_offsets = form.coefficients().offsets();
+    for (int i = 0; i < integrals.num_integrals(IntegralType::exterior_facet);
+         ++i)
+    {
+      const auto& fn
+          = integrals.get_tabulate_tensor(IntegralType::exterior_facet, i);
+      const std::vector<std::int32_t>& active_facets
+          = integrals.integral_domains(IntegralType::exterior_facet, i);
+      if (k < num_bilinear)
+      {
+        impl::assemble_exterior_facets<T>(
+            mat_add[k], *mesh, active_facets, dofmap,
+            *form.function_space(1)->dofmap(), bcs[k][0], bcs[k][1], fn,
+            *coeffs[k], constants[k]);
+      }
+      else
+      {
+        impl::assemble_exterior_facets<T>(b[k - num_bilinear], *mesh,
+                                          active_facets, dofmap, fn,
+                                          *coeffs[k], constants[k]);
+      }
+    }
+
+    for (int i = 0; i < integrals.num_integrals(IntegralType::interior_facet);
+         ++i)
+    {
+      const auto& fn
+          = integrals.get_tabulate_tensor(IntegralType::interior_facet, i);
+      const std::vector<std::int32_t>& active_facets
+          = integrals.integral_domains(IntegralType::interior_facet, i);
+      if (k < num_bilinear)
+      {
+        impl::assemble_interior_facets<T>(
+            mat_add[k], *mesh, active_facets, dofmap,
+            *form.function_space(1)->dofmap(), bcs[k][0], bcs[k][1], fn,
+            *coeffs[k], c_offsets, constants[k]);
+      }
+      else
+      {
+        impl::assemble_interior_facets<T>(b[k - num_bilinear], *mesh,
+                                          active_facets, dofmap, fn,
+                                          *coeffs[k], c_offsets,
+                                          constants[k]);
+      }
+    }
+  }
+}
+
+} // namespace dolfinx::fem::impl
@@ -6,10 +6,12 @@
 
 #pragma once
 
+#include "DirichletBC.h"
 #include "DofMap.h"
 #include "Form.h"
 #include "utils.h"
 #include <Eigen/Dense>
+#include <array>
 #include <dolfinx/function/FunctionSpace.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/la/utils.h>
@@ -17,6 +19,7 @@
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace dolfinx::fem::impl
@@ -27,6 +30,20 @@ namespace dolfinx::fem::impl
 /// local indices. Rows (bc0) and columns (bc1) with Dirichlet
 /// conditions are zeroed. Markers (bc0 and bc1) can be empty if not bcs
 /// are applied. Matrix is not finalised.
+///
+/// If assembly is threaded (see fem::num_assembly_threads), cells that
+/// share no row dofs are assembled concurrently and @p mat_set_values
+/// is called concurrently from several threads. It must be safe to call
+/// concurrently for element matrices with disjoint rows.
+///
+/// If @p cell_add is set, it is used in place of @p mat_set_values to
+/// add the element matrices of cell and exterior facet integrals. It is
+/// called with the cell index and the (row-major) element matrix, and
+/// must be safe to call concurrently for cells that share no row dofs.
+/// If @p interior_facet_add is set, it is used in place of
+/// @p mat_set_values to add the element matrices of interior facet
+/// integrals. It is called with the integral index, the position of the
+/// facet in the integral domain and the element matrix.
 
 template <typename ScalarType>
 void assemble_matrix(
@@ -34,9 +51,65 @@ void assemble_matrix(
                             const std::int32_t*, const ScalarType*)>&
         mat_set_values,
     const Form<ScalarType>& a, const std::vector<bool>& bc0,
-    const std::vector<bool>& bc1);
-
-/// Execute kernel over cells and accumulate result in matrix
+    const std::vector<bool>& bc1,
+    const std::function<void(std::int32_t, const ScalarType*)>& cell_add
+    = nullptr,
+    const std::function<void(int, std::int32_t, const ScalarType*)>&
+        interior_facet_add
+    = nullptr);
+
+/// Compute markers for the dofs of the test (0) and trial (1) spaces
+/// of a bilinear form that have a Dirichlet boundary condition applied
+/// @param[in] a The bilinear form
+/// @param[in] bcs The boundary conditions
+/// @return Markers for the rows and columns. An array is empty if no
+///   boundary condition applies to the space.
+template <typename T>
+std::array<std::vector<bool>, 2>
+bc_markers(const Form<T>& a,
+           const std::vector<std::shared_ptr<const DirichletBC<T>>>& bcs);
+
+/// Compute y += A x, where A is the matrix of the bilinear form @p a
+/// with the rows (bc0) and columns (bc1) of Dirichlet dofs zeroed. The
+/// arrays use the local (process-wise) indexing of the test (y) and
+/// trial (x) spaces, including ghosts. Contributions to ghost entries
+/// of y are not sent to the owner.
+/// @param[in,out] y The vector to add the action to
+/// @param[in] a The bilinear form
+/// @param[in] x The vector to compute the action on
+/// @param[in] bc0 Markers for the rows with Dirichlet conditions
+/// @param[in] bc1 Markers for the columns with Dirichlet conditions
+/// @param[in] cells The cells to include for each cell integral. If
+///   empty, the integration domains of the form are used.
+/// @param[in] facets If true, facet integrals are included
+template <typename T>
+void assemble_action(
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> y, const Form<T>& a,
+    const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, 1>>& x,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::vector<std::vector<std::int32_t>>& cells = {},
+    bool facets = true);
+
+/// Add the diagonal of the matrix A of a bilinear form to a vector.
+/// The rows (bc0) and columns (bc1) of Dirichlet dofs of A are zeroed.
+/// The test and trial spaces must have the same dofmap. Contributions
+/// to ghost entries are not sent to the owner.
+/// @param[in,out] d The vector to add the diagonal to (local indexing,
+///   including ghosts)
+/// @param[in] a The bilinear form
+/// @param[in] bc0 Markers for the rows with Dirichlet conditions
+/// @param[in] bc1 Markers for the columns with Dirichlet conditions
+template <typename T>
+void assemble_diagonal(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> d,
+                       const Form<T>& a, const std::vector<bool>& bc0,
+                       const std::vector<bool>& bc1);
+
+/// Execute kernel over cells and accumulate result in matrix. If
+/// @p cell_add is set, it is used in place of @p mat_set_values (see
+/// impl::assemble_matrix). If @p cell_colors is not empty, cells of the
+/// same colour are assembled concurrently by OpenMP threads, in which
+/// case @p mat_set_values must be safe to call concurrently for cells
+/// that share no row dofs.
 template <typename ScalarType>
 void assemble_cells(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
@@ -51,9 +124,36 @@ void assemble_cells(
                              const std::uint32_t)>& kernel,
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants);
-
-/// Execute kernel over exterior facets and  accumulate result in Mat
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants,
+    const std::function<void(std::int32_t, const ScalarType*)>& cell_add,
+    const std::vector<std::int32_t>& cell_colors = {});
+
+/// Execute batched kernel over cells and accumulate result in matrix.
+/// See FormIntegrals::set_batch_tabulate_tensor for the kernel
+/// interface. The handling of @p cell_colors is the same as for
+/// assemble_cells.
+template <typename ScalarType>
+void assemble_cells_batched(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const ScalarType*)>&
+        mat_set_values,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap0,
+    const graph::AdjacencyList<std::int32_t>& dofmap1,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::function<void(ScalarType*, const ScalarType*, const ScalarType*,
+                             const double*, const std::uint32_t*, int)>&
+        kernel,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants,
+    const std::function<void(std::int32_t, const ScalarType*)>& cell_add,
+    const std::vector<std::int32_t>& cell_colors = {});
+
+/// Execute kernel over exterior facets and  accumulate result in Mat.
+/// If @p cell_add is set, it is called with the index of the cell
+/// attached to the facet and the element matrix in place of
+/// @p mat_set_values.
 template <typename ScalarType>
 void assemble_exterior_facets(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
@@ -67,9 +167,14 @@ void assemble_exterior_facets(
                              const std::uint32_t)>& fn,
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const Eigen::Array<ScalarType, Eigen::Dynamic, 1> constants);
-
-/// Execute kernel over interior facets and  accumulate result in Mat
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1> constants,
+    const std::function<void(std::int32_t, const ScalarType*)>& cell_add
+    = nullptr);
+
+/// Execute kernel over interior facets and  accumulate result in Mat.
+/// If @p facet_add is set, it is called with the position of the facet
+/// in @p active_facets and the element matrix in place of
+/// @p mat_set_values.
 template <typename ScalarType>
 void assemble_interior_facets(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
@@ -84,7 +189,9 @@ void assemble_interior_facets(
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
     const std::vector<int>& offsets,
-    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants);
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants,
+    const std::function<void(std::int32_t, const ScalarType*)>& facet_add
+    = nullptr);
 
 //-----------------------------------------------------------------------------
 template <typename ScalarType>
@@ -93,7 +200,10 @@ void assemble_matrix(
                             const std::int32_t*, const ScalarType*)>&
         mat_set_values,
     const Form<ScalarType>& a, const std::vector<bool>& bc0,
-    const std::vector<bool>& bc1)
+    const std::vector<bool>& bc1,
+    const std::function<void(std::int32_t, const ScalarType*)>& cell_add,
+    const std::function<void(int, std::int32_t, const ScalarType*)>&
+        interior_facet_add)
 {
   std::shared_ptr<const mesh::Mesh> mesh = a.mesh();
   assert(mesh);
@@ -114,18 +224,38 @@ void assemble_matrix(
 
   // Prepare coefficients
   const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
-                     Eigen::RowMajor>
-      coeffs = pack_coefficients(a);
+                     Eigen::RowMajor>& coeffs
+      = a.packed_coefficients();
 
   const FormIntegrals<ScalarType>& integrals = a.integrals();
+
+  // Colour cells by row dofs if assembly will be threaded
+  const std::vector<std::int32_t> no_colors;
+  const std::vector<std::int32_t>& cell_colors
+      = (num_assembly_threads() > 1
+         and integrals.num_integrals(IntegralType::cell) > 0)
+            ? dofmap0->cell_colors()
+            : no_colors;
+
   for (int i = 0; i < integrals.num_integrals(IntegralType::cell); ++i)
   {
-    const auto& fn = integrals.get_tabulate_tensor(IntegralType::cell, i);
     const std::vector<std::int32_t>& active_cells
         = integrals.integral_domains(IntegralType::cell, i);
-    fem::impl::assemble_cells<ScalarType>(mat_set_values, *mesh, active_cells,
-                                          dofs0, dofs1, bc0, bc1, fn, coeffs,
-                                          constants);
+    if (const auto& fn_batch
+        = integrals.get_batch_tabulate_tensor(IntegralType::cell, i);
+        fn_batch)
+    {
+      fem::impl::assemble_cells_batched<ScalarType>(
+          mat_set_values, *mesh, active_cells, dofs0, dofs1, bc0, bc1,
+          fn_batch, coeffs, constants, cell_add, cell_colors);
+    }
+    else
+    {
+      const auto& fn = integrals.get_tabulate_tensor(IntegralType::cell, i);
+      fem::impl::assemble_cells<ScalarType>(
+          mat_set_values, *mesh, active_cells, dofs0, dofs1, bc0, bc1, fn,
+          coeffs, constants, cell_add, cell_colors);
+    }
   }
 
   for (int i = 0; i < integrals.num_integrals(IntegralType::exterior_facet);
@@ -137,7 +267,7 @@ void assemble_matrix(
         = integrals.integral_domains(IntegralType::exterior_facet, i);
     fem::impl::assemble_exterior_facets<ScalarType>(
         mat_set_values, *mesh, active_facets, *dofmap0, *dofmap1, bc0, bc1, fn,
-        coeffs, constants);
+        coeffs, constants, cell_add);
   }
 
   const std::vector<int> c_offsets = a.coefficients().offsets();
@@ -148,12 +278,175 @@ void assemble_matrix(
         = integrals.get_tabulate_tensor(IntegralType::interior_facet, i);
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(IntegralType::interior_facet, i);
+    std::function<void(std::int32_t, const ScalarType*)> facet_add;
+    if (interior_facet_add)
+    {
+      facet_add = [&interior_facet_add, i](std::int32_t f,
+                                           const ScalarType* Ae) {
+        interior_facet_add(i, f, Ae);
+      };
+    }
     fem::impl::assemble_interior_facets<ScalarType>(
         mat_set_values, *mesh, active_facets, *dofmap0, *dofmap1, bc0, bc1, fn,
+        coeffs, c_offsets, constants, facet_add);
+  }
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+std::array<std::vector<bool>, 2>
+bc_markers(const Form<T>& a,
+           const std::vector<std::shared_ptr<const DirichletBC<T>>>& bcs)
+{
+  // Index maps for dof ranges
+  auto map0 = a.function_space(0)->dofmap()->index_map;
+  auto map1 = a.function_space(1)->dofmap()->index_map;
+
+  // Build dof markers
+  std::array<std::vector<bool>, 2> dof_markers;
+  std::int32_t dim0
+      = map0->block_size() * (map0->size_local() + map0->num_ghosts());
+  std::int32_t dim1
+      = map1->block_size() * (map1->size_local() + map1->num_ghosts());
+  for (std::size_t k = 0; k < bcs.size(); ++k)
+  {
+    assert(bcs[k]);
+    assert(bcs[k]->function_space());
+    if (a.function_space(0)->contains(*bcs[k]->function_space()))
+    {
+      dof_markers[0].resize(dim0, false);
+      bcs[k]->mark_dofs(dof_markers[0]);
+    }
+    if (a.function_space(1)->contains(*bcs[k]->function_space()))
+    {
+      dof_markers[1].resize(dim1, false);
+      bcs[k]->mark_dofs(dof_markers[1]);
+    }
+  }
+
+  return dof_markers;
+}
+//-----------------------------------------------------------------------------
+template <typename T>
+void assemble_action(
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> y, const Form<T>& a,
+    const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, 1>>& x,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::vector<std::vector<std::int32_t>>& cells, bool facets)
+{
+  // Multiply element matrices by x and add to y. Called concurrently
+  // only for elements that share no rows.
+  const auto mat_action
+      = [&y, &x](std::int32_t nrows, const std::int32_t* rows,
+                 std::int32_t ncols, const std::int32_t* cols, const T* Ae) {
+          for (std::int32_t i = 0; i < nrows; ++i)
+          {
+            T yi = 0;
+            for (std::int32_t j = 0; j < ncols; ++j)
+              yi += Ae[i * ncols + j] * x[cols[j]];
+            y[rows[i]] += yi;
+          }
+          return 0;
+        };
+
+  if (cells.empty() and facets)
+  {
+    impl::assemble_matrix<T>(mat_action, a, bc0, bc1);
+    return;
+  }
+
+  std::shared_ptr<const mesh::Mesh> mesh = a.mesh();
+  assert(mesh);
+  std::shared_ptr<const fem::DofMap> dofmap0 = a.function_space(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1 = a.function_space(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+
+  if (!a.all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  const Eigen::Array<T, Eigen::Dynamic, 1> constants = pack_constants(a);
+  const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      coeffs
+      = a.packed_coefficients();
+
+  const FormIntegrals<T>& integrals = a.integrals();
+  const std::vector<std::int32_t> no_colors;
+  const std::vector<std::int32_t>& cell_colors
+      = (num_assembly_threads() > 1
+         and integrals.num_integrals(IntegralType::cell) > 0)
+            ? dofmap0->cell_colors()
+            : no_colors;
+  for (int i = 0; i < integrals.num_integrals(IntegralType::cell); ++i)
+  {
+    const std::vector<std::int32_t>& active_cells
+        = cells.empty() ? integrals.integral_domains(IntegralType::cell, i)
+                        : cells[i];
+    if (const auto& fn_batch
+        = integrals.get_batch_tabulate_tensor(IntegralType::cell, i);
+        fn_batch)
+    {
+      impl::assemble_cells_batched<T>(mat_action, *mesh, active_cells,
+                                      dofmap0->list(), dofmap1->list(), bc0,
+                                      bc1, fn_batch, coeffs, constants,
+                                      nullptr, cell_colors);
+    }
+    else
+    {
+      impl::assemble_cells<T>(
+          mat_action, *mesh, active_cells, dofmap0->list(), dofmap1->list(),
+          bc0, bc1, integrals.get_tabulate_tensor(IntegralType::cell, i),
+          coeffs, constants, nullptr, cell_colors);
+    }
+  }
+
+  if (!facets)
+    return;
+
+  for (int i = 0; i < integrals.num_integrals(IntegralType::exterior_facet);
+       ++i)
+  {
+    impl::assemble_exterior_facets<T>(
+        mat_action, *mesh,
+        integrals.integral_domains(IntegralType::exterior_facet, i),
+        *dofmap0, *dofmap1, bc0, bc1,
+        integrals.get_tabulate_tensor(IntegralType::exterior_facet, i),
+        coeffs, constants);
+  }
+
+  const std::vector<int> c_offsets = a.coefficients().offsets();
+  for (int i = 0; i < integrals.num_integrals(IntegralType::interior_facet);
+       ++i)
+  {
+    impl::assemble_interior_facets<T>(
+        mat_action, *mesh,
+        integrals.integral_domains(IntegralType::interior_facet, i),
+        *dofmap0, *dofmap1, bc0, bc1,
+        integrals.get_tabulate_tensor(IntegralType::interior_facet, i),
         coeffs, c_offsets, constants);
   }
 }
 //-----------------------------------------------------------------------------
+template <typename T>
+void assemble_diagonal(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> d,
+                       const Form<T>& a, const std::vector<bool>& bc0,
+                       const std::vector<bool>& bc1)
+{
+  if (a.function_space(0)->dofmap() != a.function_space(1)->dofmap())
+    throw std::runtime_error("Test and trial spaces must have same dofmap.");
+
+  // Add diagonal entries of element matrices to d. Called concurrently
+  // only for elements that share no rows.
+  const auto mat_diagonal
+      = [&d](std::int32_t nrows, const std::int32_t* rows, std::int32_t ncols,
+             const std::int32_t* cols, const T* Ae) {
+          for (std::int32_t i = 0; i < nrows; ++i)
+            for (std::int32_t j = 0; j < ncols; ++j)
+              if (rows[i] == cols[j])
+                d[rows[i]] += Ae[i * ncols + j];
+          return 0;
+        };
+  impl::assemble_matrix<T>(mat_diagonal, a, bc0, bc1);
+}
+//-----------------------------------------------------------------------------
 template <typename ScalarType>
 void assemble_cells(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
@@ -167,7 +460,9 @@ void assemble_cells(
                              const std::uint32_t)>& kernel,
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants)
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants,
+    const std::function<void(std::int32_t, const ScalarType*)>& cell_add,
+    const std::vector<std::int32_t>& cell_colors)
 {
   const int gdim = mesh.geometry().dim();
   mesh.topology_mutable().create_entity_permutations();
@@ -180,52 +475,209 @@ void assemble_cells(
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
       = mesh.geometry().x();
 
-  // Data structures used in assembly
-  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      coordinate_dofs(num_dofs_g, gdim);
-  Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Ae;
-
   const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
       = mesh.topology().get_cell_permutation_info();
 
-  // Iterate over active cells
-  for (std::int32_t c : active_cells)
+  // Assemble cell c, using the work arrays coordinate_dofs and Ae
+  auto assemble_cell
+      = [&](std::int32_t c,
+            Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                         Eigen::RowMajor>& coordinate_dofs,
+            Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                          Eigen::RowMajor>& Ae) {
+          // Get cell coordinates/geometry
+          auto x_dofs = x_dofmap.links(c);
+          for (int i = 0; i < x_dofs.rows(); ++i)
+            coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+          auto dofs0 = dofmap0.links(c);
+          auto dofs1 = dofmap1.links(c);
+
+          // Tabulate tensor
+          auto coeff_cell = coeffs.row(c);
+          Ae.setZero(dofs0.size(), dofs1.size());
+          kernel(Ae.data(), coeff_cell.data(), constants.data(),
+                 coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+
+          // Zero rows/columns for essential bcs
+          if (!bc0.empty())
+          {
+            for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+            {
+              const std::int32_t dof = dofs0[i];
+              if (bc0[dof])
+                Ae.row(i).setZero();
+            }
+          }
+          if (!bc1.empty())
+          {
+            for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+            {
+              const std::int32_t dof = dofs1[j];
+              if (bc1[dof])
+                Ae.col(j).setZero();
+            }
+          }
+
+          if (cell_add)
+            cell_add(c, Ae.data());
+          else
+          {
+            mat_set(dofs0.size(), dofs0.data(), dofs1.size(), dofs1.data(),
+                    Ae.data());
+          }
+        };
+
+  if (cell_colors.empty())
   {
-    // Get cell coordinates/geometry
-    auto x_dofs = x_dofmap.links(c);
-    for (int i = 0; i < x_dofs.rows(); ++i)
-      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
-
-    auto dofs0 = dofmap0.links(c);
-    auto dofs1 = dofmap1.links(c);
-
-    // Tabulate tensor
-    auto coeff_cell = coeffs.row(c);
-    Ae.setZero(dofs0.size(), dofs1.size());
-    kernel(Ae.data(), coeff_cell.data(), constants.data(),
-           coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
-
-    // Zero rows/columns for essential bcs
-    if (!bc0.empty())
+    // Data structures used in assembly
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        coordinate_dofs(num_dofs_g, gdim);
+    Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        Ae;
+
+    // Iterate over active cells
+    for (std::int32_t c : active_cells)
+      assemble_cell(c, coordinate_dofs, Ae);
+  }
+  else
+  {
+    // Iterate over colours, and assemble cells of one colour
+    // concurrently. Cells of the same colour share no dofs in dofmap0.
+    const graph::AdjacencyList<std::int32_t> colored_cells
+        = group_by_color(active_cells, cell_colors);
+#pragma omp parallel
     {
-      for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+      // Data structures used in assembly (one per thread)
+      Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+          coordinate_dofs(num_dofs_g, gdim);
+      Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                    Eigen::RowMajor>
+          Ae;
+      for (std::int32_t color = 0; color < colored_cells.num_nodes(); ++color)
       {
-        const std::int32_t dof = dofs0[i];
-        if (bc0[dof])
-          Ae.row(i).setZero();
+        auto cells = colored_cells.links(color);
+#pragma omp for schedule(static)
+        for (Eigen::Index i = 0; i < cells.rows(); ++i)
+          assemble_cell(cells[i], coordinate_dofs, Ae);
       }
     }
-    if (!bc1.empty())
+  }
+}
+//-----------------------------------------------------------------------------
+template <typename ScalarType>
+void assemble_cells_batched(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const ScalarType*)>& mat_set,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap0,
+    const graph::AdjacencyList<std::int32_t>& dofmap1,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::function<void(ScalarType*, const ScalarType*, const ScalarType*,
+                             const double*, const std::uint32_t*, int)>&
+        kernel,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants,
+    const std::function<void(std::int32_t, const ScalarType*)>& cell_add,
+    const std::vector<std::int32_t>& cell_colors)
+{
+  if (active_cells.empty())
+    return;
+
+  const int gdim = mesh.geometry().dim();
+  mesh.topology_mutable().create_entity_permutations();
+
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = mesh.geometry().dofmap().num_links(0);
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  // All cells have the same number of dofs
+  const int ndofs0 = dofmap0.num_links(active_cells[0]);
+  const int ndofs1 = dofmap1.num_links(active_cells[0]);
+
+  // Group cells by colour if assembly is threaded
+  const graph::AdjacencyList<std::int32_t> groups
+      = cell_colors.empty()
+            ? graph::AdjacencyList<std::int32_t>(
+                active_cells, std::vector<std::int32_t>(
+                                  {0, (std::int32_t)active_cells.size()}))
+            : group_by_color(active_cells, cell_colors);
+
+#pragma omp parallel if (!cell_colors.empty())
+  {
+    // Data structures used in assembly (one per thread)
+    Eigen::Array<double, Eigen::Dynamic, 1> coordinate_dofs(
+        num_dofs_g * gdim * cell_batch_size);
+    Eigen::Array<ScalarType, Eigen::Dynamic, 1> coeff_batch(coeffs.cols()
+                                                            * cell_batch_size);
+    Eigen::Array<std::uint32_t, Eigen::Dynamic, 1> info_batch(
+        cell_batch_size);
+    Eigen::Array<ScalarType, Eigen::Dynamic, 1> Ab(ndofs0 * ndofs1
+                                                   * cell_batch_size);
+    Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        Ae(ndofs0, ndofs1);
+
+    for (std::int32_t g = 0; g < groups.num_nodes(); ++g)
     {
-      for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+      auto cells = groups.links(g);
+      const std::int32_t num_batches
+          = (cells.rows() + cell_batch_size - 1) / cell_batch_size;
+#pragma omp for schedule(static)
+      for (std::int32_t b = 0; b < num_batches; ++b)
       {
-        const std::int32_t dof = dofs1[j];
-        if (bc1[dof])
-          Ae.col(j).setZero();
+        const std::int32_t* batch_cells = cells.data() + b * cell_batch_size;
+        const int n = std::min<std::int32_t>(cell_batch_size,
+                                             cells.rows() - b * cell_batch_size);
+
+        // Pack batch and tabulate tensors
+        pack_cell_batch(coordinate_dofs.data(), coeff_batch.data(),
+                        info_batch.data(), batch_cells, n, mesh.geometry(),
+                        coeffs, cell_info);
+        Ab.head(ndofs0 * ndofs1 * n).setZero();
+        kernel(Ab.data(), coeff_batch.data(), constants.data(),
+               coordinate_dofs.data(), info_batch.data(), n);
+
+        for (int q = 0; q < n; ++q)
+        {
+          const std::int32_t c = batch_cells[q];
+          auto dofs0 = dofmap0.links(c);
+          auto dofs1 = dofmap1.links(c);
+
+          // Unpack tensor for cell q
+          for (int k = 0; k < ndofs0 * ndofs1; ++k)
+            Ae.data()[k] = Ab[k * n + q];
+
+          // Zero rows/columns for essential bcs
+          if (!bc0.empty())
+          {
+            for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+            {
+              if (bc0[dofs0[i]])
+                Ae.row(i).setZero();
+            }
+          }
+          if (!bc1.empty())
+          {
+            for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+            {
+              if (bc1[dofs1[j]])
+                Ae.col(j).setZero();
+            }
+          }
+
+          if (cell_add)
+            cell_add(c, Ae.data());
+          else
+          {
+            mat_set(dofs0.size(), dofs0.data(), dofs1.size(), dofs1.data(),
+                    Ae.data());
+          }
+        }
       }
     }
-
-    mat_set(dofs0.size(), dofs0.data(), dofs1.size(), dofs1.data(), Ae.data());
   }
 }
 //-----------------------------------------------------------------------------
@@ -242,7 +694,8 @@ void assemble_exterior_facets(
                              const std::uint32_t)>& kernel,
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
-    const Eigen::Array<ScalarType, Eigen::Dynamic, 1> constants)
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1> constants,
+    const std::function<void(std::int32_t, const ScalarType*)>& cell_add)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
@@ -320,8 +773,13 @@ void assemble_exterior_facets(
       }
     }
 
-    mat_set_values(dmap0.size(), dmap0.data(), dmap1.size(), dmap1.data(),
-                   Ae.data());
+    if (cell_add)
+      cell_add(cells[0], Ae.data());
+    else
+    {
+      mat_set_values(dmap0.size(), dmap0.data(), dmap1.size(), dmap1.data(),
+                     Ae.data());
+    }
   }
 }
 //-----------------------------------------------------------------------------
@@ -339,7 +797,8 @@ void assemble_interior_facets(
     const Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic,
                        Eigen::RowMajor>& coeffs,
     const std::vector<int>& offsets,
-    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants)
+    const Eigen::Array<ScalarType, Eigen::Dynamic, 1>& constants,
+    const std::function<void(std::int32_t, const ScalarType*)>& facet_add)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
@@ -378,8 +837,10 @@ void assemble_interior_facets(
   assert(c);
   auto c_to_f = mesh.topology().connectivity(tdim, tdim - 1);
   assert(c_to_f);
-  for (std::int32_t facet_index : active_facets)
+  for (std::size_t index = 0; index < active_facets.size(); ++index)
   {
+    const std::int32_t facet_index = active_facets[index];
+
     // Create attached cells
     auto cells = c->links(facet_index);
     assert(cells.rows() == 2);
@@ -461,8 +922,13 @@ void assemble_interior_facets(
       }
     }
 
-    mat_set_values(dmapjoint0.size(), dmapjoint0.data(), dmapjoint1.size(),
-                   dmapjoint1.data(), Ae.data());
+    if (facet_add)
+      facet_add(index, Ae.data());
+    else
+    {
+      mat_set_values(dmapjoint0.size(), dmapjoint0.data(), dmapjoint1.size(),
+                     dmapjoint1.data(), Ae.data());
+    }
   }
 }
 //-----------------------------------------------------------------------------
@@ -36,6 +36,17 @@ T assemble_cells(
         coeffs,
     const std::vector<T>& constant_values);
 
+/// Assemble functional over cells using a batched kernel. See
+/// FormIntegrals::set_batch_tabulate_tensor for the kernel interface.
+template <typename T>
+T assemble_cells_batched(
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const std::function<void(T*, const T*, const T*, const double*,
+                             const std::uint32_t*, int)>& fn,
+    const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+        coeffs,
+    const std::vector<T>& constant_values);
+
 /// Execute kernel over exterior facets and accumulate result
 template <typename T>
 T assemble_exterior_facets(
@@ -78,18 +89,28 @@ T assemble_scalar(const fem::Form<T>& M)
   }
 
   // Prepare coefficients
-  const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> coeffs
-      = pack_coefficients(M);
+  const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      coeffs = M.packed_coefficients();
 
   const FormIntegrals<T>& integrals = M.integrals();
   T value(0);
   for (int i = 0; i < integrals.num_integrals(IntegralType::cell); ++i)
   {
-    const auto& fn = integrals.get_tabulate_tensor(IntegralType::cell, i);
     const std::vector<std::int32_t>& active_cells
         = integrals.integral_domains(IntegralType::cell, i);
-    value += fem::impl::assemble_cells(*mesh, active_cells, fn, coeffs,
-                                       constant_values);
+    if (const auto& fn_batch
+        = integrals.get_batch_tabulate_tensor(IntegralType::cell, i);
+        fn_batch)
+    {
+      value += fem::impl::assemble_cells_batched(*mesh, active_cells, fn_batch,
+                                                 coeffs, constant_values);
+    }
+    else
+    {
+      const auto& fn = integrals.get_tabulate_tensor(IntegralType::cell, i);
+      value += fem::impl::assemble_cells(*mesh, active_cells, fn, coeffs,
+                                         constant_values);
+    }
   }
 
   for (int i = 0; i < integrals.num_integrals(IntegralType::exterior_facet);
@@ -165,6 +186,53 @@ T assemble_cells(
 }
 //-----------------------------------------------------------------------------
 template <typename T>
+T assemble_cells_batched(
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const std::function<void(T*, const T*, const T*, const double*,
+                             const std::uint32_t*, int)>& fn,
+    const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+        coeffs,
+    const std::vector<T>& constant_values)
+{
+  const int gdim = mesh.geometry().dim();
+  const int tdim = mesh.topology().dim();
+  mesh.topology_mutable().create_entities(tdim);
+  mesh.topology_mutable().create_entity_permutations();
+
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = mesh.geometry().dofmap().num_links(0);
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  // Create data structures used in assembly
+  Eigen::Array<double, Eigen::Dynamic, 1> coordinate_dofs(num_dofs_g * gdim
+                                                          * cell_batch_size);
+  Eigen::Array<T, Eigen::Dynamic, 1> coeff_batch(coeffs.cols()
+                                                 * cell_batch_size);
+  Eigen::Array<std::uint32_t, Eigen::Dynamic, 1> info_batch(cell_batch_size);
+  Eigen::Array<T, Eigen::Dynamic, 1> values(cell_batch_size);
+
+  // Iterate over all cells in batches
+  T value(0);
+  const std::int32_t num_cells = active_cells.size();
+  for (std::int32_t c0 = 0; c0 < num_cells; c0 += cell_batch_size)
+  {
+    const std::int32_t* batch_cells = active_cells.data() + c0;
+    const int n = std::min<std::int32_t>(cell_batch_size, num_cells - c0);
+    pack_cell_batch(coordinate_dofs.data(), coeff_batch.data(),
+                    info_batch.data(), batch_cells, n, mesh.geometry(), coeffs,
+                    cell_info);
+    values.head(n).setZero();
+    fn(values.data(), coeff_batch.data(), constant_values.data(),
+       coordinate_dofs.data(), info_batch.data(), n);
+    value += values.head(n).sum();
+  }
+
+  return value;
+}
+//-----------------------------------------------------------------------------
+template <typename T>
 T assemble_exterior_facets(
     const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_facets,
     const std::function<void(T*, const T*, const T*, const double*, const int*,
@@ -32,9 +32,14 @@ namespace dolfinx::fem::impl
 /// @param[in,out] b The vector to be assembled. It will not be zeroed before
 ///   assembly.
 /// @param[in] L The linear forms to assemble into b
+/// @param[in] cells The cells to include for each cell integral. If
+///   empty, the integration domains of the form are used.
+/// @param[in] facets If true, facet integrals are included
 template <typename T>
 void assemble_vector(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> b,
-                     const Form<T>& L);
+                     const Form<T>& L,
+                     const std::vector<std::vector<std::int32_t>>& cells = {},
+                     bool facets = true);
 
 /// Execute kernel over cells and accumulate result in vector
 template <typename T>
@@ -48,6 +53,20 @@ void assemble_cells(
         coeffs,
     const Eigen::Array<T, Eigen::Dynamic, 1>& constant_values);
 
+/// Execute batched kernel over cells and accumulate result in
+/// vector. See FormIntegrals::set_batch_tabulate_tensor for the kernel
+/// interface.
+template <typename T>
+void assemble_cells_batched(
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> b, const mesh::Mesh& mesh,
+    const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap,
+    const std::function<void(T*, const T*, const T*, const double*,
+                             const std::uint32_t*, int)>& kernel,
+    const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+        coeffs,
+    const Eigen::Array<T, Eigen::Dynamic, 1>& constant_values);
+
 /// Execute kernel over cells and accumulate result in vector
 template <typename T>
 void assemble_exterior_facets(
@@ -159,8 +178,8 @@ void _lift_bc_cells(
   assert(dofmap1);
 
   // Prepare coefficients
-  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> coeffs
-      = pack_coefficients(a);
+  const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      coeffs = a.packed_coefficients();
 
   const std::function<void(T*, const T*, const T*, const double*, const int*,
                            const std::uint8_t*, const std::uint32_t)>& fn
@@ -281,8 +300,8 @@ void _lift_bc_exterior_facets(
   assert(dofmap1);
 
   // Prepare coefficients
-  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> coeffs
-      = pack_coefficients(a);
+  const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      coeffs = a.packed_coefficients();
 
   const std::function<void(T*, const T*, const T*, const double*, const int*,
                            const std::uint8_t*, const std::uint32_t)>& fn
@@ -407,7 +426,9 @@ void _lift_bc_exterior_facets(
 //-----------------------------------------------------------------------------
 template <typename T>
 void assemble_vector(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> b,
-                     const Form<T>& L)
+                     const Form<T>& L,
+                     const std::vector<std::vector<std::int32_t>>& cells,
+                     bool facets)
 {
   std::shared_ptr<const mesh::Mesh> mesh = L.mesh();
   assert(mesh);
@@ -424,19 +445,33 @@ void assemble_vector(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> b,
   const Eigen::Array<T, Eigen::Dynamic, 1> constant_values = pack_constants(L);
 
   // Prepare coefficients
-  const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> coeffs
-      = pack_coefficients(L);
+  const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      coeffs = L.packed_coefficients();
 
   const FormIntegrals<T>& integrals = L.integrals();
   for (int i = 0; i < integrals.num_integrals(IntegralType::cell); ++i)
   {
-    const auto& fn = integrals.get_tabulate_tensor(IntegralType::cell, i);
     const std::vector<std::int32_t>& active_cells
-        = integrals.integral_domains(IntegralType::cell, i);
-    fem::impl::assemble_cells(b, *mesh, active_cells, dofs, fn, coeffs,
-                              constant_values);
+        = cells.empty() ? integrals.integral_domains(IntegralType::cell, i)
+                        : cells[i];
+    if (const auto& fn_batch
+        = integrals.get_batch_tabulate_tensor(IntegralType::cell, i);
+        fn_batch)
+    {
+      fem::impl::assemble_cells_batched(b, *mesh, active_cells, dofs,
+                                        fn_batch, coeffs, constant_values);
+    }
+    else
+    {
+      const auto& fn = integrals.get_tabulate_tensor(IntegralType::cell, i);
+      fem::impl::assemble_cells(b, *mesh, active_cells, dofs, fn, coeffs,
+                                constant_values);
+    }
   }
 
+  if (!facets)
+    return;
+
   for (int i = 0; i < integrals.num_integrals(IntegralType::exterior_facet);
        ++i)
   {
@@ -514,6 +549,65 @@ void assemble_cells(
 }
 //-----------------------------------------------------------------------------
 template <typename T>
+void assemble_cells_batched(
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> b, const mesh::Mesh& mesh,
+    const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap,
+    const std::function<void(T*, const T*, const T*, const double*,
+                             const std::uint32_t*, int)>& kernel,
+    const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+        coeffs,
+    const Eigen::Array<T, Eigen::Dynamic, 1>& constant_values)
+{
+  if (active_cells.empty())
+    return;
+
+  const int gdim = mesh.geometry().dim();
+  mesh.topology_mutable().create_entity_permutations();
+
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = mesh.geometry().dofmap().num_links(0);
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  // All cells have the same number of dofs
+  const int ndofs = dofmap.num_links(active_cells[0]);
+
+  // Create data structures used in assembly
+  Eigen::Array<double, Eigen::Dynamic, 1> coordinate_dofs(num_dofs_g * gdim
+                                                          * cell_batch_size);
+  Eigen::Array<T, Eigen::Dynamic, 1> coeff_batch(coeffs.cols()
+                                                 * cell_batch_size);
+  Eigen::Array<std::uint32_t, Eigen::Dynamic, 1> info_batch(cell_batch_size);
+  Eigen::Array<T, Eigen::Dynamic, 1> bb(ndofs * cell_batch_size);
+
+  // Iterate over active cells in batches
+  const std::int32_t num_cells = active_cells.size();
+  for (std::int32_t c0 = 0; c0 < num_cells; c0 += cell_batch_size)
+  {
+    const std::int32_t* batch_cells = active_cells.data() + c0;
+    const int n = std::min<std::int32_t>(cell_batch_size, num_cells - c0);
+
+    // Pack batch and tabulate vectors
+    pack_cell_batch(coordinate_dofs.data(), coeff_batch.data(),
+                    info_batch.data(), batch_cells, n, mesh.geometry(), coeffs,
+                    cell_info);
+    bb.head(ndofs * n).setZero();
+    kernel(bb.data(), coeff_batch.data(), constant_values.data(),
+           coordinate_dofs.data(), info_batch.data(), n);
+
+    // Scatter cell vectors to 'global' vector array
+    for (int q = 0; q < n; ++q)
+    {
+      auto dofs = dofmap.links(batch_cells[q]);
+      for (Eigen::Index i = 0; i < dofs.size(); ++i)
+        b[dofs[i]] += bb[i * n + q];
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+template <typename T>
 void assemble_exterior_facets(
     Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> b, const mesh::Mesh& mesh,
     const std::vector<std::int32_t>& active_facets, const fem::DofMap& dofmap,
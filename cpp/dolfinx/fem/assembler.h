@@ -6,11 +6,15 @@
 
 #pragma once
 
+#include "AssemblyPlan.h"
+#include "assemble_fused_impl.h"
 #include "assemble_matrix_impl.h"
 #include "assemble_scalar_impl.h"
 #include "assemble_vector_impl.h"
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/Vector.h>
 #include <memory>
 #include <vector>
 
@@ -54,6 +58,39 @@ void assemble_vector(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> b,
   fem::impl::assemble_vector(b, L);
 }
 
+/// Assemble linear form into a distributed vector and accumulate the
+/// ghost contributions on the owning processes. The cells with ghost
+/// dofs are assembled first, and the communication of their
+/// contributions is overlapped with the assembly of the remaining
+/// cells (see fem::split_cells_by_ownership).
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+///   before assembly. On return, the ghost entries hold the
+///   contributions that have been sent to the owners.
+/// @param[in] L The linear form to assemble into b
+template <typename T>
+void assemble_vector(la::Vector<T>& b, const Form<T>& L)
+{
+  // Split cells of each cell integral by ownership of their dofs
+  const FormIntegrals<T>& integrals = L.integrals();
+  const fem::DofMap& dofmap = *L.function_space(0)->dofmap();
+  std::vector<std::vector<std::int32_t>> owned_cells, ghost_cells;
+  for (int i = 0; i < integrals.num_integrals(IntegralType::cell); ++i)
+  {
+    auto [owned, ghost] = fem::split_cells_by_ownership(
+        integrals.integral_domains(IntegralType::cell, i), dofmap);
+    owned_cells.push_back(std::move(owned));
+    ghost_cells.push_back(std::move(ghost));
+  }
+
+  // Assemble contributions to ghost entries and start sending them to
+  // the owners, then assemble the cells with only owned dofs
+  Eigen::Matrix<T, Eigen::Dynamic, 1>& _b = b.array();
+  fem::impl::assemble_vector<T>(_b, L, ghost_cells, true);
+  b.scatter_rev_begin();
+  fem::impl::assemble_vector<T>(_b, L, owned_cells, false);
+  b.scatter_rev_end(common::IndexMap::Mode::add);
+}
+
 // FIXME: clarify how x0 is used
 // FIXME: if bcs entries are set
 
@@ -92,6 +129,10 @@ void apply_lifting(
 /// @param[in] a The bilinear from to assemble
 /// @param[in] bcs Boundary conditions to apply. For boundary condition
 ///  dofs the row and column are zeroed. The diagonal  entry is not set.
+/// @note If assembly is threaded (see fem::num_assembly_threads),
+/// @p mat_add is called concurrently from several threads for element
+/// matrices that share no rows. It must be thread-safe for disjoint
+/// rows, or serialise the insertion (as la::PETScMatrix::add_fn does).
 template <typename T>
 void assemble_matrix(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
@@ -99,35 +140,70 @@ void assemble_matrix(
     const Form<T>& a,
     const std::vector<std::shared_ptr<const DirichletBC<T>>>& bcs)
 {
+  const auto [dof_marker0, dof_marker1] = impl::bc_markers(a, bcs);
+  impl::assemble_matrix(mat_add, a, dof_marker0, dof_marker1);
+}
 
-  // Index maps for dof ranges
-  auto map0 = a.function_space(0)->dofmap()->index_map;
-  auto map1 = a.function_space(1)->dofmap()->index_map;
+/// Assemble bilinear form into a la::MatrixCSR. Element matrices of
+/// cell and exterior facet integrals are added using precomputed
+/// positions in the matrix value array (see
+/// la::MatrixCSR::block_positions). The positions are cached by the
+/// matrix for the function spaces of the form, so repeated assembly of
+/// forms on the same spaces into @p A does not recompute them. Does not
+/// zero or finalise the matrix.
+/// @param[in,out] A The matrix to assemble into. Its sparsity pattern
+///   must contain the entries of the form.
+/// @param[in] a The bilinear from to assemble
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+///  dofs the row and column are zeroed. The diagonal  entry is not set.
+template <typename T>
+void assemble_matrix(
+    la::MatrixCSR<T>& A, const Form<T>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<T>>>& bcs)
+{
+  const auto [dof_marker0, dof_marker1] = impl::bc_markers(a, bcs);
 
-  // Build dof markers
-  std::vector<bool> dof_marker0, dof_marker1;
-  std::int32_t dim0
-      = map0->block_size() * (map0->size_local() + map0->num_ghosts());
-  std::int32_t dim1
-      = map1->block_size() * (map1->size_local() + map1->num_ghosts());
-  for (std::size_t k = 0; k < bcs.size(); ++k)
+  std::function<void(std::int32_t, const T*)> cell_add;
+  const FormIntegrals<T>& integrals = a.integrals();
+  if (integrals.num_integrals(IntegralType::cell) > 0
+      or integrals.num_integrals(IntegralType::exterior_facet) > 0)
   {
-    assert(bcs[k]);
-    assert(bcs[k]->function_space());
-    if (a.function_space(0)->contains(*bcs[k]->function_space()))
-    {
-      dof_marker0.resize(dim0, false);
-      bcs[k]->mark_dofs(dof_marker0);
-    }
-    if (a.function_space(1)->contains(*bcs[k]->function_space()))
-    {
-      dof_marker1.resize(dim1, false);
-      bcs[k]->mark_dofs(dof_marker1);
-    }
+    // Positions are cached by the matrix for the function spaces
+    const graph::AdjacencyList<std::int32_t>& positions = A.block_positions(
+        {a.function_space(0)->id(), a.function_space(1)->id()},
+        a.function_space(0)->dofmap()->list(),
+        a.function_space(1)->dofmap()->list());
+    std::vector<T>& values = A.values();
+    cell_add = [&positions, &values](std::int32_t c, const T* Ae) {
+      auto pos = positions.links(c);
+      for (Eigen::Index k = 0; k < pos.rows(); ++k)
+        values[pos[k]] += Ae[k];
+    };
   }
 
-  // Assemble
-  impl::assemble_matrix(mat_add, a, dof_marker0, dof_marker1);
+  impl::assemble_matrix<T>(A.mat_add_values(), a, dof_marker0, dof_marker1,
+                           cell_add);
+}
+
+/// Assemble bilinear form into the matrix of an assembly plan (see
+/// fem::AssemblyPlan). Element matrices are added at the positions
+/// precomputed by the plan. Does not zero or finalise the matrix.
+/// @param[in,out] plan The assembly plan
+/// @param[in] a The bilinear from to assemble. It must be compatible
+///   with the plan (see AssemblyPlan::compatible).
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+///  dofs the row and column are zeroed. The diagonal  entry is not set.
+template <typename T>
+void assemble_matrix(
+    AssemblyPlan<T>& plan, const Form<T>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<T>>>& bcs)
+{
+  if (!plan.compatible(a))
+    throw std::runtime_error("Form is not compatible with assembly plan");
+  const auto [dof_marker0, dof_marker1] = impl::bc_markers(a, bcs);
+  impl::assemble_matrix<T>(plan.matrix().mat_add_values(), a, dof_marker0,
+                           dof_marker1, plan.cell_add(),
+                           plan.interior_facet_add());
 }
 
 /// Assemble bilinear form into a matrix. Matrix must already be
@@ -140,6 +216,10 @@ void assemble_matrix(
 /// @param[in] dof_marker1 Boundary condition markers for the columns.
 ///   If bc[i] is true then rows i in A will be zeroed. The index i is a
 ///   local index.
+/// @note If assembly is threaded (see fem::num_assembly_threads),
+/// @p mat_add is called concurrently from several threads for element
+/// matrices that share no rows. It must be thread-safe for disjoint
+/// rows, or serialise the insertion (as la::PETScMatrix::add_fn does).
 template <typename T>
 void assemble_matrix(
     const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
@@ -167,6 +247,7 @@ Eigen::SparseMatrix<T, Eigen::RowMajor> assemble_matrix_eigen(
   const auto mat_add
       = [&triplets](std::int32_t nrow, const std::int32_t* rows,
                     std::int32_t ncol, const std::int32_t* cols, const T* v) {
+#pragma omp critical(dolfinx_eigen_mat_set)
           for (int i = 0; i < nrow; ++i)
             for (int j = 0; j < ncol; ++j)
               triplets.emplace_back(rows[i], cols[j], v[i * ncol + j]);
@@ -240,6 +321,88 @@ void add_diagonal(
   }
 }
 
+// -- Fused assembly ----------------------------------------------------------
+
+/// Assemble bilinear forms into matrices and linear forms into vectors
+/// in a single pass over the cells, e.g. the Jacobian and residual in a
+/// Newton step (see nls::NonlinearProblem::form). For each cell, the
+/// cell geometry is gathered once and all cell kernels with the same
+/// integration domain are executed on it. The result is the same as
+/// calling assemble_matrix and assemble_vector for each form. All
+/// forms must be defined on the same mesh.
+/// @param[in] mat_add Functions that add element matrices to the
+///   matrix of each bilinear form
+/// @param[in] a The bilinear forms
+/// @param[in,out] b The vector for each linear form, using the local
+///   (process-wise) indexing. They are not zeroed before assembly.
+/// @param[in] L The linear forms
+/// @param[in] bcs Boundary conditions to apply to the bilinear forms.
+///   For boundary condition dofs the row and column are zeroed. The
+///   diagonal entry is not set.
+/// @note If assembly is threaded (see fem::num_assembly_threads), the
+/// functions @p mat_add are called concurrently from several threads
+/// for element matrices that share no rows. They must be thread-safe
+/// for disjoint rows, or serialise the insertion (as
+/// la::PETScMatrix::add_fn does).
+template <typename T>
+void assemble_fused(
+    const std::vector<std::function<int(std::int32_t, const std::int32_t*,
+                                        std::int32_t, const std::int32_t*,
+                                        const T*)>>& mat_add,
+    const std::vector<const Form<T>*>& a,
+    std::vector<Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>>> b,
+    const std::vector<const Form<T>*>& L,
+    const std::vector<std::shared_ptr<const DirichletBC<T>>>& bcs)
+{
+  std::vector<std::array<std::vector<bool>, 2>> dof_markers;
+  for (const Form<T>* form : a)
+  {
+    assert(form);
+    dof_markers.push_back(impl::bc_markers(*form, bcs));
+  }
+  impl::assemble_fused<T>(mat_add, a, dof_markers, b, L);
+}
+
+// -- Matrix-free operators ---------------------------------------------------
+
+/// Compute the action y += A x of a bilinear form without assembling
+/// the matrix. The arrays use the local (process-wise) indexing,
+/// including ghosts. The ghost entries of x must be up-to-date, and
+/// contributions to ghost entries of y are not sent to the owner.
+/// @param[in,out] y The vector to add the action to
+/// @param[in] a The bilinear from
+/// @param[in] x The vector to compute the action on
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+///  dofs the row and column of A are zeroed. The diagonal  entry is not
+///  set.
+template <typename T>
+void assemble_action(
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> y, const Form<T>& a,
+    const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, 1>>& x,
+    const std::vector<std::shared_ptr<const DirichletBC<T>>>& bcs)
+{
+  const auto [dof_marker0, dof_marker1] = impl::bc_markers(a, bcs);
+  impl::assemble_action<T>(y, a, x, dof_marker0, dof_marker1);
+}
+
+/// Add the diagonal of the matrix of a bilinear form to a vector, e.g.
+/// for Jacobi preconditioning of a matrix-free operator. The test and
+/// trial spaces must have the same dofmap. Contributions to ghost
+/// entries are not sent to the owner.
+/// @param[in,out] d The vector to add the diagonal to (local indexing,
+///   including ghosts)
+/// @param[in] a The bilinear from
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+///  dofs the row and column are zeroed. The diagonal  entry is not set.
+template <typename T>
+void assemble_diagonal(
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> d, const Form<T>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<T>>>& bcs)
+{
+  const auto [dof_marker0, dof_marker1] = impl::bc_markers(a, bcs);
+  impl::assemble_diagonal<T>(d, a, dof_marker0, dof_marker1);
+}
+
 // -- Setting bcs ------------------------------------------------------------
 
 // FIXME: Move these function elsewhere?
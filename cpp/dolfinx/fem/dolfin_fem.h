@@ -11,6 +11,7 @@ namespace dolfinx
 
 // DOLFINX fem interface
 
+#include <dolfinx/fem/AssemblyPlan.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/DirichletBC.h>
 #include <dolfinx/fem/DiscreteOperators.h>
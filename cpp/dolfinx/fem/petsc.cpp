@@ -5,17 +5,244 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "petsc.h"
+#include "AssemblyPlan.h"
 #include "SparsityPatternBuilder.h"
 #include "assembler.h"
+#include <dolfinx/la/MatrixCSR.h>
 #include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/utils.h>
 
 using namespace dolfinx;
 
+namespace
+{
+// Data for a matrix-free operator (MatShell context)
+struct MatrixFreeOperator
+{
+  // Bilinear form and Dirichlet dof markers for rows and columns
+  std::shared_ptr<const fem::Form<PetscScalar>> a;
+  std::array<std::vector<bool>, 2> bc_markers;
+
+  // Owned rows with a Dirichlet condition, and value on the diagonal
+  std::vector<std::int32_t> bc_rows;
+  PetscScalar diagonal;
+
+  // For each cell integral, the cells with only owned column dofs and
+  // the remaining cells
+  std::vector<std::vector<std::int32_t>> owned_cells, ghost_cells;
+
+  // Ghosted work vectors for x and y
+  la::PETScVector x, y;
+};
+//-----------------------------------------------------------------------------
+// Copy owned entries of y, with the ghost contributions accumulated, to
+// z and set the diagonal of the Dirichlet rows (times x)
+void finalise_operator_vector(MatrixFreeOperator& op, Vec z, Vec x)
+{
+  Vec y = op.y.vec();
+  VecGhostUpdateBegin(y, ADD_VALUES, SCATTER_REVERSE);
+  VecGhostUpdateEnd(y, ADD_VALUES, SCATTER_REVERSE);
+  VecCopy(y, z);
+
+  PetscScalar* _z = nullptr;
+  VecGetArray(z, &_z);
+  const PetscScalar* _x = nullptr;
+  if (x)
+    VecGetArrayRead(x, &_x);
+  for (std::int32_t row : op.bc_rows)
+    _z[row] = x ? op.diagonal * _x[row] : op.diagonal;
+  if (x)
+    VecRestoreArrayRead(x, &_x);
+  VecRestoreArray(z, &_z);
+}
+//-----------------------------------------------------------------------------
+// Compute y = A x (MATOP_MULT)
+PetscErrorCode matrix_free_mult(Mat A, Vec x, Vec y)
+{
+  void* ctx = nullptr;
+  MatShellGetContext(A, &ctx);
+  assert(ctx);
+  MatrixFreeOperator& op = *static_cast<MatrixFreeOperator*>(ctx);
+
+  // Start update of ghost values of x
+  Vec x_g = op.x.vec();
+  VecCopy(x, x_g);
+  VecGhostUpdateBegin(x_g, INSERT_VALUES, SCATTER_FORWARD);
+
+  Vec x_local, y_local;
+  VecGhostGetLocalForm(x_g, &x_local);
+  VecGhostGetLocalForm(op.y.vec(), &y_local);
+  VecSet(y_local, 0.0);
+  PetscInt nx = 0, ny = 0;
+  VecGetSize(x_local, &nx);
+  VecGetSize(y_local, &ny);
+  PetscScalar* _x = nullptr;
+  PetscScalar* _y = nullptr;
+  VecGetArray(x_local, &_x);
+  VecGetArray(y_local, &_y);
+  Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> xe(_x, nx);
+  Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> ye(_y, ny);
+
+  // Compute contribution of cells with owned column dofs only, then
+  // complete ghost update and compute the remaining contributions
+  const auto& [bc0, bc1] = op.bc_markers;
+  fem::impl::assemble_action<PetscScalar>(ye, *op.a, xe, bc0, bc1,
+                                          op.owned_cells, false);
+  VecGhostUpdateEnd(x_g, INSERT_VALUES, SCATTER_FORWARD);
+  fem::impl::assemble_action<PetscScalar>(ye, *op.a, xe, bc0, bc1,
+                                          op.ghost_cells, true);
+
+  VecRestoreArray(y_local, &_y);
+  VecRestoreArray(x_local, &_x);
+  VecGhostRestoreLocalForm(op.y.vec(), &y_local);
+  VecGhostRestoreLocalForm(x_g, &x_local);
+
+  finalise_operator_vector(op, y, x);
+  return 0;
+}
+//-----------------------------------------------------------------------------
+// Compute the diagonal of A (MATOP_GET_DIAGONAL)
+PetscErrorCode matrix_free_get_diagonal(Mat A, Vec d)
+{
+  void* ctx = nullptr;
+  MatShellGetContext(A, &ctx);
+  assert(ctx);
+  MatrixFreeOperator& op = *static_cast<MatrixFreeOperator*>(ctx);
+
+  Vec y_local;
+  VecGhostGetLocalForm(op.y.vec(), &y_local);
+  VecSet(y_local, 0.0);
+  PetscInt n = 0;
+  VecGetSize(y_local, &n);
+  PetscScalar* _y = nullptr;
+  VecGetArray(y_local, &_y);
+  Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> ye(_y, n);
+  const auto& [bc0, bc1] = op.bc_markers;
+  fem::impl::assemble_diagonal<PetscScalar>(ye, *op.a, bc0, bc1);
+  VecRestoreArray(y_local, &_y);
+  VecGhostRestoreLocalForm(op.y.vec(), &y_local);
+
+  finalise_operator_vector(op, d, nullptr);
+  return 0;
+}
+//-----------------------------------------------------------------------------
+// Destroy operator data (MATOP_DESTROY)
+PetscErrorCode matrix_free_destroy(Mat A)
+{
+  void* ctx = nullptr;
+  MatShellGetContext(A, &ctx);
+  delete static_cast<MatrixFreeOperator*>(ctx);
+  return 0;
+}
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// Get the diagonal and off-diagonal (nullptr in serial) blocks of an
+// assembled AIJ matrix, and the global column of each column of the
+// off-diagonal block. Returns false if A is not an assembled AIJ
+// matrix.
+bool aij_blocks(Mat A, Mat& Ad, Mat& Ao, const PetscInt*& colmap)
+{
+  PetscBool assembled = PETSC_FALSE;
+  MatAssembled(A, &assembled);
+  if (!assembled)
+    return false;
+
+  PetscBool is_mpiaij = PETSC_FALSE, is_seqaij = PETSC_FALSE;
+  PetscObjectTypeCompare((PetscObject)A, MATMPIAIJ, &is_mpiaij);
+  PetscObjectTypeCompare((PetscObject)A, MATSEQAIJ, &is_seqaij);
+  if (is_mpiaij)
+  {
+    PetscErrorCode ierr = MatMPIAIJGetSeqAIJ(A, &Ad, &Ao, &colmap);
+    if (ierr != 0)
+      la::petsc_error(ierr, __FILE__, "MatMPIAIJGetSeqAIJ");
+    return true;
+  }
+  else if (is_seqaij)
+  {
+    Ad = A;
+    Ao = nullptr;
+    colmap = nullptr;
+    return true;
+  }
+  else
+    return false;
+}
+//-----------------------------------------------------------------------------
+// Check that the nonzero pattern of the owned rows of the plan matrix
+// is the same as the pattern of the AIJ blocks Ad and Ao
+bool same_pattern(const fem::AssemblyPlan<PetscScalar>& plan, Mat Ad, Mat Ao,
+                  const PetscInt* colmap)
+{
+  const la::MatrixCSR<PetscScalar>& csr = plan.matrix();
+  const std::vector<std::int32_t>& row_ptr = csr.row_ptr();
+  const std::vector<std::int32_t>& cols = csr.cols();
+  const std::vector<std::int64_t>& ghost_cols = csr.ghost_cols();
+  const std::vector<std::int32_t>& pos = plan.block_row_positions();
+  const std::vector<std::int32_t>& num_diagonal = plan.num_diagonal();
+  const common::IndexMap& map1 = *csr.index_maps()[1];
+  const std::int32_t local_size1 = map1.block_size() * map1.size_local();
+  const std::int32_t num_rows = csr.num_owned_rows();
+
+  PetscInt nd(0), no(0);
+  const PetscInt *ia_d(nullptr), *ja_d(nullptr);
+  const PetscInt *ia_o(nullptr), *ja_o(nullptr);
+  PetscBool done_d = PETSC_FALSE, done_o = PETSC_FALSE;
+  MatGetRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, &nd, &ia_d, &ja_d, &done_d);
+  if (Ao)
+    MatGetRowIJ(Ao, 0, PETSC_FALSE, PETSC_FALSE, &no, &ia_o, &ja_o, &done_o);
+
+  bool same = done_d and nd == num_rows
+              and (!Ao or (done_o and no == num_rows));
+  for (std::int32_t r = 0; same and r < num_rows; ++r)
+  {
+    // Diagonal block: the same local columns in the same order
+    const std::int32_t n_d = num_diagonal[r];
+    if (ia_d[r + 1] - ia_d[r] != n_d)
+    {
+      same = false;
+      break;
+    }
+    for (std::int32_t j = 0; j < n_d; ++j)
+      same = same and ja_d[ia_d[r] + j] == cols[row_ptr[r] + j];
+
+    // Off-diagonal block: the same global columns
+    const std::int32_t n_o = row_ptr[r + 1] - row_ptr[r] - n_d;
+    if (!Ao)
+    {
+      same = same and n_o == 0;
+      continue;
+    }
+    if (ia_o[r + 1] - ia_o[r] != n_o)
+    {
+      same = false;
+      break;
+    }
+    for (std::int32_t k = row_ptr[r] + n_d; k < row_ptr[r + 1]; ++k)
+    {
+      same = same
+             and colmap[ja_o[ia_o[r] + pos[k]]]
+                     == ghost_cols[cols[k] - local_size1];
+    }
+  }
+
+  MatRestoreRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, &nd, &ia_d, &ja_d,
+                  &done_d);
+  if (Ao)
+  {
+    MatRestoreRowIJ(Ao, 0, PETSC_FALSE, PETSC_FALSE, &no, &ia_o, &ja_o,
+                    &done_o);
+  }
+
+  return same;
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
-la::PETScMatrix dolfinx::fem::create_matrix(const Form<PetscScalar>& a)
+la::PETScMatrix dolfinx::fem::create_matrix(const Form<PetscScalar>& a,
+                                            bool blocked)
 {
   // Build sparsitypattern
-  la::SparsityPattern pattern = fem::create_sparsity_pattern(a);
+  la::SparsityPattern pattern = fem::create_sparsity_pattern(a, blocked);
 
   // Finalise communication
   pattern.assemble();
@@ -248,7 +475,209 @@ fem::create_vector_nest(const std::vector<const common::IndexMap*>& maps)
   return la::PETScVector(y, false);
 }
 //-----------------------------------------------------------------------------
-void fem::assemble_vector_petsc(Vec b, const Form<PetscScalar>& L)
+void fem::assemble_matrix_blocked_petsc(
+    Mat A, const Form<PetscScalar>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<PetscScalar>>>& bcs)
+{
+  std::array<int, 2> bs, num_nodes;
+  for (int i = 0; i < 2; ++i)
+  {
+    assert(a.function_space(i));
+    const fem::DofMap& dofmap = *a.function_space(i)->dofmap();
+    if (dofmap.bs() == 1)
+      throw std::runtime_error("Blocked assembly requires blocked dofmaps.");
+    bs[i] = dofmap.bs();
+    num_nodes[i] = dofmap.element_dof_layout->num_dofs() / dofmap.bs();
+  }
+
+  fem::assemble_matrix(la::PETScMatrix::add_block_fn(A, bs, num_nodes), a,
+                       bcs);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_matrix_petsc(
+    Mat A, AssemblyPlan<PetscScalar>& plan, const Form<PetscScalar>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<PetscScalar>>>& bcs)
+{
+  la::MatrixCSR<PetscScalar>& csr = plan.matrix();
+  const common::IndexMap& map1 = *csr.index_maps()[1];
+  const std::int32_t local_size1 = map1.block_size() * map1.size_local();
+
+  // Fall back to insertion through the PETSc interface if the plan
+  // does not match the form, or the layout or the nonzero pattern of
+  // the matrix
+  PetscInt m(0), n(0);
+  MatGetLocalSize(A, &m, &n);
+  Mat Ad(nullptr), Ao(nullptr);
+  const PetscInt* colmap(nullptr);
+  if (!plan.compatible(a) or m != csr.num_owned_rows() or n != local_size1
+      or !aij_blocks(A, Ad, Ao, colmap)
+      or !same_pattern(plan, Ad, Ao, colmap))
+  {
+    fem::assemble_matrix(la::PETScMatrix::add_fn(A), a, bcs);
+    return;
+  }
+
+  // Assemble into plan matrix and accumulate ghost rows on owners
+  csr.set(0);
+  fem::assemble_matrix(plan, a, bcs);
+  csr.finalize();
+
+  // Add owned rows directly to the value arrays of the diagonal and
+  // off-diagonal blocks of A
+  const std::vector<std::int32_t>& row_ptr = csr.row_ptr();
+  const std::vector<PetscScalar>& values = csr.values();
+  const std::vector<std::int32_t>& pos = plan.block_row_positions();
+  const std::vector<std::int32_t>& num_diagonal = plan.num_diagonal();
+  PetscInt nd(0), no(0);
+  const PetscInt *ia_d(nullptr), *ja_d(nullptr);
+  const PetscInt *ia_o(nullptr), *ja_o(nullptr);
+  PetscBool done = PETSC_FALSE;
+  PetscScalar *a_d(nullptr), *a_o(nullptr);
+  MatGetRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, &nd, &ia_d, &ja_d, &done);
+  PetscErrorCode ierr = MatSeqAIJGetArray(Ad, &a_d);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatSeqAIJGetArray");
+  if (Ao)
+  {
+    MatGetRowIJ(Ao, 0, PETSC_FALSE, PETSC_FALSE, &no, &ia_o, &ja_o, &done);
+    ierr = MatSeqAIJGetArray(Ao, &a_o);
+    if (ierr != 0)
+      la::petsc_error(ierr, __FILE__, "MatSeqAIJGetArray");
+  }
+
+  for (std::int32_t r = 0; r < csr.num_owned_rows(); ++r)
+  {
+    const std::int32_t k_o = row_ptr[r] + num_diagonal[r];
+    for (std::int32_t k = row_ptr[r]; k < k_o; ++k)
+      a_d[ia_d[r] + pos[k]] += values[k];
+    for (std::int32_t k = k_o; k < row_ptr[r + 1]; ++k)
+      a_o[ia_o[r] + pos[k]] += values[k];
+  }
+
+  MatSeqAIJRestoreArray(Ad, &a_d);
+  MatRestoreRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, &nd, &ia_d, &ja_d, &done);
+  if (Ao)
+  {
+    MatSeqAIJRestoreArray(Ao, &a_o);
+    MatRestoreRowIJ(Ao, 0, PETSC_FALSE, PETSC_FALSE, &no, &ia_o, &ja_o,
+                    &done);
+  }
+  PetscObjectStateIncrease((PetscObject)A);
+}
+//-----------------------------------------------------------------------------
+la::PETScOperator fem::create_matrix_free_operator(
+    std::shared_ptr<const Form<PetscScalar>> a,
+    const std::vector<std::shared_ptr<const DirichletBC<PetscScalar>>>& bcs,
+    PetscScalar diagonal)
+{
+  assert(a);
+  if (a->rank() != 2)
+    throw std::runtime_error("Form must be bilinear.");
+  std::shared_ptr<const fem::DofMap> dofmap0
+      = a->function_space(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1
+      = a->function_space(1)->dofmap();
+  const common::IndexMap& map0 = *dofmap0->index_map;
+  const common::IndexMap& map1 = *dofmap1->index_map;
+
+  auto op = std::make_unique<MatrixFreeOperator>(MatrixFreeOperator{
+      a, impl::bc_markers(*a, bcs), {}, diagonal, {}, {},
+      la::PETScVector(map1), la::PETScVector(map0)});
+
+  // Owned rows with a Dirichlet condition, if the operator is square
+  if (a->function_space(0) == a->function_space(1))
+  {
+    const std::int32_t size0 = map0.block_size() * map0.size_local();
+    const std::vector<bool>& bc0 = op->bc_markers[0];
+    for (std::size_t i = 0; i < bc0.size() and (std::int32_t)i < size0;
+         ++i)
+    {
+      if (bc0[i])
+        op->bc_rows.push_back(i);
+    }
+  }
+
+  // Split cells of each cell integral into cells with only owned
+  // column dofs and the remaining cells
+  const FormIntegrals<PetscScalar>& integrals = a->integrals();
+  for (int i = 0; i < integrals.num_integrals(IntegralType::cell); ++i)
+  {
+    auto [owned, ghost] = fem::split_cells_by_ownership(
+        integrals.integral_domains(IntegralType::cell, i), *dofmap1);
+    op->owned_cells.push_back(std::move(owned));
+    op->ghost_cells.push_back(std::move(ghost));
+  }
+
+  // Create shell matrix
+  Mat A;
+  PetscErrorCode ierr = MatCreateShell(
+      map0.comm(), map0.block_size() * map0.size_local(),
+      map1.block_size() * map1.size_local(), PETSC_DETERMINE,
+      PETSC_DETERMINE, op.get(), &A);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatCreateShell");
+  op.release();
+  MatShellSetOperation(A, MATOP_MULT, (void (*)(void))matrix_free_mult);
+  MatShellSetOperation(A, MATOP_GET_DIAGONAL,
+                       (void (*)(void))matrix_free_get_diagonal);
+  MatShellSetOperation(A, MATOP_DESTROY, (void (*)(void))matrix_free_destroy);
+
+  return la::PETScOperator(A, false);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_vector_petsc(Vec b, const Form<PetscScalar>& L,
+                                bool scatter)
+{
+  // Assemble into the local (ghosted) form of b. The array is restored
+  // before b takes part in other operations.
+  auto assemble_local = [b](auto&& assemble) {
+    Vec b_local;
+    VecGhostGetLocalForm(b, &b_local);
+    PetscInt n = 0;
+    VecGetSize(b_local, &n);
+    PetscScalar* array = nullptr;
+    VecGetArray(b_local, &array);
+    Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> _b(array, n);
+    assemble(_b);
+    VecRestoreArray(b_local, &array);
+    VecGhostRestoreLocalForm(b, &b_local);
+  };
+
+  if (!scatter)
+  {
+    assemble_local(
+        [&L](auto& _b) { fem::assemble_vector<PetscScalar>(_b, L); });
+    return;
+  }
+
+  // Split cells of each cell integral by ownership of their dofs
+  const FormIntegrals<PetscScalar>& integrals = L.integrals();
+  const fem::DofMap& dofmap = *L.function_space(0)->dofmap();
+  std::vector<std::vector<std::int32_t>> owned_cells, ghost_cells;
+  for (int i = 0; i < integrals.num_integrals(IntegralType::cell); ++i)
+  {
+    auto [owned, ghost] = fem::split_cells_by_ownership(
+        integrals.integral_domains(IntegralType::cell, i), dofmap);
+    owned_cells.push_back(std::move(owned));
+    ghost_cells.push_back(std::move(ghost));
+  }
+
+  // Assemble contributions to ghost entries and start sending them to
+  // the owners, then assemble the cells with only owned dofs while the
+  // scatter is in progress
+  assemble_local([&L, &ghost_cells](auto& _b) {
+    impl::assemble_vector<PetscScalar>(_b, L, ghost_cells, true);
+  });
+  VecGhostUpdateBegin(b, ADD_VALUES, SCATTER_REVERSE);
+  assemble_local([&L, &owned_cells](auto& _b) {
+    impl::assemble_vector<PetscScalar>(_b, L, owned_cells, false);
+  });
+  VecGhostUpdateEnd(b, ADD_VALUES, SCATTER_REVERSE);
+}
+//-----------------------------------------------------------------------------
+void fem::assemble_fused_petsc(
+    Mat A, Vec b, const Form<PetscScalar>& a, const Form<PetscScalar>& L,
+    const std::vector<std::shared_ptr<const DirichletBC<PetscScalar>>>& bcs)
 {
   Vec b_local;
   VecGhostGetLocalForm(b, &b_local);
@@ -257,7 +686,8 @@ void fem::assemble_vector_petsc(Vec b, const Form<PetscScalar>& L)
   PetscScalar* array = nullptr;
   VecGetArray(b_local, &array);
   Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> _b(array, n);
-  fem::assemble_vector<PetscScalar>(_b, L);
+  fem::assemble_fused<PetscScalar>({la::PETScMatrix::add_fn(A)}, {&a}, {_b},
+                                   {&L}, bcs);
   VecRestoreArray(b_local, &array);
   VecGhostRestoreLocalForm(b, &b_local);
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <dolfinx/la/PETScMatrix.h>
+#include <dolfinx/la/PETScOperator.h>
 #include <dolfinx/la/PETScVector.h>
 #include <memory>
 #include <petscvec.h>
@@ -22,14 +23,22 @@ class FunctionSpace;
 namespace fem
 {
 template <typename T>
+class AssemblyPlan;
+template <typename T>
 class DirichletBC;
 template <typename T>
 class Form;
 
 /// Create a matrix
 /// @param[in] a  A bilinear form
+/// @param[in] blocked If true, create a block compressed row matrix
+///   (MATBAIJ) from a blocked sparsity pattern. The function spaces
+///   must have blocked dofmaps with the same block size (see
+///   DofMap::bs). Use assemble_matrix_blocked_petsc to insert element
+///   matrices block-wise.
 /// @return A matrix. The matrix is not zeroed.
-la::PETScMatrix create_matrix(const Form<PetscScalar>& a);
+la::PETScMatrix create_matrix(const Form<PetscScalar>& a,
+                              bool blocked = false);
 
 /// Initialise monolithic matrix for an array for bilinear forms. Matrix
 /// is not zeroed.
@@ -52,18 +61,112 @@ la::PETScVector create_vector_block(
 la::PETScVector
 create_vector_nest(const std::vector<const common::IndexMap*>& maps);
 
+// -- Matrices ---------------------------------------------------------------
+
+/// Assemble bilinear form into an already allocated block matrix, e.g.
+/// created by create_matrix(a, true), inserting the element matrices
+/// block-wise (see la::PETScMatrix::add_block_fn). The test and trial
+/// spaces must have blocked dofmaps (see DofMap::bs) with the same
+/// block sizes as the matrix. The matrix is not zeroed before
+/// assembly, and the caller is responsible for calling
+/// MatAssemblyBegin/End.
+///
+/// @param[in,out] A The PETSc matrix to assemble the form into
+/// @param[in] a The bilinear form to assemble
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+///  dofs the row and column are zeroed. The diagonal  entry is not set.
+void assemble_matrix_blocked_petsc(
+    Mat A, const Form<PetscScalar>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<PetscScalar>>>& bcs);
+
+/// Assemble bilinear form into an already allocated PETSc matrix using
+/// an assembly plan. The form is assembled into the plan matrix by
+/// direct indexed addition (see fem::AssemblyPlan), ghost rows are sent
+/// to their owners, and the owned rows are then added directly to the
+/// value arrays of the diagonal and off-diagonal blocks of @p A at
+/// positions precomputed by the plan, without PETSc index lookups.
+/// This requires an assembled (Seq/MPI)AIJ matrix with the same
+/// nonzero pattern as the plan, which is checked on each call. A
+/// matrix that has not yet been assembled, e.g. a newly created one,
+/// or that does not match the plan or the form is assembled into using
+/// la::PETScMatrix::add_fn instead. The matrix is not zeroed before
+/// assembly, and the caller is responsible for calling
+/// MatAssemblyBegin/End.
+///
+/// @param[in,out] A The PETSc matrix to assemble the form into
+/// @param[in,out] plan The assembly plan for the form
+/// @param[in] a The bilinear form to assemble
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+///  dofs the row and column are zeroed. The diagonal  entry is not set.
+void assemble_matrix_petsc(
+    Mat A, AssemblyPlan<PetscScalar>& plan, const Form<PetscScalar>& a,
+    const std::vector<std::shared_ptr<const DirichletBC<PetscScalar>>>& bcs);
+
+/// Create a matrix-free operator (PETSc MatShell) for a bilinear form.
+/// The product y = A x is computed by executing the form kernels on
+/// each cell, gathering from a ghosted copy of x and scattering to a
+/// ghosted copy of y. Cells with no ghost column dofs are computed
+/// while the ghost values of x are being updated. The operator
+/// supports MatMult and MatGetDiagonal, and can therefore be used with
+/// la::PETScKrylovSolver and Jacobi preconditioning.
+///
+/// Rows and columns of A for Dirichlet dofs are zeroed, and @p diagonal
+/// is set on the diagonal of Dirichlet rows if the test and trial
+/// spaces are the same, which matches the matrix from assemble_matrix
+/// followed by add_diagonal. The form may be modified, e.g. its
+/// coefficients updated, while the operator is in use.
+///
+/// @param[in] a The bilinear form
+/// @param[in] bcs Boundary conditions to apply
+/// @param[in] diagonal The value on the diagonal for rows with a
+///   boundary condition applied
+/// @return The matrix-free operator
+la::PETScOperator create_matrix_free_operator(
+    std::shared_ptr<const Form<PetscScalar>> a,
+    const std::vector<std::shared_ptr<const DirichletBC<PetscScalar>>>& bcs,
+    PetscScalar diagonal = 1.0);
+
 // -- Vectors ----------------------------------------------------------------
 
-/// Assemble linear form into an already allocated PETSc vector. Ghost
-/// contributions are not accumulated (not sent to owner). Caller is
-/// responsible for calling VecGhostUpdateBegin/End.
+/// Assemble linear form into an already allocated PETSc vector. If @p
+/// scatter is false, ghost contributions are not accumulated (not sent
+/// to owner) and the caller is responsible for calling
+/// VecGhostUpdateBegin/End.
+///
+/// If @p scatter is true, ghost contributions are accumulated on the
+/// owning processes, with the communication overlapped with
+/// assembly: cells with ghost dofs and facet integrals are assembled
+/// first, the reverse scatter is started, and cells with only owned
+/// dofs are assembled while messages are in flight. The vector must
+/// then be a ghosted vector and must not hold ghost contributions from
+/// before the call.
 ///
 /// @param[in,out] b The PETsc vector to assemble the form into. The
 ///   vector must already be initialised with the correct size. The
 ///   process-local contribution of the form is assembled into this
 ///   vector. It is not zeroed before assembly.
 /// @param[in] L The linear form to assemble
-void assemble_vector_petsc(Vec b, const Form<PetscScalar>& L);
+/// @param[in] scatter If true, accumulate ghost contributions on the
+///   owning processes
+void assemble_vector_petsc(Vec b, const Form<PetscScalar>& L,
+                           bool scatter = false);
+
+/// Assemble a bilinear form into a PETSc matrix and a linear form into
+/// a PETSc vector in a single pass over the cells (see
+/// fem::assemble_fused). The result is the same as for
+/// assemble_matrix followed by assemble_vector_petsc: ghost
+/// contributions to @p b are not accumulated, and the diagonal entries
+/// of Dirichlet rows of @p A are not set.
+/// @param[in,out] A The matrix to assemble the bilinear form into. It
+///   must already be initialised. It is not zeroed before assembly.
+/// @param[in,out] b The vector to assemble the linear form into. It
+///   must already be initialised. It is not zeroed before assembly.
+/// @param[in] a The bilinear form
+/// @param[in] L The linear form
+/// @param[in] bcs Boundary conditions to apply to the bilinear form
+void assemble_fused_petsc(
+    Mat A, Vec b, const Form<PetscScalar>& a, const Form<PetscScalar>& L,
+    const std::vector<std::shared_ptr<const DirichletBC<PetscScalar>>>& bcs);
 
 // FIXME: clarify how x0 is used
 // FIXME: if bcs entries are set
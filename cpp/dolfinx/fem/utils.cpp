@@ -6,6 +6,7 @@
 
 #include "utils.h"
 #include <Eigen/Dense>
+#include <algorithm>
 #include <array>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Timer.h>
@@ -24,9 +25,14 @@
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/TopologyComputation.h>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <ufc.h>
 
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
 using namespace dolfinx;
 
 namespace
@@ -137,7 +143,8 @@ fem::common_function_spaces(
 la::SparsityPattern
 fem::create_sparsity_pattern(const mesh::Topology& topology,
                              const std::array<const DofMap*, 2>& dofmaps,
-                             const std::set<IntegralType>& integrals)
+                             const std::set<IntegralType>& integrals,
+                             bool blocked)
 {
   common::Timer t0("Build sparsity");
 
@@ -147,7 +154,8 @@ fem::create_sparsity_pattern(const mesh::Topology& topology,
   // Create and build sparsity pattern
   assert(dofmaps[0]);
   assert(dofmaps[0]->index_map);
-  la::SparsityPattern pattern(dofmaps[0]->index_map->comm(), index_maps);
+  la::SparsityPattern pattern(dofmaps[0]->index_map->comm(), index_maps,
+                              blocked);
   for (auto type : integrals)
   {
     if (type == fem::IntegralType::cell)
@@ -327,3 +335,48 @@ fem::create_functionspace(ufc_function_space* (*fptr)(const char*),
   return V;
 }
 //-----------------------------------------------------------------------------
+int fem::num_assembly_threads()
+{
+#ifdef HAS_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t>
+fem::group_by_color(const std::vector<std::int32_t>& cells,
+                    const std::vector<std::int32_t>& cell_colors)
+{
+  const std::int32_t num_colors
+      = cell_colors.empty()
+            ? 0
+            : *std::max_element(cell_colors.begin(), cell_colors.end()) + 1;
+
+  // Count number of cells of each colour
+  std::vector<std::int32_t> offsets(num_colors + 1, 0);
+  for (std::int32_t c : cells)
+    ++offsets[cell_colors[c] + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // Place cells in colour order
+  std::vector<std::int32_t> data(offsets.back());
+  std::vector<std::int32_t> pos(offsets.begin(), offsets.end() - 1);
+  for (std::int32_t c : cells)
+    data[pos[cell_colors[c]]++] = c;
+
+  return graph::AdjacencyList<std::int32_t>(data, offsets);
+}
+//-----------------------------------------------------------------------------
+std::array<std::vector<std::int32_t>, 2>
+fem::split_cells_by_ownership(const std::vector<std::int32_t>& cells,
+                              const DofMap& dofmap)
+{
+  const std::vector<std::int8_t>& ghost = dofmap.ghost_cell_markers();
+  std::array<std::vector<std::int32_t>, 2> split;
+  for (std::int32_t c : cells)
+    split[ghost[c]].push_back(c);
+
+  return split;
+}
+//-----------------------------------------------------------------------------
@@ -13,10 +13,14 @@
 #include <dolfinx/fem/Form.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/cell_types.h>
+#include <array>
+#include <complex>
 #include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -93,9 +97,13 @@ common_function_spaces(
 /// finalised, i.e. the caller is responsible for calling
 /// SparsityPattern::assemble.
 /// @param[in] a A bilinear form
+/// @param[in] blocked If true, create a blocked pattern on the nodes
+///   of the function spaces (see la::SparsityPattern). The dofmaps
+///   must then be blocked (see DofMap::bs).
 /// @return The corresponding sparsity pattern
 template <typename T>
-la::SparsityPattern create_sparsity_pattern(const Form<T>& a)
+la::SparsityPattern create_sparsity_pattern(const Form<T>& a,
+                                            bool blocked = false)
 {
   if (a.rank() != 2)
   {
@@ -119,7 +127,7 @@ la::SparsityPattern create_sparsity_pattern(const Form<T>& a)
     mesh->topology_mutable().create_connectivity(tdim - 1, tdim);
   }
 
-  return create_sparsity_pattern(mesh->topology(), dofmaps, types);
+  return create_sparsity_pattern(mesh->topology(), dofmaps, types, blocked);
 }
 
 /// Create a sparsity pattern for a given form. The pattern is not
@@ -128,7 +136,8 @@ la::SparsityPattern create_sparsity_pattern(const Form<T>& a)
 la::SparsityPattern
 create_sparsity_pattern(const mesh::Topology& topology,
                         const std::array<const DofMap*, 2>& dofmaps,
-                        const std::set<IntegralType>& integrals);
+                        const std::set<IntegralType>& integrals,
+                        bool blocked = false);
 
 /// Create an ElementDofLayout from a ufc_dofmap
 ElementDofLayout create_element_dof_layout(const ufc_dofmap& dofmap,
@@ -177,6 +186,14 @@ get_constants_from_ufc_form(const ufc_form& ufc_form)
 }
 
 /// Create a Form from UFC input
+///
+/// The integral kernels of the UFC form are called with data of type T,
+/// so the form must have been generated for the scalar type T, e.g.
+/// with the FFCX option scalar_type="float" for T = float. The UFC
+/// interface does not record the scalar type of the generated code,
+/// so the kernel signature is checked by the compiler only when T is
+/// the UFC scalar type (ufc_scalar_t).
+///
 /// @param[in] ufc_form The UFC form
 /// @param[in] spaces Vector of function spaces
 template <typename T>
@@ -186,6 +203,23 @@ Form<T> create_form(
 {
   assert(ufc_form.rank == (int)spaces.size());
 
+  // Kernels are declared for ufc_scalar_t in the UFC interface, but are
+  // generated for the scalar type of the form. The kernel pointer is
+  // cast only if T differs from ufc_scalar_t.
+  static_assert(std::is_same_v<T, float> or std::is_same_v<T, double>
+                    or std::is_same_v<T, std::complex<float>>
+                    or std::is_same_v<T, std::complex<double>>,
+                "Unsupported scalar type for form kernels");
+  using kernel_ptr
+      = void (*)(T*, const T*, const T*, const double*, const int*,
+                 const std::uint8_t*, const std::uint32_t);
+  auto get_kernel = [](const ufc_integral* integral) -> kernel_ptr {
+    if constexpr (std::is_same_v<T, ufc_scalar_t>)
+      return integral->tabulate_tensor;
+    else
+      return reinterpret_cast<kernel_ptr>(integral->tabulate_tensor);
+  };
+
   // Check argument function spaces
   for (std::size_t i = 0; i < spaces.size(); ++i)
   {
@@ -210,8 +244,8 @@ Form<T> create_form(
   {
     ufc_integral* cell_integral = ufc_form.create_cell_integral(id);
     assert(cell_integral);
-    integrals.set_tabulate_tensor(IntegralType::cell, id,
-                                  cell_integral->tabulate_tensor);
+    const kernel_ptr kernel = get_kernel(cell_integral);
+    integrals.set_tabulate_tensor(IntegralType::cell, id, kernel);
     std::free(cell_integral);
   }
 
@@ -236,8 +270,8 @@ Form<T> create_form(
     ufc_integral* exterior_facet_integral
         = ufc_form.create_exterior_facet_integral(id);
     assert(exterior_facet_integral);
-    integrals.set_tabulate_tensor(IntegralType::exterior_facet, id,
-                                  exterior_facet_integral->tabulate_tensor);
+    const kernel_ptr kernel = get_kernel(exterior_facet_integral);
+    integrals.set_tabulate_tensor(IntegralType::exterior_facet, id, kernel);
     std::free(exterior_facet_integral);
   }
 
@@ -249,8 +283,8 @@ Form<T> create_form(
     ufc_integral* interior_facet_integral
         = ufc_form.create_interior_facet_integral(id);
     assert(interior_facet_integral);
-    integrals.set_tabulate_tensor(IntegralType::interior_facet, id,
-                                  interior_facet_integral->tabulate_tensor);
+    const kernel_ptr kernel = get_kernel(interior_facet_integral);
+    integrals.set_tabulate_tensor(IntegralType::interior_facet, id, kernel);
     std::free(interior_facet_integral);
   }
 
@@ -313,6 +347,77 @@ create_functionspace(ufc_function_space* (*fptr)(const char*),
                      const std::string function_name,
                      std::shared_ptr<mesh::Mesh> mesh);
 
+/// Number of threads that assembly functions will use. This is the
+/// OpenMP maximum number of threads if DOLFINX has been built with
+/// OpenMP support, otherwise one.
+/// @return Number of assembly threads
+int num_assembly_threads();
+
+/// Group cells by colour, e.g. for thread-parallel assembly
+/// @param[in] cells List of cell indices
+/// @param[in] cell_colors The colour of every cell in the mesh
+/// @return The cells of @p cells grouped by colour, i.e. the links of
+///   node i are the cells with colour i. The order of cells within a
+///   colour preserves their order in @p cells.
+graph::AdjacencyList<std::int32_t>
+group_by_color(const std::vector<std::int32_t>& cells,
+               const std::vector<std::int32_t>& cell_colors);
+
+/// Split cells into the cells whose dofs are all owned by this process
+/// and the cells with one or more ghost dofs, e.g. to overlap
+/// assembly with ghost communication. The ownership of the cells is
+/// cached on the dofmap (see DofMap::ghost_cell_markers).
+/// @param[in] cells List of cell indices
+/// @param[in] dofmap The dofmap
+/// @return Cells of @p cells with only owned dofs, and cells of @p
+///   cells with ghost dofs. The order of @p cells is preserved.
+std::array<std::vector<std::int32_t>, 2>
+split_cells_by_ownership(const std::vector<std::int32_t>& cells,
+                         const DofMap& dofmap);
+
+/// Number of cells passed to batched tabulate_tensor functions per
+/// call
+constexpr int cell_batch_size = 32;
+
+/// Pack the geometry, coefficients and permutation info of a batch of
+/// cells in the structure-of-arrays layout used by batched
+/// tabulate_tensor functions (see
+/// FormIntegrals::set_batch_tabulate_tensor)
+/// @param[out] coordinate_dofs Packed coordinate dofs. Size must be at
+///   least num_dofs_g * gdim * n.
+/// @param[out] w Packed coefficients. Size must be at least
+///   coeffs.cols() * n.
+/// @param[out] info Permutation info for each cell in the batch
+/// @param[in] cells The cells in the batch
+/// @param[in] n Number of cells in the batch
+/// @param[in] geometry The mesh geometry
+/// @param[in] coeffs Packed coefficients for all cells
+/// @param[in] cell_info Permutation info for all cells
+template <typename T>
+void pack_cell_batch(
+    double* coordinate_dofs, T* w, std::uint32_t* info,
+    const std::int32_t* cells, int n, const mesh::Geometry& geometry,
+    const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+        coeffs,
+    const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info)
+{
+  const int gdim = geometry.dim();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = geometry.dofmap();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = geometry.x();
+  for (int q = 0; q < n; ++q)
+  {
+    const std::int32_t c = cells[q];
+    auto x_dofs = x_dofmap.links(c);
+    for (Eigen::Index j = 0; j < x_dofs.rows(); ++j)
+      for (int d = 0; d < gdim; ++d)
+        coordinate_dofs[(j * gdim + d) * n + q] = x_g(x_dofs[j], d);
+    for (Eigen::Index k = 0; k < coeffs.cols(); ++k)
+      w[k * n + q] = coeffs(c, k);
+    info[q] = cell_info[c];
+  }
+}
+
 // NOTE: This is subject to change
 /// Pack form coefficients ready for assembly
 template <typename T>
@@ -9,11 +9,14 @@
 #include "FunctionSpace.h"
 #include "interpolate.h"
 #include <Eigen/Dense>
+#include <algorithm>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/UniqueIdGenerator.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/PointOwnership.h>
 #include <dolfinx/la/PETScVector.h>
 #include <dolfinx/la/Vector.h>
 #include <dolfinx/mesh/Geometry.h>
@@ -177,6 +180,36 @@ public:
   /// Underlying vector
   std::shared_ptr<la::Vector<T>> x() { return _x; }
 
+  /// Version of the expansion coefficients. The version changes when
+  /// the coefficients are modified by the operations of the underlying
+  /// vector (Function::x) or through the PETSc wrapper
+  /// (Function::vector), including its local ghosted form. Code that
+  /// writes to la::Vector::array of Function::x must call
+  /// la::Vector::increment_version. The version is used to detect if
+  /// data computed from the coefficients, e.g. packed coefficients of a
+  /// fem::Form, is out of date.
+  /// @return The version
+  std::uint64_t version() const
+  {
+    std::uint64_t v = _x->version();
+    if (_petsc_vector)
+    {
+      // PETSc increments the object state on modification
+      PetscObjectState state;
+      PetscObjectStateGet((PetscObject)_petsc_vector, &state);
+      v += state;
+      Vec x_local;
+      VecGhostGetLocalForm(_petsc_vector, &x_local);
+      if (x_local)
+      {
+        PetscObjectStateGet((PetscObject)x_local, &state);
+        v += state;
+      }
+      VecGhostRestoreLocalForm(_petsc_vector, &x_local);
+    }
+    return v;
+  }
+
   /// Interpolate a Function (on possibly non-matching meshes)
   /// @param[in] v The function to be interpolated.
   void interpolate(const Function<T>& v) { function::interpolate(*this, v); }
@@ -194,6 +227,10 @@ public:
 
   /// Evaluate the Function at points
   ///
+  /// The points are grouped by cell, and the points in a cell are
+  /// pulled back to the reference cell and evaluated together, so
+  /// evaluation is most efficient when many points share a cell.
+  ///
   /// @param[in] x The coordinates of the points. It has shape
   ///   (num_points, 3).
   /// @param[in] cells An array of cell indices. cells[i] is the index
@@ -210,9 +247,6 @@ public:
            Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
            u) const
   {
-    // TODO: This could be easily made more efficient by exploiting points
-    // being ordered by the cell to which they belong.
-
     if (x.rows() != cells.rows())
     {
       throw std::runtime_error(
@@ -255,18 +289,33 @@ public:
     const int value_size = element->value_size();
     const int space_dimension = element->space_dimension();
 
-    // Prepare geometry data structures
-    Eigen::Tensor<double, 3, Eigen::RowMajor> J(1, gdim, tdim);
-    Eigen::Array<double, Eigen::Dynamic, 1> detJ(1);
-    Eigen::Tensor<double, 3, Eigen::RowMajor> K(1, tdim, gdim);
-    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> X(
-        1, tdim);
+    // Group the points by cell, keeping the order of the points in a
+    // cell, and skipping points with a negative cell index
+    std::vector<std::int32_t> perm;
+    perm.reserve(cells.rows());
+    for (Eigen::Index p = 0; p < cells.rows(); ++p)
+      if (cells[p] >= 0)
+        perm.push_back(p);
+    if (!std::is_sorted(perm.begin(), perm.end(),
+                        [&cells](auto p0, auto p1) {
+                          return cells[p0] < cells[p1];
+                        }))
+    {
+      std::stable_sort(perm.begin(), perm.end(), [&cells](auto p0, auto p1) {
+        return cells[p0] < cells[p1];
+      });
+    }
 
-    // Prepare basis function data structures
-    Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values(
-        1, space_dimension, reference_value_size);
-    Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values(1, space_dimension,
-                                                           value_size);
+    // Workspace for the points in a cell. The arrays are resized for
+    // each cell, which only allocates memory when the number of points
+    // in a cell changes.
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        x_cell;
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> X;
+    Eigen::Tensor<double, 3, Eigen::RowMajor> J, K;
+    Eigen::Array<double, Eigen::Dynamic, 1> detJ;
+    Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values;
+    Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values;
 
     // Create work vector for expansion coefficients
     Eigen::Matrix<T, 1, Eigen::Dynamic> coefficients(space_dimension);
@@ -279,30 +328,41 @@ public:
     const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
         = mesh->topology().get_cell_permutation_info();
 
-    // Loop over points
+    // Loop over cells
     u.setZero();
     const Eigen::Matrix<T, Eigen::Dynamic, 1>& _v = _x->array();
-    for (Eigen::Index p = 0; p < cells.rows(); ++p)
+    for (std::size_t p0 = 0; p0 < perm.size();)
     {
-      const int cell_index = cells(p);
-
-      // Skip negative cell indices
-      if (cell_index < 0)
-        continue;
+      const int cell_index = cells[perm[p0]];
+      std::size_t p1 = p0 + 1;
+      while (p1 < perm.size() and cells[perm[p1]] == cell_index)
+        ++p1;
+      const int num_points = p1 - p0;
 
       // Get cell geometry (coordinate dofs)
       auto x_dofs = x_dofmap.links(cell_index);
       for (int i = 0; i < num_dofs_g; ++i)
         coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
 
+      // Get the points in the cell
+      x_cell.resize(num_points, gdim);
+      for (int i = 0; i < num_points; ++i)
+        x_cell.row(i) = x.row(perm[p0 + i]).head(gdim);
+
       // Compute reference coordinates X, and J, detJ and K
-      cmap.compute_reference_geometry(X, J, detJ, K, x.row(p).head(gdim),
-                                      coordinate_dofs);
+      X.resize(num_points, tdim);
+      J.resize(num_points, gdim, tdim);
+      detJ.resize(num_points);
+      K.resize(num_points, tdim, gdim);
+      cmap.compute_reference_geometry(X, J, detJ, K, x_cell, coordinate_dofs);
 
       // Compute basis on reference element
+      basis_reference_values.resize(num_points, space_dimension,
+                                    reference_value_size);
       element->evaluate_reference_basis(basis_reference_values, X);
 
       // Push basis forward to physical element
+      basis_values.resize(num_points, space_dimension, value_size);
       element->transform_reference_basis(basis_values, basis_reference_values,
                                          X, J, detJ, K, cell_info[cell_index]);
 
@@ -312,17 +372,63 @@ public:
         coefficients[i] = _v[dofs[i]];
 
       // Compute expansion
-      for (int i = 0; i < space_dimension; ++i)
+      const double* phi = basis_values.data();
+      for (int q = 0; q < num_points; ++q)
       {
-        for (int j = 0; j < value_size; ++j)
+        auto u_q = u.row(perm[p0 + q]);
+        for (int i = 0; i < space_dimension; ++i)
         {
-          // TODO: Find an Eigen shortcut for this operation
-          u.row(p)[j] += coefficients[i] * basis_values(0, i, j);
+          for (int j = 0; j < value_size; ++j)
+            u_q[j] += coefficients[i] * phi[j];
+          phi += value_size;
         }
       }
+
+      p0 = p1;
     }
   }
 
+  /// Evaluate the Function at points on any process (collective). The
+  /// points are sent to the processes that own the cells containing
+  /// them, evaluated there and the values are returned to the calling
+  /// process (see geometry::PointOwnership).
+  /// @param[in] x The points on this process (shape=(num_points, 3))
+  /// @return The values at the points (shape=(num_points,
+  ///   value_size)). Values for points that are not in the mesh are
+  ///   zero.
+  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  eval_distributed(
+      const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x) const
+  {
+    assert(_function_space);
+    std::shared_ptr<const mesh::Mesh> mesh = _function_space->mesh();
+    assert(mesh);
+    const geometry::BoundingBoxTree tree(*mesh, mesh->topology().dim(),
+                                         geometry::TreeBuilder::lbvh);
+    return eval_distributed(geometry::PointOwnership(*mesh, tree, x));
+  }
+
+  /// Evaluate the Function at points on any process, with the
+  /// ownership of the points computed beforehand (collective). Use
+  /// this to evaluate repeatedly at the same points, e.g. at probe
+  /// locations in each time step.
+  /// @param[in] ownership The ownership of the points, computed for the
+  ///   mesh of this Function
+  /// @return The values at the points passed to @p ownership
+  ///   (shape=(num_points, value_size)). Values for points that are not
+  ///   in the mesh are zero.
+  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  eval_distributed(const geometry::PointOwnership& ownership) const
+  {
+    assert(_function_space);
+    assert(_function_space->element());
+    const int value_size = _function_space->element()->value_size();
+    Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> values(
+        ownership.points().rows(), value_size);
+    eval(ownership.points(), ownership.cells(), values);
+    return ownership.gather(values);
+  }
+
   /// Compute values at all mesh 'nodes'
   /// @return The values at all geometric points
   Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
@@ -331,49 +437,107 @@ public:
     assert(_function_space);
     std::shared_ptr<const mesh::Mesh> mesh = _function_space->mesh();
     assert(mesh);
+    const int gdim = mesh->geometry().dim();
     const int tdim = mesh->topology().dim();
 
-    // Compute in tensor (one for scalar function, . . .)
-    const int value_size_loc = _function_space->element()->value_size();
+    // Get element
+    std::shared_ptr<const fem::FiniteElement> element
+        = _function_space->element();
+    assert(element);
+    const int reference_value_size = element->reference_value_size();
+    const int value_size = element->value_size();
+    const int space_dimension = element->space_dimension();
 
     // Resize Array for holding point values
     Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-        point_values(mesh->geometry().x().rows(), value_size_loc);
+        point_values(mesh->geometry().x().rows(), value_size);
 
     // Prepare cell geometry
     const graph::AdjacencyList<std::int32_t>& x_dofmap
         = mesh->geometry().dofmap();
+    const fem::CoordinateElement& cmap = mesh->geometry().cmap();
 
     // FIXME: Add proper interface for num coordinate dofs
     const int num_dofs_g = x_dofmap.num_links(0);
     const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
         = mesh->geometry().x();
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        coordinate_dofs(num_dofs_g, gdim);
 
-    // Interpolate point values on each cell (using last computed value if
-    // not continuous, e.g. discontinuous Galerkin methods)
-    Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> x(num_dofs_g, 3);
-    Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> values(
-        num_dofs_g, value_size_loc);
     auto map = mesh->topology().index_map(tdim);
     assert(map);
     const std::int32_t num_cells = map->size_local() + map->num_ghosts();
+    if (num_cells == 0)
+      return point_values;
+
+    // Prepare geometry data structures
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> X_ref(
+        num_dofs_g, tdim);
+    Eigen::Tensor<double, 3, Eigen::RowMajor> J(num_dofs_g, gdim, tdim);
+    Eigen::Array<double, Eigen::Dynamic, 1> detJ(num_dofs_g);
+    Eigen::Tensor<double, 3, Eigen::RowMajor> K(num_dofs_g, tdim, gdim);
+
+    // The geometry nodes of every cell are the same points on the
+    // reference cell, which are found by pulling back the nodes of the
+    // first cell. The element basis and the derivatives of the
+    // coordinate basis are tabulated once at these points.
+    auto x_dofs0 = x_dofmap.links(0);
+    for (int i = 0; i < num_dofs_g; ++i)
+      coordinate_dofs.row(i) = x_g.row(x_dofs0[i]).head(gdim);
+    cmap.compute_reference_geometry(X_ref, J, detJ, K, coordinate_dofs,
+                                    coordinate_dofs);
+    const Eigen::Tensor<double, 3, Eigen::RowMajor> dphi
+        = cmap.tabulate_basis_derivatives(X_ref);
+    Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values(
+        num_dofs_g, space_dimension, reference_value_size);
+    element->evaluate_reference_basis(basis_reference_values, X_ref);
+
+    // Prepare basis function data structures
+    Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values(
+        num_dofs_g, space_dimension, value_size);
+    Eigen::Matrix<T, 1, Eigen::Dynamic> coefficients(space_dimension);
+
+    std::shared_ptr<const fem::DofMap> dofmap = _function_space->dofmap();
+    assert(dofmap);
+    mesh->topology_mutable().create_entity_permutations();
+    const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+        = mesh->topology().get_cell_permutation_info();
+
+    // Interpolate point values on each cell (using last computed value if
+    // not continuous, e.g. discontinuous Galerkin methods)
+    const Eigen::Matrix<T, Eigen::Dynamic, 1>& _v = _x->array();
     for (std::int32_t c = 0; c < num_cells; ++c)
     {
-      // Get coordinates for all points in cell
-      auto dofs = x_dofmap.links(c);
+      // Get cell geometry (coordinate dofs)
+      auto x_dofs = x_dofmap.links(c);
       for (int i = 0; i < num_dofs_g; ++i)
-        x.row(i) = x_g.row(dofs[i]);
+        coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
 
-      values.resize(x.rows(), value_size_loc);
+      // Compute J, detJ and K at the nodes
+      cmap.compute_jacobian_data(J, detJ, K, dphi, coordinate_dofs);
 
-      // Call evaluate function
-      Eigen::Array<int, Eigen::Dynamic, 1> cells(x.rows());
-      cells = c;
-      eval(x, cells, values);
+      // Push basis forward to physical element
+      element->transform_reference_basis(basis_values, basis_reference_values,
+                                         X_ref, J, detJ, K, cell_info[c]);
+
+      // Get degrees of freedom for current cell
+      auto dofs = dofmap->cell_dofs(c);
+      for (Eigen::Index i = 0; i < dofs.size(); ++i)
+        coefficients[i] = _v[dofs[i]];
 
-      // Copy values to array of point values
-      for (int i = 0; i < x.rows(); ++i)
-        point_values.row(dofs[i]) = values.row(i);
+      // Compute expansion at the nodes
+      const double* phi = basis_values.data();
+      for (int q = 0; q < num_dofs_g; ++q)
+      {
+        auto u_q = point_values.row(x_dofs[q]);
+        u_q.setZero();
+        for (int i = 0; i < space_dimension; ++i)
+        {
+          for (int j = 0; j < value_size; ++j)
+            u_q[j] += coefficients[i] * phi[j];
+          phi += value_size;
+        }
+      }
     }
 
     return point_values;
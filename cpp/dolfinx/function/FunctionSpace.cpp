@@ -6,12 +6,15 @@
 
 #include "FunctionSpace.h"
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
 #include <dolfinx/common/UniqueIdGenerator.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/common/utils.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/PointOwnership.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/la/utils.h>
 #include <dolfinx/mesh/Geometry.h>
@@ -200,6 +203,36 @@ FunctionSpace::tabulate_dof_coordinates() const
   return x;
 }
 //-----------------------------------------------------------------------------
+std::shared_ptr<const geometry::PointOwnership>
+FunctionSpace::dof_coordinate_ownership(const mesh::Mesh& mesh) const
+{
+  assert(_mesh);
+  const std::size_t x_hash = _mesh->geometry().hash();
+  const std::size_t x_hash_other = mesh.geometry().hash();
+  auto& [id, h0, h1, ownership] = _dof_coordinate_ownership;
+
+  // Computing the ownership is collective, so recompute on all
+  // processes if the cached values are not valid on any process
+  std::int8_t recompute = !ownership or id != mesh.id() or h0 != x_hash
+                          or h1 != x_hash_other;
+  MPI_Allreduce(MPI_IN_PLACE, &recompute, 1, MPI_INT8_T, MPI_LOR,
+                mesh.mpi_comm());
+  if (recompute)
+  {
+    // Release the old ownership before computing the new one
+    ownership.reset();
+    const geometry::BoundingBoxTree tree(mesh, mesh.topology().dim(),
+                                         geometry::TreeBuilder::lbvh);
+    ownership = std::make_shared<geometry::PointOwnership>(
+        mesh, tree, tabulate_dof_coordinates());
+    id = mesh.id();
+    h0 = x_hash;
+    h1 = x_hash_other;
+  }
+
+  return ownership;
+}
+//-----------------------------------------------------------------------------
 std::size_t FunctionSpace::id() const { return _id; }
 //-----------------------------------------------------------------------------
 std::shared_ptr<const mesh::Mesh> FunctionSpace::mesh() const { return _mesh; }
@@ -8,9 +8,11 @@
 
 #include <Eigen/Dense>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 namespace dolfinx
@@ -22,6 +24,11 @@ class DofMap;
 class FiniteElement;
 } // namespace fem
 
+namespace geometry
+{
+class PointOwnership;
+}
+
 namespace mesh
 {
 class Mesh;
@@ -103,6 +110,17 @@ public:
   Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>
   tabulate_dof_coordinates() const;
 
+  /// Get the ownership of the dof coordinates of this space in another
+  /// mesh (collective), e.g. for interpolation of a Function on a
+  /// non-matching mesh. The ownership is cached for the most recently
+  /// used mesh only. It is recomputed for a different mesh, or when the
+  /// geometry coordinates of the mesh of this space or of @p mesh have
+  /// changed on any process (see mesh::Geometry::hash).
+  /// @param[in] mesh The mesh in which to locate the dof coordinates
+  /// @return The ownership of the dof coordinates on this process
+  std::shared_ptr<const geometry::PointOwnership>
+  dof_coordinate_ownership(const mesh::Mesh& mesh) const;
+
   /// Unique identifier
   std::size_t id() const;
 
@@ -136,6 +154,14 @@ private:
 
   // Cache of subspaces
   mutable std::map<std::vector<int>, std::weak_ptr<FunctionSpace>> _subspaces;
+
+  // Cached dof coordinate ownership for the most recently used mesh:
+  // the id of the mesh, the hashes of the geometry coordinates of the
+  // mesh of this space and of the other mesh that it was computed for,
+  // and the ownership
+  mutable std::tuple<std::size_t, std::size_t, std::size_t,
+                     std::shared_ptr<const geometry::PointOwnership>>
+      _dof_coordinate_ownership;
 };
 } // namespace function
 } // namespace dolfinx
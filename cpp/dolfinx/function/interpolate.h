@@ -9,10 +9,14 @@
 #include "Function.h"
 #include "FunctionSpace.h"
 #include <Eigen/Dense>
+#include <algorithm>
+#include <complex>
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/geometry/PointOwnership.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <functional>
+#include <type_traits>
 
 namespace dolfinx::function
 {
@@ -20,7 +24,11 @@ namespace dolfinx::function
 template <typename T>
 class Function;
 
-/// Interpolate a Function (on possibly non-matching meshes)
+/// Interpolate a Function (on possibly non-matching meshes). If the
+/// meshes of @p u and @p v differ, @p v is evaluated at the dof
+/// coordinates of @p u (collective), and the coefficients of dofs whose
+/// coordinates are outside the mesh of @p v are set to zero. This
+/// requires point evaluation dofs, e.g. Lagrange elements.
 /// @param[in,out] u The function to interpolate into
 /// @param[in] v The function to be interpolated
 template <typename T>
@@ -99,6 +107,9 @@ void interpolate_values(
   assert(dofmap);
   assert(dofmap->element_dof_layout);
   std::vector<T> cell_coefficients(dofmap->element_dof_layout->num_dofs());
+  std::vector<ufc_scalar_t> cell_coefficients_ufc;
+  if constexpr (!std::is_same<T, ufc_scalar_t>::value)
+    cell_coefficients_ufc.resize(cell_coefficients.size());
 
   Eigen::Matrix<T, Eigen::Dynamic, 1>& coefficients = u.x()->array();
 
@@ -118,34 +129,88 @@ void interpolate_values(
     // FIXME: For vector-valued Lagrange, this function 'throws away'
     // the redundant expression evaluations. It should really be made
     // not necessary.
-    element->transform_values(cell_coefficients.data(), values_cell,
-                              coordinate_dofs);
+    if constexpr (std::is_same<T, ufc_scalar_t>::value)
+    {
+      element->transform_values(cell_coefficients.data(), values_cell,
+                                coordinate_dofs);
+    }
+    else
+    {
+      // Elements operate on ufc_scalar_t, so convert to and from T. The
+      // imaginary part is discarded if T is real.
+      element->transform_values(cell_coefficients_ufc.data(),
+                                values_cell.template cast<ufc_scalar_t>(),
+                                coordinate_dofs);
+      std::transform(cell_coefficients_ufc.begin(),
+                     cell_coefficients_ufc.end(), cell_coefficients.begin(),
+                     [](ufc_scalar_t v) {
+                       if constexpr (std::is_floating_point<T>::value)
+                         return static_cast<T>(std::real(v));
+                       else
+                         return static_cast<T>(v);
+                     });
+    }
 
     // Copy into expansion coefficient array
     for (Eigen::Index i = 0; i < cell_dofs.rows(); ++i)
       coefficients[cell_dofs[i]] = cell_coefficients[i];
   }
+  u.x()->increment_version();
 }
 
+// Interpolate a Function on a non-matching mesh. The Function v is
+// evaluated at the dof coordinates of u, which are located in the mesh
+// of v in parallel. The location of the dof coordinates is cached by
+// the function space of u, so repeated interpolation only evaluates v
+// and returns the values to the processes of the dofs.
 template <typename T>
-void interpolate_from_any(Function<T>& u, const Function<T>& v)
+void interpolate_nonmatching(Function<T>& u, const Function<T>& v)
 {
+  assert(u.function_space());
   assert(v.function_space());
-  const auto element = u.function_space()->element();
-  assert(element);
-  if (!v.function_space()->has_element(*element))
+  assert(v.function_space()->mesh());
+
+  // The values of v are used as the values of u at the dof coordinates
+  assert(u.function_space()->element());
+  assert(v.function_space()->element());
+  const int value_size_u = u.function_space()->element()->value_size();
+  const int value_size_v = v.function_space()->element()->value_size();
+  if (value_size_u != value_size_v)
   {
-    throw std::runtime_error("Restricting finite elements function in "
-                             "different elements not supported.");
+    throw std::runtime_error(
+        "Cannot interpolate Function on non-matching mesh. Value size of "
+        "Function ("
+        + std::to_string(value_size_v)
+        + ") does not match value size of function space ("
+        + std::to_string(value_size_u) + ")");
   }
 
+  std::shared_ptr<const geometry::PointOwnership> ownership
+      = u.function_space()->dof_coordinate_ownership(
+          *v.function_space()->mesh());
+  assert(ownership);
+  interpolate_values<T>(u, v.eval_distributed(*ownership));
+}
+
+template <typename T>
+void interpolate_from_any(Function<T>& u, const Function<T>& v)
+{
+  assert(v.function_space());
   const auto mesh = u.function_space()->mesh();
   assert(mesh);
   assert(v.function_space()->mesh());
   if (mesh->id() != v.function_space()->mesh()->id())
   {
-    throw std::runtime_error(
-        "Interpolation on different meshes not supported (yet).");
+    interpolate_nonmatching(u, v);
+    return;
+  }
+
+  const auto element = u.function_space()->element();
+  assert(element);
+  if (!v.function_space()->has_element(*element))
+  {
+    throw std::runtime_error("Restricting finite elements function in "
+                             "different elements not supported.");
   }
   const int tdim = mesh->topology().dim();
 
@@ -170,6 +235,7 @@ void interpolate_from_any(Function<T>& u, const Function<T>& v)
     for (Eigen::Index i = 0; i < dofs_v.size(); ++i)
       expansion_coefficients[cell_dofs[i]] = v_array[dofs_v[i]];
   }
+  u.x()->increment_version();
 }
 
 } // namespace detail
@@ -5,9 +5,12 @@
 
 #include "BoundingBoxTree.h"
 #include "utils.h"
+#include <algorithm>
+#include <cfloat>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/sort.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/utils.h>
@@ -17,8 +20,21 @@ using namespace dolfinx::geometry;
 
 namespace
 {
+using Node = geometry::BoundingBoxTree::Node;
+
 //-----------------------------------------------------------------------------
-// Compute bounding box of mesh entity
+// Create node with bounding box b and children
+Node create_node(const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b,
+                 std::array<int, 2> children)
+{
+  Node node;
+  std::copy(b.data(), b.data() + 6, node.x.begin());
+  node.children = children;
+  return node;
+}
+//-----------------------------------------------------------------------------
+// Compute bounding box of mesh entity. The connectivity from entities
+// of dimension dim to cells must have been created.
 Eigen::Array<double, 2, 3, Eigen::RowMajor>
 compute_bbox_of_entity(const mesh::Mesh& mesh, int dim, std::int32_t index)
 {
@@ -26,7 +42,6 @@ compute_bbox_of_entity(const mesh::Mesh& mesh, int dim, std::int32_t index)
   const int tdim = mesh.topology().dim();
   const mesh::Geometry& geometry = mesh.geometry();
   const graph::AdjacencyList<std::int32_t>& x_dofmap = geometry.dofmap();
-  mesh.topology_mutable().create_connectivity(dim, tdim);
 
   // Find attached cell
   auto e_to_c = mesh.topology().connectivity(dim, tdim);
@@ -110,9 +125,7 @@ Eigen::Array<double, 2, 3, Eigen::RowMajor> compute_bbox_of_bboxes(
 int _build_from_leaf(
     const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes,
     const std::vector<int>::iterator partition_begin,
-    const std::vector<int>::iterator partition_end,
-    std::vector<std::array<int, 2>>& bboxes,
-    std::vector<double>& bbox_coordinates)
+    const std::vector<int>::iterator partition_end, std::vector<Node>& nodes)
 {
   assert(partition_begin < partition_end);
 
@@ -125,15 +138,10 @@ int _build_from_leaf(
     Eigen::Array<double, 2, 3, Eigen::RowMajor> b
         = leaf_bboxes.block<2, 3>(2 * entity_index, 0);
 
-    // Store bounding box data
-    // bbox[0] = num_bboxes(); // child_0 == node denotes a leaf
-    // bbox[1] = entity_index; // index of entity contained in leaf
-    // return add_bbox(bbox, b);
-    // return add_bbox({num_bboxes(), entity_index}, b);
-    bboxes.push_back({(int)bboxes.size(), entity_index});
-    bbox_coordinates.insert(bbox_coordinates.end(), b.data(), b.data() + 3);
-    bbox_coordinates.insert(bbox_coordinates.end(), b.data() + 3, b.data() + 6);
-    return bboxes.size() - 1;
+    // Store bounding box data. child_0 == node denotes a leaf, and
+    // child_1 is the index of the entity contained in the leaf.
+    nodes.push_back(create_node(b, {(int)nodes.size(), entity_index}));
+    return nodes.size() - 1;
   }
   else
   {
@@ -156,54 +164,138 @@ int _build_from_leaf(
                      });
 
     // Split bounding boxes into two groups and call recursively
-    std::array bbox{_build_from_leaf(leaf_bboxes, partition_begin,
-                                     partition_middle, bboxes,
-                                     bbox_coordinates),
-                    _build_from_leaf(leaf_bboxes, partition_middle,
-                                     partition_end, bboxes, bbox_coordinates)};
+    std::array bbox{
+        _build_from_leaf(leaf_bboxes, partition_begin, partition_middle,
+                         nodes),
+        _build_from_leaf(leaf_bboxes, partition_middle, partition_end, nodes)};
 
     // Store bounding box data. Note that root box will be added last.
-    bboxes.push_back(bbox);
-    bbox_coordinates.insert(bbox_coordinates.end(), b.data(), b.data() + 3);
-    bbox_coordinates.insert(bbox_coordinates.end(), b.data() + 3, b.data() + 6);
-    return bboxes.size() - 1;
+    nodes.push_back(create_node(b, bbox));
+    return nodes.size() - 1;
   }
 }
 //-----------------------------------------------------------------------------
-std::tuple<Eigen::Array<int, Eigen::Dynamic, 2, Eigen::RowMajor>,
-           Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
-build_from_leaf(
+std::vector<Node> build_from_leaf(
     const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes)
 {
   assert(leaf_bboxes.size() % 2 == 0);
   std::vector<int> partition(leaf_bboxes.rows() / 2);
   std::iota(partition.begin(), partition.end(), 0);
 
-  std::vector<std::array<int, 2>> bboxes;
-  std::vector<double> bbox_coordinates;
-  _build_from_leaf(leaf_bboxes, partition.begin(), partition.end(), bboxes,
-                   bbox_coordinates);
+  std::vector<Node> nodes;
+  nodes.reserve(std::max(2 * (int)partition.size() - 1, 0));
+  _build_from_leaf(leaf_bboxes, partition.begin(), partition.end(), nodes);
+  return nodes;
+}
+//-----------------------------------------------------------------------------
+// Build the subtree for the leaves [begin, end) of the leaves sorted
+// by Morton code, splitting at the highest bit in which the codes
+// differ. The sorted codes and the corresponding entity indices are
+// given in codes and entities. The 2 * (end - begin) - 1 nodes of the
+// subtree are stored in post-order from position offset, with the
+// subtree root last, so that the positions of all nodes are known in
+// advance and subtrees can be built in parallel.
+void _build_lbvh(
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes,
+    const std::vector<std::uint64_t>& codes,
+    const std::vector<std::int32_t>& entities, std::int32_t begin,
+    std::int32_t end, std::int32_t offset, std::vector<Node>& nodes)
+{
+  const std::int32_t node = offset + 2 * (end - begin) - 2;
+  if (end - begin == 1)
+  {
+    // Reached leaf. child_0 == node denotes a leaf, and child_1 is the
+    // index of the entity contained in the leaf.
+    const std::int32_t entity_index = entities[begin];
+    nodes[node] = create_node(leaf_bboxes.block<2, 3>(2 * entity_index, 0),
+                              {node, entity_index});
+    return;
+  }
+
+  // Split at the first leaf with the highest differing bit set. If
+  // all codes are equal, split in the middle.
+  const std::uint64_t c0 = codes[begin];
+  const std::uint64_t c1 = codes[end - 1];
+  std::int32_t middle = begin + (end - begin) / 2;
+  if (c0 != c1)
+  {
+    std::uint64_t bit = std::uint64_t(1) << 63;
+    while (!((c0 ^ c1) & bit))
+      bit >>= 1;
+    auto it = std::partition_point(codes.begin() + begin,
+                                   codes.begin() + end,
+                                   [bit](auto code) { return !(code & bit); });
+    middle = std::distance(codes.begin(), it);
+  }
+
+  // Build the subtrees, in parallel for large subtrees
+  const std::int32_t child0 = offset + 2 * (middle - begin) - 2;
+  const std::int32_t child1 = node - 1;
+#pragma omp task default(shared) if (middle - begin > 10000)
+  _build_lbvh(leaf_bboxes, codes, entities, begin, middle, offset, nodes);
+  _build_lbvh(leaf_bboxes, codes, entities, middle, end, child0 + 1, nodes);
+#pragma omp taskwait
+
+  // Bounding box of the children
+  Node& n = nodes[node];
+  for (int j = 0; j < 3; ++j)
+  {
+    n.x[j] = std::min(nodes[child0].x[j], nodes[child1].x[j]);
+    n.x[j + 3] = std::max(nodes[child0].x[j + 3], nodes[child1].x[j + 3]);
+  }
+  n.children = {child0, child1};
+}
+//-----------------------------------------------------------------------------
+// Build linear BVH from leaf boxes: the leaves are sorted by the
+// Morton code of the box centres and the tree is built by recursively
+// splitting the sorted leaves where the codes differ in their highest
+// bit. The nodes are stored in post-order, with the root last.
+std::vector<Node> build_lbvh(
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& leaf_bboxes)
+{
+  assert(leaf_bboxes.size() % 2 == 0);
+  const std::int32_t num_leaves = leaf_bboxes.rows() / 2;
+  if (num_leaves == 0)
+    return std::vector<Node>();
+
+  // Bounds of the box centres
+  Eigen::Array3d x0 = Eigen::Array3d::Constant(DBL_MAX);
+  Eigen::Array3d x1 = Eigen::Array3d::Constant(-DBL_MAX);
+  for (std::int32_t i = 0; i < num_leaves; ++i)
+  {
+    const Eigen::Array3d c
+        = (leaf_bboxes.row(2 * i) + leaf_bboxes.row(2 * i + 1)).transpose();
+    x0 = x0.min(c);
+    x1 = x1.max(c);
+  }
+  const Eigen::Array3d h = (x1 - x0).max(DBL_EPSILON);
 
-  Eigen::Array<int, Eigen::Dynamic, 2, Eigen::RowMajor> bbox_array(
-      bboxes.size(), 2);
-  for (std::size_t i = 0; i < bboxes.size(); ++i)
+  // Compute Morton codes of the box centres on a 2^21 grid, and sort
+  // the leaves by code
+  std::vector<std::uint64_t> codes(num_leaves);
+#pragma omp parallel for schedule(static) if (num_leaves > 10000)
+  for (std::int32_t i = 0; i < num_leaves; ++i)
   {
-    bbox_array(i, 0) = bboxes[i][0];
-    bbox_array(i, 1) = bboxes[i][1];
+    const Eigen::Array3d c
+        = (leaf_bboxes.row(2 * i) + leaf_bboxes.row(2 * i + 1)).transpose();
+    codes[i] = common::morton_code((c - x0) / h);
   }
-  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> bbox_coord_array(
-      bbox_coordinates.size() / 3, 3);
-  std::copy(bbox_coordinates.begin(), bbox_coordinates.end(),
-            bbox_coord_array.data());
+  std::vector<std::int32_t> entities(num_leaves);
+  std::iota(entities.begin(), entities.end(), 0);
+  common::radix_sort(codes, entities, 63);
 
-  return {bbox_array, bbox_coord_array};
+  std::vector<Node> nodes(2 * num_leaves - 1);
+#pragma omp parallel
+#pragma omp single
+  _build_lbvh(leaf_bboxes, codes, entities, 0, num_leaves, 0, nodes);
+
+  return nodes;
 }
 //-----------------------------------------------------------------------------
 int _build_from_point(const std::vector<Eigen::Vector3d>& points,
                       const std::vector<int>::iterator begin,
                       const std::vector<int>::iterator end,
-                      std::vector<std::array<int, 2>>& bboxes,
-                      std::vector<double>& bbox_coordinates)
+                      std::vector<Node>& nodes)
 {
   assert(begin < end);
 
@@ -212,14 +304,14 @@ int _build_from_point(const std::vector<Eigen::Vector3d>& points,
   {
     // Store bounding box data
     const int point_index = *begin;
-    const int c0 = bboxes.size(); // child_0 == node denotes a leaf
-    const int c1 = point_index;   // index of entity contained in leaf
-    bboxes.push_back({c0, c1});
-    bbox_coordinates.insert(bbox_coordinates.end(), points[point_index].data(),
-                            points[point_index].data() + 3);
-    bbox_coordinates.insert(bbox_coordinates.end(), points[point_index].data(),
-                            points[point_index].data() + 3);
-    return bboxes.size() - 1;
+    const int c0 = nodes.size(); // child_0 == node denotes a leaf
+    const int c1 = point_index;  // index of entity contained in leaf
+    Node node;
+    std::copy_n(points[point_index].data(), 3, node.x.begin());
+    std::copy_n(points[point_index].data(), 3, node.x.begin() + 3);
+    node.children = {c0, c1};
+    nodes.push_back(node);
+    return nodes.size() - 1;
   }
 
   // Compute bounding box of all points
@@ -237,29 +329,26 @@ int _build_from_point(const std::vector<Eigen::Vector3d>& points,
   });
 
   // Split bounding boxes into two groups and call recursively
-  std::array bbox{
-      _build_from_point(points, begin, middle, bboxes, bbox_coordinates),
-      _build_from_point(points, middle, end, bboxes, bbox_coordinates)};
+  std::array bbox{_build_from_point(points, begin, middle, nodes),
+                  _build_from_point(points, middle, end, nodes)};
 
   // Store bounding box data. Note that root box will be added last
-  bboxes.push_back(bbox);
-  bbox_coordinates.insert(bbox_coordinates.end(), b.data(), b.data() + 3);
-  bbox_coordinates.insert(bbox_coordinates.end(), b.data() + 3, b.data() + 6);
-  return bboxes.size() - 1;
+  nodes.push_back(create_node(b, bbox));
+  return nodes.size() - 1;
 }
 //-----------------------------------------------------------------------------
 } // namespace
 
 //-----------------------------------------------------------------------------
-BoundingBoxTree::BoundingBoxTree(
-    const Eigen::Array<int, Eigen::Dynamic, 2, Eigen::RowMajor>& bboxes,
-    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& bbox_coords)
-    : _tdim(0), _bboxes(bboxes), _bbox_coordinates(bbox_coords)
+BoundingBoxTree::BoundingBoxTree(std::vector<Node>&& nodes)
+    : _tdim(0), _nodes(std::move(nodes))
 {
   // Do nothing
 }
 //-----------------------------------------------------------------------------
-BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
+BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim,
+                                 TreeBuilder builder)
+    : _tdim(tdim)
 {
   // Check dimension
   if (tdim < 1 or tdim > mesh.topology().dim())
@@ -270,6 +359,7 @@ BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
 
   // Initialize entities of given dimension if they don't exist
   mesh.topology_mutable().create_entities(tdim);
+  mesh.topology_mutable().create_connectivity(tdim, mesh.topology().dim());
 
   // Create bounding boxes for all mesh entities (leaves)
   auto map = mesh.topology().index_map(tdim);
@@ -277,11 +367,22 @@ BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
   const std::int32_t num_leaves = map->size_local() + map->num_ghosts();
   Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> leaf_bboxes(
       2 * num_leaves, 3);
+#pragma omp parallel for schedule(static) if (num_leaves > 10000)
   for (int e = 0; e < num_leaves; ++e)
     leaf_bboxes.block<2, 3>(2 * e, 0) = compute_bbox_of_entity(mesh, tdim, e);
 
-  // Recursively build the bounding box tree from the leaves
-  std::tie(_bboxes, _bbox_coordinates) = build_from_leaf(leaf_bboxes);
+  // Build the bounding box tree from the leaves
+  switch (builder)
+  {
+  case TreeBuilder::median:
+    _nodes = build_from_leaf(leaf_bboxes);
+    break;
+  case TreeBuilder::lbvh:
+    _nodes = build_lbvh(leaf_bboxes);
+    break;
+  default:
+    throw std::runtime_error("Unknown bounding box tree builder.");
+  }
 
   LOG(INFO) << "Computed bounding box tree with " << num_bboxes()
             << " nodes for " << num_leaves << " entities.";
@@ -292,14 +393,13 @@ BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
   if (mpi_size > 1)
   {
     // Send root node coordinates to all processes
-    const auto send_bbox = _bbox_coordinates.bottomRows(2);
+    const std::array<double, 6>& send_bbox = _nodes.back().x;
     Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> recv_bbox(
         mpi_size * 2, 3);
     MPI_Allgather(send_bbox.data(), 6, MPI_DOUBLE, recv_bbox.data(), 6,
                   MPI_DOUBLE, comm);
 
-    auto [global_bboxes, global_coords] = build_from_leaf(recv_bbox);
-    global_tree.reset(new BoundingBoxTree(global_bboxes, global_coords));
+    global_tree.reset(new BoundingBoxTree(build_from_leaf(recv_bbox)));
 
     LOG(INFO) << "Computed global bounding box tree with "
               << global_tree->num_bboxes() << " boxes.";
@@ -315,31 +415,20 @@ BoundingBoxTree::BoundingBoxTree(const std::vector<Eigen::Vector3d>& points)
   std::iota(leaf_partition.begin(), leaf_partition.end(), 0);
 
   // Recursively build the bounding box tree from the leaves
-  std::vector<std::array<int, 2>> bboxes;
-  std::vector<double> bbox_coordinates;
+  _nodes.reserve(std::max(2 * num_leaves - 1, 0));
   _build_from_point(points, leaf_partition.begin(), leaf_partition.end(),
-                    bboxes, bbox_coordinates);
-
-  _bboxes.resize(bboxes.size(), 2);
-  for (std::size_t i = 0; i < bboxes.size(); ++i)
-  {
-    _bboxes(i, 0) = bboxes[i][0];
-    _bboxes(i, 1) = bboxes[i][1];
-  }
-  _bbox_coordinates
-      = Eigen::Map<Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>(
-          bbox_coordinates.data(), bbox_coordinates.size() / 3, 3);
+                    _nodes);
 
   LOG(INFO) << "Computed bounding box tree with " << num_bboxes()
             << " nodes for " << num_leaves << " points.";
 }
 //-----------------------------------------------------------------------------
-int BoundingBoxTree::num_bboxes() const { return _bboxes.rows(); }
+int BoundingBoxTree::num_bboxes() const { return _nodes.size(); }
 //-----------------------------------------------------------------------------
 std::string BoundingBoxTree::str() const
 {
   std::stringstream s;
-  tree_print(s, _bboxes.rows() - 1);
+  tree_print(s, _nodes.size() - 1);
   return s.str();
 }
 //-----------------------------------------------------------------------------
@@ -349,24 +438,19 @@ void BoundingBoxTree::tree_print(std::stringstream& s, int i) const
 {
   s << "[";
   for (int j = 0; j < 3; ++j)
-    s << _bbox_coordinates(i, j) << " ";
+    s << _nodes[i].x[j] << " ";
   s << "]\n";
 
-  if (_bboxes(i, 0) == i)
-    s << "leaf containing entity (" << _bboxes(i, 1) << ")";
+  const std::array<int, 2>& children = _nodes[i].children;
+  if (children[0] == i)
+    s << "leaf containing entity (" << children[1] << ")";
   else
   {
     s << "{";
-    tree_print(s, _bboxes(i, 0));
+    tree_print(s, children[0]);
     s << ", \n";
-    tree_print(s, _bboxes(i, 1));
+    tree_print(s, children[1]);
     s << "}\n";
   }
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<double, 2, 3, Eigen::RowMajor>
-BoundingBoxTree::get_bbox(int node) const
-{
-  return _bbox_coordinates.block<2, 3>(2 * node, 0);
-}
-//-----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 
 #include <Eigen/Dense>
 #include <array>
+#include <cassert>
 #include <memory>
 #include <vector>
 
@@ -23,6 +24,13 @@ class Mesh;
 namespace geometry
 {
 
+/// Algorithms for building a BoundingBoxTree
+enum class TreeBuilder
+{
+  median, ///< Recursive split at the median along the longest axis
+  lbvh    ///< Linear BVH, split by the Morton codes of the box centres
+};
+
 /// Axis-Aligned bounding box binary tree. It is used to find entities
 /// in a collection (often a mesh::Mesh).
 
@@ -30,11 +38,30 @@ class BoundingBoxTree
 {
 
 public:
+  /// Bounding box tree node. Each node is padded to a cache line and
+  /// holds the box coordinates together with the child node indices.
+  /// For leaf nodes, children[0] is equal to the node index and
+  /// children[1] is the index of the entity that the leaf box bounds.
+  struct alignas(64) Node
+  {
+    /// Lower corner (x[0], x[1], x[2]) and upper corner (x[3], x[4],
+    /// x[5]) of the box
+    std::array<double, 6> x;
+
+    /// Child node indices
+    std::array<int, 2> children;
+  };
+
   /// Constructor
   /// @param[in] mesh The mesh for building the bounding box tree
   /// @param[in] tdim The topological dimension of the mesh entities to
   ///                 by the bounding box tree for
-  BoundingBoxTree(const mesh::Mesh& mesh, int tdim);
+  /// @param[in] builder The algorithm used to build the tree. The
+  ///   linear BVH builder (TreeBuilder::lbvh) is considerably faster
+  ///   for large meshes, while the median split builder creates trees
+  ///   with slightly tighter boxes.
+  BoundingBoxTree(const mesh::Mesh& mesh, int tdim,
+                  TreeBuilder builder = TreeBuilder::median);
 
   /// Constructor
   /// @param[in] points Cloud of points to build the bounding box tree
@@ -57,7 +84,12 @@ public:
   /// @param[in] node The bounding box node index
   /// @return The bounding box where row(0) is the lower corner and
   ///         row(1) is the upper corner
-  Eigen::Array<double, 2, 3, Eigen::RowMajor> get_bbox(int node) const;
+  Eigen::Array<double, 2, 3, Eigen::RowMajor> get_bbox(int node) const
+  {
+    assert(node < (int)_nodes.size());
+    return Eigen::Map<const Eigen::Array<double, 2, 3, Eigen::RowMajor>>(
+        _nodes[node].x.data());
+  }
 
   /// Return number of bounding boxes
   int num_bboxes() const;
@@ -76,16 +108,13 @@ public:
   ///         index of the cell that it bounds,
   std::array<int, 2> bbox(int node) const
   {
-    assert(node < (int)_bboxes.rows());
-    return {_bboxes(node, 0), _bboxes(node, 1)};
+    assert(node < (int)_nodes.size());
+    return _nodes[node].children;
   }
 
 private:
   // Constructor
-  BoundingBoxTree(
-      const Eigen::Array<int, Eigen::Dynamic, 2, Eigen::RowMajor>& bboxes,
-      const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
-          bbox_coords);
+  BoundingBoxTree(std::vector<Node>&& nodes);
 
   // Topological dimension of leaf entities
   int _tdim;
@@ -93,11 +122,8 @@ private:
   // Print out recursively, for debugging
   void tree_print(std::stringstream& s, int i) const;
 
-  // List of bounding boxes (parent-child-entity relations)
-  Eigen::Array<int, Eigen::Dynamic, 2, Eigen::RowMajor> _bboxes;
-
-  // List of bounding box coordinates
-  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> _bbox_coordinates;
+  // Nodes, with the root node last
+  std::vector<Node> _nodes;
 
 public:
   /// Global tree for mesh ownership of each process (same on all
@@ -0,0 +1,210 @@
+// Copyright (C) 2026 The DOLFINX authors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "PointOwnership.h"
+#include "BoundingBoxTree.h"
+#include "utils.h"
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <numeric>
+
+using namespace dolfinx;
+using namespace dolfinx::geometry;
+
+//-----------------------------------------------------------------------------
+PointOwnership::PointOwnership(
+    const mesh::Mesh& mesh, const BoundingBoxTree& tree,
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x)
+    : _comm(MPI_COMM_NULL, false)
+{
+  common::Timer timer("Compute point ownership");
+
+  const int tdim = mesh.topology().dim();
+  if (tree.tdim() != tdim)
+  {
+    throw std::runtime_error(
+        "Bounding box tree must be built for the cells of the mesh.");
+  }
+
+  MPI_Comm comm = mesh.mpi_comm();
+  const std::int32_t num_points = x.rows();
+
+  // Compute the candidate processes for each point, i.e. the processes
+  // whose bounding box contains the point
+  graph::AdjacencyList<std::int32_t> point_to_rank(0);
+  if (tree.global_tree)
+    point_to_rank = compute_collisions(*tree.global_tree, x);
+  else
+  {
+    point_to_rank = graph::AdjacencyList<std::int32_t>(
+        Eigen::Array<std::int32_t, Eigen::Dynamic, 1>::Zero(num_points),
+        Eigen::Array<std::int32_t, Eigen::Dynamic, 1>::LinSpaced(
+            num_points + 1, 0, num_points));
+  }
+
+  // Order the (rank, point) pairs by rank, and the points by index for
+  // each rank
+  const int size = dolfinx::MPI::size(comm);
+  std::vector<std::int32_t> rank_offsets(size + 1, 0);
+  for (Eigen::Index i = 0; i < point_to_rank.array().rows(); ++i)
+    ++rank_offsets[point_to_rank.array()[i] + 1];
+  std::partial_sum(rank_offsets.begin(), rank_offsets.end(),
+                   rank_offsets.begin());
+  std::vector<std::int32_t> sent_points(rank_offsets.back());
+  {
+    std::vector<std::int32_t> pos(rank_offsets.begin(), rank_offsets.end() - 1);
+    for (std::int32_t p = 0; p < num_points; ++p)
+    {
+      auto ranks = point_to_rank.links(p);
+      for (Eigen::Index j = 0; j < ranks.rows(); ++j)
+        sent_points[pos[ranks[j]]++] = p;
+    }
+  }
+
+  // Pack the point coordinates for each candidate process
+  std::vector<int> dest;
+  std::vector<std::int32_t> dest_offsets(1, 0);
+  for (int r = 0; r < size; ++r)
+  {
+    if (rank_offsets[r + 1] > rank_offsets[r])
+    {
+      dest.push_back(r);
+      dest_offsets.push_back(rank_offsets[r + 1]);
+    }
+  }
+  Eigen::Array<double, Eigen::Dynamic, 1> send_x(3 * sent_points.size());
+  for (std::size_t i = 0; i < sent_points.size(); ++i)
+    send_x.segment<3>(3 * i) = x.row(sent_points[i]).transpose();
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> send_x_offsets(dest.size()
+                                                                + 1);
+  for (std::size_t i = 0; i < dest_offsets.size(); ++i)
+    send_x_offsets[i] = 3 * dest_offsets[i];
+
+  // Send points to the candidate processes
+  const auto [src, recv_x] = dolfinx::MPI::sparse_all_to_all(
+      comm, dest,
+      graph::AdjacencyList<double>(std::move(send_x),
+                                   std::move(send_x_offsets)));
+
+  // Locate the received points in the owned cells of this process
+  const std::int32_t num_recv = recv_x.array().rows() / 3;
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> points
+      = Eigen::Map<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                      Eigen::RowMajor>>(
+          recv_x.array().data(), num_recv, 3);
+  auto map = mesh.topology().index_map(tdim);
+  assert(map);
+  const std::int32_t num_owned_cells = map->size_local();
+  const graph::AdjacencyList<std::int32_t> candidates
+      = compute_collisions(tree, points);
+  std::vector<std::int32_t> owned_candidates, owned_candidates_offsets(1, 0);
+  for (std::int32_t p = 0; p < num_recv; ++p)
+  {
+    auto cells = candidates.links(p);
+    for (Eigen::Index j = 0; j < cells.rows(); ++j)
+      if (cells[j] < num_owned_cells)
+        owned_candidates.push_back(cells[j]);
+    owned_candidates_offsets.push_back(owned_candidates.size());
+  }
+  const graph::AdjacencyList<std::int32_t> colliding_cells
+      = select_colliding_cells(
+          mesh,
+          graph::AdjacencyList<std::int32_t>(owned_candidates,
+                                             owned_candidates_offsets),
+          points, 1);
+
+  // Return whether each point was found to the sending processes
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> found(num_recv);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> found_offsets
+      = recv_x.offsets() / 3;
+  for (std::int32_t p = 0; p < num_recv; ++p)
+    found[p] = colliding_cells.num_links(p) > 0;
+  const auto [found_src, found_data] = dolfinx::MPI::sparse_all_to_all(
+      comm, src, graph::AdjacencyList<std::int32_t>(found, found_offsets));
+  assert(found_src == dest);
+
+  // Assign each point to the lowest ranked process that found it. The
+  // received data is ordered by rank, then by point index.
+  _owners.resize(num_points, -1);
+  for (std::size_t i = 0; i < dest.size(); ++i)
+  {
+    for (std::int32_t j = dest_offsets[i]; j < dest_offsets[i + 1]; ++j)
+    {
+      const std::int32_t p = sent_points[j];
+      if (found_data.array()[j] and _owners[p] < 0)
+        _owners[p] = dest[i];
+    }
+  }
+
+  // Tell the candidate processes which points they own, and compute
+  // the position of each point in the data returned by the owners
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> accepted(sent_points.size());
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> accepted_offsets(dest.size()
+                                                                  + 1);
+  std::vector<int> sources;
+  _recv_pos.resize(num_points, -1);
+  std::int32_t pos = 0;
+  for (std::size_t i = 0; i < dest.size(); ++i)
+  {
+    accepted_offsets[i] = dest_offsets[i];
+    const std::int32_t pos0 = pos;
+    for (std::int32_t j = dest_offsets[i]; j < dest_offsets[i + 1]; ++j)
+    {
+      const std::int32_t p = sent_points[j];
+      accepted[j] = (_owners[p] == dest[i]);
+      if (accepted[j])
+        _recv_pos[p] = pos++;
+    }
+    if (pos > pos0)
+    {
+      sources.push_back(dest[i]);
+      _recv_sizes.push_back(pos - pos0);
+    }
+  }
+  accepted_offsets[dest.size()] = dest_offsets.back();
+  const auto [accepted_src, accepted_data] = dolfinx::MPI::sparse_all_to_all(
+      comm, dest,
+      graph::AdjacencyList<std::int32_t>(std::move(accepted),
+                                         std::move(accepted_offsets)));
+  assert(accepted_src == src);
+
+  // Store the points owned by this process and their cells, ordered by
+  // the process that sent them
+  std::vector<int> destinations;
+  std::vector<std::int32_t> owned;
+  for (std::size_t i = 0; i < src.size(); ++i)
+  {
+    const std::size_t num_owned = owned.size();
+    for (std::int32_t p = found_offsets[i]; p < found_offsets[i + 1]; ++p)
+      if (accepted_data.array()[p])
+        owned.push_back(p);
+    if (owned.size() > num_owned)
+    {
+      destinations.push_back(src[i]);
+      _send_sizes.push_back(owned.size() - num_owned);
+    }
+  }
+  _points.resize(owned.size(), 3);
+  _cells.resize(owned.size());
+  for (std::size_t i = 0; i < owned.size(); ++i)
+  {
+    _points.row(i) = points.row(owned[i]);
+    _cells[i] = colliding_cells.links(owned[i])[0];
+  }
+
+  // Create neighbourhood communicator for returning data from the
+  // owners
+  MPI_Comm neighbor_comm;
+  MPI_Dist_graph_create_adjacent(comm, sources.size(), sources.data(),
+                                 MPI_UNWEIGHTED, destinations.size(),
+                                 destinations.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neighbor_comm);
+  _comm = dolfinx::MPI::Comm(neighbor_comm, false);
+}
+//-----------------------------------------------------------------------------
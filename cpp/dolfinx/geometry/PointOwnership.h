@@ -0,0 +1,159 @@
+// Copyright (C) 2026 The DOLFINX authors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace mesh
+{
+class Mesh;
+} // namespace mesh
+
+namespace geometry
+{
+class BoundingBoxTree;
+
+/// Distributed ownership of a set of points in a mesh. Each process
+/// passes an arbitrary set of points. The points are sent to the
+/// processes whose bounding box contains them, located in the owned
+/// cells of these processes, and each point is assigned to the lowest
+/// ranked process that has a cell containing it.
+///
+/// The ownership is computed once and can be used repeatedly to return
+/// data computed at the points on the owning processes (e.g. values of
+/// a Function) to the processes that passed the points (see
+/// PointOwnership::gather). The return of data uses neighbourhood
+/// communication, so the cost depends only on the number of processes
+/// that exchange points.
+
+class PointOwnership
+{
+public:
+  /// Compute the ownership of points (collective)
+  /// @param[in] mesh The mesh
+  /// @param[in] tree Bounding box tree for the cells of @p mesh
+  /// @param[in] x The points on this process (shape=(num_points, 3))
+  PointOwnership(
+      const mesh::Mesh& mesh, const BoundingBoxTree& tree,
+      const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x);
+
+  /// Copy constructor
+  PointOwnership(const PointOwnership& ownership) = delete;
+
+  /// Move constructor
+  PointOwnership(PointOwnership&& ownership) = default;
+
+  /// Destructor
+  ~PointOwnership() = default;
+
+  /// Copy assignment
+  PointOwnership& operator=(const PointOwnership& ownership) = delete;
+
+  /// Move assignment
+  PointOwnership& operator=(PointOwnership&& ownership) = default;
+
+  /// Number of points passed on this process
+  std::int32_t num_points() const { return _recv_pos.size(); }
+
+  /// The rank of the owning process of each point passed on this
+  /// process. The owner is -1 for points that are not in the mesh.
+  const std::vector<int>& owners() const { return _owners; }
+
+  /// The points owned by this process, i.e. the points for which data
+  /// is computed on this process (shape=(num_owned_points, 3))
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
+  points() const
+  {
+    return _points;
+  }
+
+  /// The local cells containing the points owned by this process
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& cells() const
+  {
+    return _cells;
+  }
+
+  /// Send data computed at the points owned by this process to the
+  /// processes that passed the points (collective)
+  /// @param[in] values The data at the points owned by this process,
+  ///   one row for each point in PointOwnership::points. The number of
+  ///   columns must be the same on all processes.
+  /// @return The data for each point passed on this process. The rows
+  ///   for points that are not in the mesh are zero.
+  template <typename T>
+  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  gather(const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+             values) const
+  {
+    if (values.rows() != _points.rows())
+    {
+      throw std::runtime_error(
+          "Number of values does not match number of owned points.");
+    }
+
+    const int n = values.cols();
+    std::vector<int> send_sizes(_send_sizes.size()), send_disp(1, 0);
+    for (std::size_t i = 0; i < _send_sizes.size(); ++i)
+    {
+      send_sizes[i] = n * _send_sizes[i];
+      send_disp.push_back(send_disp.back() + send_sizes[i]);
+    }
+    std::vector<int> recv_sizes(_recv_sizes.size()), recv_disp(1, 0);
+    for (std::size_t i = 0; i < _recv_sizes.size(); ++i)
+    {
+      recv_sizes[i] = n * _recv_sizes[i];
+      recv_disp.push_back(recv_disp.back() + recv_sizes[i]);
+    }
+
+    Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> recv(
+        recv_disp.back() / std::max(n, 1), n);
+    MPI_Neighbor_alltoallv(values.data(), send_sizes.data(), send_disp.data(),
+                           MPI::mpi_type<T>(), recv.data(), recv_sizes.data(),
+                           recv_disp.data(), MPI::mpi_type<T>(),
+                           _comm.comm());
+
+    Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> u
+        = Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>::Zero(_recv_pos.size(), n);
+    for (std::size_t p = 0; p < _recv_pos.size(); ++p)
+    {
+      if (_recv_pos[p] >= 0)
+        u.row(p) = recv.row(_recv_pos[p]);
+    }
+
+    return u;
+  }
+
+private:
+  // Neighbourhood communicator from the owning processes to the
+  // processes that passed the points
+  dolfinx::MPI::Comm _comm;
+
+  // Owning rank of each point passed on this process
+  std::vector<int> _owners;
+
+  // Position of the data for each point passed on this process in the
+  // data received from the owners (-1 if not in the mesh)
+  std::vector<std::int32_t> _recv_pos;
+
+  // Points owned by this process and the cells containing them,
+  // ordered by the process that passed them
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> _points;
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _cells;
+
+  // Number of owned points for each destination and number of points
+  // owned by each source of the neighbourhood communicator
+  std::vector<int> _send_sizes, _recv_sizes;
+};
+
+} // namespace geometry
+} // namespace dolfinx
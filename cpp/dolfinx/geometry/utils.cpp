@@ -8,11 +8,19 @@
 #include "utils.h"
 #include "BoundingBoxTree.h"
 #include "GJK.h"
+#include <algorithm>
+#include <cfloat>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/sort.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/utils.h>
+#include <numeric>
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
 
 using namespace dolfinx;
 
@@ -162,6 +170,62 @@ void _compute_collisions_point(const geometry::BoundingBoxTree& tree,
   }
 }
 //-----------------------------------------------------------------------------
+// Compute collisions with point, traversing the tree with an explicit
+// stack. The leaves are found in the same order as by
+// _compute_collisions_point.
+void compute_collisions_point_stack(const geometry::BoundingBoxTree& tree,
+                                    const Eigen::Vector3d& p,
+                                    std::vector<int>& stack,
+                                    std::vector<std::int32_t>& entities)
+{
+  stack.clear();
+  stack.push_back(tree.num_bboxes() - 1);
+  while (!stack.empty())
+  {
+    const int node = stack.back();
+    stack.pop_back();
+    if (!point_in_bbox(tree.get_bbox(node), p))
+      continue;
+
+    // child_1 denotes entity for leaves. For other nodes, push the
+    // children such that child_0 is visited first.
+    const std::array bbox = tree.bbox(node);
+    if (is_leaf(bbox, node))
+      entities.push_back(bbox[1]);
+    else
+    {
+      stack.push_back(bbox[1]);
+      stack.push_back(bbox[0]);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+// Compute the order of points along a Morton (Z-order) curve through
+// the bounding box of the points
+std::vector<std::int32_t> compute_morton_order(
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& points)
+{
+  const std::int32_t num_points = points.rows();
+  if (num_points == 0)
+    return std::vector<std::int32_t>();
+
+  // Sort points by the Morton code of the coordinates scaled to the
+  // unit cube
+  const Eigen::Array3d x0 = points.colwise().minCoeff();
+  const Eigen::Array3d h
+      = (points.colwise().maxCoeff().transpose() - x0).max(DBL_EPSILON);
+  std::vector<std::uint64_t> keys(num_points);
+#pragma omp parallel for schedule(static) if (num_points > 10000)
+  for (std::int32_t i = 0; i < num_points; ++i)
+    keys[i] = common::morton_code((points.row(i).transpose() - x0) / h);
+
+  std::vector<std::int32_t> order(num_points);
+  std::iota(order.begin(), order.end(), 0);
+  common::radix_sort(keys, order, 63);
+
+  return order;
+}
+//-----------------------------------------------------------------------------
 // Compute collisions with tree (recursive)
 void _compute_collisions_tree(const geometry::BoundingBoxTree& A,
                               const geometry::BoundingBoxTree& B, int node_A,
@@ -261,6 +325,73 @@ std::vector<int> geometry::compute_collisions(const BoundingBoxTree& tree,
   return entities;
 }
 //-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> geometry::compute_collisions(
+    const BoundingBoxTree& tree,
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& points)
+{
+  const std::int32_t num_points = points.rows();
+  if (num_points == 0 or tree.num_bboxes() == 0)
+  {
+    return graph::AdjacencyList<std::int32_t>(
+        std::vector<std::int32_t>(),
+        std::vector<std::int32_t>(num_points + 1, 0));
+  }
+
+  // Visit the points along a space-filling curve, such that
+  // consecutive queries traverse similar paths through the tree
+  const std::vector<std::int32_t> order = compute_morton_order(points);
+
+  // Threads work on contiguous chunks of the ordered points, with a
+  // buffer of colliding entities for each thread
+#ifdef HAS_OPENMP
+  const int num_threads = num_points > 1000 ? omp_get_max_threads() : 1;
+#else
+  const int num_threads = 1;
+#endif
+  std::vector<std::vector<std::int32_t>> entities(num_threads);
+
+  // Position in the thread buffer of the entities for each point, and
+  // the thread
+  std::vector<std::int32_t> pos(num_points), thread(num_points);
+  std::vector<std::int32_t> offsets(num_points + 1, 0);
+#pragma omp parallel num_threads(num_threads)
+  {
+#ifdef HAS_OPENMP
+    const int t = omp_get_thread_num();
+#else
+    const int t = 0;
+#endif
+    const std::int32_t i0 = (std::int64_t)num_points * t / num_threads;
+    const std::int32_t i1 = (std::int64_t)num_points * (t + 1) / num_threads;
+    std::vector<std::int32_t>& data = entities[t];
+    std::vector<int> stack;
+    for (std::int32_t i = i0; i < i1; ++i)
+    {
+      const std::int32_t p = order[i];
+      const std::size_t start = data.size();
+      compute_collisions_point_stack(tree, points.row(p).transpose().matrix(),
+                                     stack, data);
+      pos[p] = start;
+      thread[p] = t;
+      offsets[p + 1] = data.size() - start;
+    }
+  }
+
+  // Assemble the adjacency list in the original point order
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::int32_t> array(offsets.back());
+#pragma omp parallel for schedule(static) if (num_points > 1000)
+  for (std::int32_t p = 0; p < num_points; ++p)
+  {
+    const std::int32_t* data = entities[thread[p]].data() + pos[p];
+    std::copy(data, data + offsets[p + 1] - offsets[p],
+              array.begin() + offsets[p]);
+  }
+
+  return graph::AdjacencyList<std::int32_t>(std::move(array),
+                                            std::move(offsets));
+}
+//-----------------------------------------------------------------------------
 std::vector<int>
 geometry::compute_process_collisions(const geometry::BoundingBoxTree& tree,
                                      const Eigen::Vector3d& p)
@@ -411,3 +542,58 @@ geometry::select_colliding_cells(const dolfinx::mesh::Mesh& mesh,
   return result;
 }
 //-------------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> geometry::select_colliding_cells(
+    const dolfinx::mesh::Mesh& mesh,
+    const graph::AdjacencyList<std::int32_t>& candidate_cells,
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& points,
+    int n)
+{
+  const std::int32_t num_points = points.rows();
+  if (candidate_cells.num_nodes() != num_points)
+  {
+    throw std::runtime_error(
+        "Number of candidate cell lists does not match number of points.");
+  }
+
+  // Colliding cells are a subset of the candidates, so the results are
+  // written in place into a copy of the candidate list and compacted
+  // afterwards
+  const int tdim = mesh.topology().dim();
+  const double eps2 = 1e-20;
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& candidate_offsets
+      = candidate_cells.offsets();
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> cells
+      = candidate_cells.array();
+  std::vector<std::int32_t> offsets(num_points + 1, 0);
+#pragma omp parallel for schedule(dynamic, 64) if (num_points > 1000)
+  for (std::int32_t p = 0; p < num_points; ++p)
+  {
+    const Eigen::Vector3d x = points.row(p).transpose().matrix();
+    std::int32_t* result = cells.data() + candidate_offsets[p];
+    int count = 0;
+    for (std::int32_t j = candidate_offsets[p]; j < candidate_offsets[p + 1];
+         ++j)
+    {
+      const std::int32_t c = candidate_cells.array()[j];
+      if (squared_distance(mesh, tdim, c, x) < eps2)
+      {
+        result[count++] = c;
+        if (count == n)
+          break;
+      }
+    }
+    offsets[p + 1] = count;
+  }
+
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::int32_t> array(offsets.back());
+  for (std::int32_t p = 0; p < num_points; ++p)
+  {
+    std::copy_n(cells.data() + candidate_offsets[p],
+                offsets[p + 1] - offsets[p], array.begin() + offsets[p]);
+  }
+
+  return graph::AdjacencyList<std::int32_t>(std::move(array),
+                                            std::move(offsets));
+}
+//-------------------------------------------------------------------------------
@@ -7,6 +7,9 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <array>
+#include <cstdint>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <utility>
 #include <vector>
 
@@ -40,6 +43,19 @@ compute_collisions(const BoundingBoxTree& tree0, const BoundingBoxTree& tree1);
 std::vector<int> compute_collisions(const BoundingBoxTree& tree,
                                     const Eigen::Vector3d& p);
 
+/// Compute all collisions between bounding boxes and a set of points.
+/// The tree is traversed without recursion, and the points are
+/// processed in the order of a space-filling (Morton) curve through
+/// their bounding box, in parallel if OpenMP is enabled.
+/// @param[in] tree The bounding box tree
+/// @param[in] points The points (shape=(num_points, 3))
+/// @return For each point, the bounding box leaves that contain the
+///   point. The leaves for each point are in the same order as
+///   returned by compute_collisions for a single point.
+graph::AdjacencyList<std::int32_t> compute_collisions(
+    const BoundingBoxTree& tree,
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& points);
+
 /// Compute all collisions between processes and Point returning a
 /// list of process ranks
 std::vector<int> compute_process_collisions(const BoundingBoxTree& tree,
@@ -93,5 +109,23 @@ double squared_distance(const mesh::Mesh& mesh, int dim, std::int32_t index,
 std::vector<int> select_colliding_cells(const dolfinx::mesh::Mesh& mesh,
                                         const std::vector<int>& candidate_cells,
                                         const Eigen::Vector3d& point, int n);
+
+/// From the given Mesh, select for each point up to n cells from its
+/// candidate cells which actually collide with the point. This is the
+/// batched version of select_colliding_cells, which processes the
+/// points in parallel if OpenMP is enabled.
+/// @param[in] mesh Mesh
+/// @param[in] candidate_cells Cell indices to test for each point,
+///   e.g. as computed by compute_collisions for a set of points
+/// @param[in] points Points to check for collision (shape=(num_points,
+///   3))
+/// @param[in] n Maximum number of positive results to return for each
+///   point. If zero, all colliding cells are returned.
+/// @return For each point, the cells which collide with the point
+graph::AdjacencyList<std::int32_t> select_colliding_cells(
+    const dolfinx::mesh::Mesh& mesh,
+    const graph::AdjacencyList<std::int32_t>& candidate_cells,
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& points,
+    int n);
 } // namespace geometry
 } // namespace dolfinx
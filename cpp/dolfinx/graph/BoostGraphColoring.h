@@ -6,20 +6,16 @@
 
 #pragma once
 
-#include "Graph.h"
+#include "AdjacencyList.h"
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/compressed_sparse_row_graph.hpp>
 #include <boost/graph/sequential_vertex_coloring.hpp>
+#include <cstdint>
 #include <dolfinx/common/Timer.h>
-#include <iostream>
+#include <utility>
 #include <vector>
 
-namespace dolfinx
-{
-
-class Mesh;
-
-namespace graph
+namespace dolfinx::graph
 {
 
 /// This class colors a graph using the Boost Graph Library.
@@ -29,12 +25,15 @@ class BoostGraphColoring
 
 public:
   /// Compute vertex colors
+  /// @param[in] graph The graph to color. Self-edges are ignored.
+  /// @param[out] colors The color of each vertex in the graph
+  /// @return The number of colors
   template <typename ColorType>
   static std::size_t
-  compute_local_vertex_coloring(const Graph& graph,
+  compute_local_vertex_coloring(const AdjacencyList<std::int32_t>& graph,
                                 std::vector<ColorType>& colors)
   {
-    Timer timer("Boost graph coloring (from dolfinx::graph)");
+    common::Timer timer("Boost graph coloring (from dolfinx::graph)");
 
     // Typedef for Boost compressed sparse row graph
     typedef boost::compressed_sparse_row_graph<
@@ -42,27 +41,21 @@ public:
         BoostGraph;
 
     // Number of vertices
-    const std::size_t n = graph.size();
-
-    // Count number of edges
-    Graph::const_iterator vertex;
-    std::size_t num_edges = 0;
-    for (vertex = graph.begin(); vertex != graph.end(); ++vertex)
-      num_edges += vertex->size();
+    const std::int32_t n = graph.num_nodes();
 
     // Build list of graph edges
     std::vector<std::pair<std::size_t, std::size_t>> edges;
-    edges.reserve(num_edges);
-    graph_set_type::const_iterator edge;
-    for (vertex = graph.begin(); vertex != graph.end(); ++vertex)
+    edges.reserve(graph.array().rows());
+    for (std::int32_t v = 0; v < n; ++v)
     {
-      for (edge = vertex->begin(); edge != vertex->end(); ++edge)
+      auto links = graph.links(v);
+      for (Eigen::Index e = 0; e < links.rows(); ++e)
       {
-        const std::size_t vertex_index = vertex - graph.begin();
-        if (vertex_index != (std::size_t)*edge)
-          edges.push_back(std::pair(vertex_index, *edge));
+        if (v != links[e])
+          edges.push_back(std::pair(v, links[e]));
       }
     }
+
     // Build Boost graph
     const BoostGraph g(boost::edges_are_unsorted_multi_pass, edges.begin(),
                        edges.end(), n);
@@ -79,7 +72,7 @@ public:
   static std::size_t
   compute_local_vertex_coloring(const T& graph, std::vector<ColorType>& colors)
   {
-    Timer timer("Boost graph coloring");
+    common::Timer timer("Boost graph coloring");
 
     // Number of vertices in graph
     const std::size_t num_vertices = boost::num_vertices(graph);
@@ -95,7 +88,7 @@ public:
     // Color vertices
     std::vector<vert_size_type> _colors(num_vertices);
     boost::iterator_property_map<vert_size_type*, vert_index_map> color(
-        &_colors.front(), get(boost::vertex_index, graph));
+        _colors.data(), get(boost::vertex_index, graph));
     const vert_size_type num_colors = sequential_vertex_coloring(graph, color);
 
     // Copy colors and return
@@ -103,5 +96,4 @@ public:
     return num_colors;
   }
 };
-} // namespace graph
-} // namespace dolfinx
+} // namespace dolfinx::graph
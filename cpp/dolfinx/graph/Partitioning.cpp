@@ -76,94 +76,82 @@ Partitioning::reorder_global_indices(
     }
   }
 
-  // Send/receive number of indices to communicate to each process
-  std::vector<int> number_recv(size);
-  MPI_Alltoall(number_send.data(), 1, MPI_INT, number_recv.data(), 1, MPI_INT,
-               comm);
-
-  // Compute receive displacements
-  std::vector<int> disp_recv(size + 1, 0);
-  std::partial_sum(number_recv.begin(), number_recv.end(),
-                   disp_recv.begin() + 1);
-
-  // Send/receive global indices
-  std::vector<std::int64_t> vertices_recv(disp_recv.back());
-  MPI_Alltoallv(indices_send.data(), number_send.data(), disp_send.data(),
-                MPI::mpi_type<std::int64_t>(), vertices_recv.data(),
-                number_recv.data(), disp_recv.data(),
-                MPI::mpi_type<std::int64_t>(), comm);
+  // Send/receive global indices. Only ranks that exchange indices
+  // communicate.
+  std::vector<int> dest;
+  std::vector<std::int32_t> dest_offsets(1, 0);
+  for (int p = 0; p < size; ++p)
+  {
+    if (number_send[p] > 0)
+    {
+      dest.push_back(p);
+      dest_offsets.push_back(disp_send[p + 1]);
+    }
+  }
+  const auto [src, vertices_recv] = dolfinx::MPI::sparse_all_to_all(
+      comm, dest,
+      graph::AdjacencyList<std::int64_t>(indices_send, dest_offsets));
 
   // Build list of sharing processes for each vertex
   const std::array range
       = dolfinx::MPI::local_range(rank, max_global_index + 1, size);
   std::vector<std::set<int>> owners(range[1] - range[0]);
-  for (int i = 0; i < size; ++i)
+  for (std::size_t i = 0; i < src.size(); ++i)
   {
-    assert((i + 1) < (int)disp_recv.size());
-    for (int j = disp_recv[i]; j < disp_recv[i + 1]; ++j)
+    auto vertices = vertices_recv.links(i);
+    for (Eigen::Index j = 0; j < vertices.rows(); ++j)
     {
       // Get back to 'zero' reference index
-      assert(j < (int)vertices_recv.size());
-      const std::int64_t index = vertices_recv[j] - range[0];
+      const std::int64_t index = vertices[j] - range[0];
 
       assert(index < (int)owners.size());
-      owners[index].insert(i);
+      owners[index].insert(src[i]);
     }
   }
 
   // For each index, build list of sharing processes
   std::unordered_map<std::int64_t, std::set<int>> global_vertex_to_procs;
-  for (int i = 0; i < size; ++i)
+  for (std::size_t i = 0; i < src.size(); ++i)
   {
-    for (int j = disp_recv[i]; j < disp_recv[i + 1]; ++j)
-      global_vertex_to_procs[vertices_recv[j]].insert(i);
+    auto vertices = vertices_recv.links(i);
+    for (Eigen::Index j = 0; j < vertices.rows(); ++j)
+      global_vertex_to_procs[vertices[j]].insert(src[i]);
   }
 
   // For vertices on this process, get list of sharing process
   std::unique_ptr<const graph::AdjacencyList<int>> sharing_processes;
   {
     // Pack process that share each vertex
-    std::vector<int> data_send, disp_send(size + 1, 0), num_send(size);
-    for (int p = 0; p < size; ++p)
+    std::vector<int> data_send;
+    std::vector<std::int32_t> disp_send(1, 0);
+    for (std::size_t i = 0; i < src.size(); ++i)
     {
-      for (int j = disp_recv[p]; j < disp_recv[p + 1]; ++j)
+      auto vertices = vertices_recv.links(i);
+      for (Eigen::Index j = 0; j < vertices.rows(); ++j)
       {
-        const std::int64_t vertex = vertices_recv[j];
-        auto it = global_vertex_to_procs.find(vertex);
+        auto it = global_vertex_to_procs.find(vertices[j]);
         assert(it != global_vertex_to_procs.end());
         data_send.push_back(it->second.size());
         data_send.insert(data_send.end(), it->second.begin(), it->second.end());
       }
-      disp_send[p + 1] = data_send.size();
-      num_send[p] = disp_send[p + 1] - disp_send[p];
+      disp_send.push_back(data_send.size());
     }
 
-    // Send/receive number of process that 'share' each vertex
-    std::vector<int> num_recv(size);
-    MPI_Alltoall(num_send.data(), 1, MPI_INT, num_recv.data(), 1, MPI_INT,
-                 comm);
-
-    // Compute receive displacements
-    std::vector<int> disp_recv(size + 1, 0);
-    std::partial_sum(num_recv.begin(), num_recv.end(), disp_recv.begin() + 1);
-
-    // Send/receive sharing data
-    std::vector<int> data_recv(disp_recv.back(), -1);
-    MPI_Alltoallv(data_send.data(), num_send.data(), disp_send.data(),
-                  MPI::mpi_type<int>(), data_recv.data(), num_recv.data(),
-                  disp_recv.data(), MPI::mpi_type<int>(), comm);
+    // Send/receive sharing data. The data is received from the ranks
+    // that the indices were sent to, in the same (rank) order.
+    const auto [src_recv, data_recv] = dolfinx::MPI::sparse_all_to_all(
+        comm, src, graph::AdjacencyList<int>(data_send, disp_send));
+    assert(src_recv == dest);
 
     // Unpack data
+    const Eigen::Array<int, Eigen::Dynamic, 1>& _data_recv = data_recv.array();
     std::vector<int> processes, process_offsets(1, 0);
-    for (std::size_t p = 0; p < disp_recv.size() - 1; ++p)
+    for (Eigen::Index i = 0; i < _data_recv.rows();)
     {
-      for (int i = disp_recv[p]; i < disp_recv[p + 1];)
-      {
-        const int num_procs = data_recv[i++];
-        for (int j = 0; j < num_procs; ++j)
-          processes.push_back(data_recv[i++]);
-        process_offsets.push_back(process_offsets.back() + num_procs);
-      }
+      const int num_procs = _data_recv[i++];
+      for (int j = 0; j < num_procs; ++j)
+        processes.push_back(_data_recv[i++]);
+      process_offsets.push_back(process_offsets.back() + num_procs);
     }
 
     sharing_processes = std::make_unique<const graph::AdjacencyList<int>>(
@@ -442,16 +430,6 @@ Partitioning::distribute(MPI_Comm comm,
   std::partial_sum(num_per_dest_send.begin(), num_per_dest_send.end(),
                    disp_send.begin() + 1);
 
-  // Send/receive number of items to communicate
-  std::vector<int> num_per_dest_recv(size, 0);
-  MPI_Alltoall(num_per_dest_send.data(), 1, MPI_INT, num_per_dest_recv.data(),
-               1, MPI_INT, comm);
-
-  // Compute receive array displacements
-  std::vector<int> disp_recv(size + 1, 0);
-  std::partial_sum(num_per_dest_recv.begin(), num_per_dest_recv.end(),
-                   disp_recv.begin() + 1);
-
   // Prepare send buffer
   std::vector<int> offset = disp_send;
   std::vector<std::int64_t> data_send(disp_send.back());
@@ -470,11 +448,23 @@ Partitioning::distribute(MPI_Comm comm,
     }
   }
 
-  // Send/receive data
-  std::vector<std::int64_t> data_recv(disp_recv.back());
-  MPI_Alltoallv(data_send.data(), num_per_dest_send.data(), disp_send.data(),
-                MPI_INT64_T, data_recv.data(), num_per_dest_recv.data(),
-                disp_recv.data(), MPI_INT64_T, comm);
+  // Send/receive data. Only ranks that exchange nodes communicate.
+  std::vector<int> dests;
+  std::vector<std::int32_t> dest_offsets(1, 0);
+  for (int p = 0; p < size; ++p)
+  {
+    if (num_per_dest_send[p] > 0)
+    {
+      dests.push_back(p);
+      dest_offsets.push_back(disp_send[p + 1]);
+    }
+  }
+  const auto [srcs, recv] = dolfinx::MPI::sparse_all_to_all(
+      comm, dests, graph::AdjacencyList<std::int64_t>(data_send, dest_offsets));
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& data_recv
+      = recv.array();
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& disp_recv
+      = recv.offsets();
 
   // Unpack receive buffer
   int mpi_rank = MPI::rank(comm);
@@ -488,9 +478,10 @@ Partitioning::distribute(MPI_Comm comm,
   std::vector<int> ghost_src;
   std::vector<int> ghost_index_owner;
 
-  for (std::size_t p = 0; p < disp_recv.size() - 1; ++p)
+  for (std::size_t q = 0; q < srcs.size(); ++q)
   {
-    for (int i = disp_recv[p]; i < disp_recv[p + 1];)
+    const int p = srcs[q];
+    for (int i = disp_recv[q]; i < disp_recv[q + 1];)
     {
       if (data_recv[i] == mpi_rank)
       {
@@ -568,15 +559,6 @@ std::vector<std::int64_t> Partitioning::compute_ghost_indices(
     ++ghost_index_count[it->second];
   }
 
-  // NB - this assumes a symmetry, i.e. that if one process shares an index
-  // owned by another process, then the same is true vice versa. This
-  // assumption is valid for meshes with cells shared via facet or vertex.
-  MPI_Comm neighbour_comm;
-  MPI_Dist_graph_create_adjacent(comm, neighbours.size(), neighbours.data(),
-                                 MPI_UNWEIGHTED, neighbours.size(),
-                                 neighbours.data(), MPI_UNWEIGHTED,
-                                 MPI_INFO_NULL, false, &neighbour_comm);
-
   std::vector<int> send_offsets = {0};
   for (std::size_t i = 0; i < ghost_index_count.size(); ++i)
     send_offsets.push_back(send_offsets.back() + ghost_index_count[i]);
@@ -597,37 +579,43 @@ std::vector<std::int64_t> Partitioning::compute_ghost_indices(
     ++ghost_index_offset[np];
   }
 
-  std::vector<int> recv_sizes(neighbours.size());
-  MPI_Neighbor_alltoall(ghost_index_count.data(), 1, MPI_INT, recv_sizes.data(),
-                        1, MPI_INT, neighbour_comm);
-  std::vector<int> recv_offsets = {0};
-  for (int q : recv_sizes)
-    recv_offsets.push_back(recv_offsets.back() + q);
-  std::vector<std::int64_t> recv_data(recv_offsets.back());
-
-  MPI_Neighbor_alltoallv(send_data.data(), ghost_index_count.data(),
-                         send_offsets.data(), MPI_INT64_T, recv_data.data(),
-                         recv_sizes.data(), recv_offsets.data(), MPI_INT64_T,
-                         neighbour_comm);
+  // Send the ghost indices to the owners. The ranks that request
+  // indices from this rank are discovered in the exchange, so no
+  // symmetry of the sharing is assumed.
+  const auto [srcs, recv] = dolfinx::MPI::sparse_all_to_all(
+      comm, neighbours,
+      graph::AdjacencyList<std::int64_t>(send_data, send_offsets));
 
   // Replace values in recv_data with new_index and send back
   std::unordered_map<std::int64_t, std::int64_t> old_to_new;
   for (int i = 0; i < num_local; ++i)
     old_to_new.insert({global_indices[i], offset_local + i});
 
-  for (std::int64_t& r : recv_data)
+  Eigen::Array<std::int64_t, Eigen::Dynamic, 1> recv_data = recv.array();
+  for (Eigen::Index i = 0; i < recv_data.rows(); ++i)
   {
-    auto it = old_to_new.find(r);
+    auto it = old_to_new.find(recv_data[i]);
     // Must exist on this process!
     assert(it != old_to_new.end());
-    r = it->second;
+    recv_data[i] = it->second;
   }
 
+  const auto [owners, new_recv_list] = dolfinx::MPI::sparse_all_to_all(
+      comm, srcs,
+      graph::AdjacencyList<std::int64_t>(std::move(recv_data),
+                                         recv.offsets()));
+
+  // The new indices are received in order of owner rank. Place them in
+  // the order of send_data.
   std::vector<std::int64_t> new_recv(send_data.size());
-  MPI_Neighbor_alltoallv(recv_data.data(), recv_sizes.data(),
-                         recv_offsets.data(), MPI_INT64_T, new_recv.data(),
-                         ghost_index_count.data(), send_offsets.data(),
-                         MPI_INT64_T, neighbour_comm);
+  for (std::size_t q = 0; q < owners.size(); ++q)
+  {
+    auto new_indices = new_recv_list.links(q);
+    const int np = proc_to_neighbour[owners[q]];
+    assert(new_indices.rows() == ghost_index_count[np]);
+    std::copy(new_indices.data(), new_indices.data() + new_indices.rows(),
+              new_recv.begin() + send_offsets[np]);
+  }
 
   // Add to map
   for (std::size_t i = 0; i < send_data.size(); ++i)
@@ -645,7 +633,6 @@ std::vector<std::int64_t> Partitioning::compute_ghost_indices(
     q = it->second;
   }
 
-  MPI_Comm_free(&neighbour_comm);
   return ghost_global_indices;
 }
 //-----------------------------------------------------------------------------
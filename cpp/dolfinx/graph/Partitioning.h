@@ -18,7 +18,8 @@
 namespace dolfinx::graph
 {
 
-/// Tools for distributed graphs
+/// Tools for distributed graphs. Data is exchanged between ranks
+/// using sparse (NBX) communication, see MPI::sparse_all_to_all.
 ///
 /// TODO: Add a function that sends data (Eigen arrays) to the 'owner'
 
@@ -205,49 +206,51 @@ Partitioning::distribute_data(
     indices_send[disp_tmp[owner]++] = indices[i];
   }
 
-  // Send/receive number of indices to communicate to each process
-  std::vector<int> number_index_recv(size);
-  MPI_Alltoall(number_index_send.data(), 1, MPI_INT, number_index_recv.data(),
-               1, MPI_INT, comm);
-
-  // Compute receive displacements
-  std::vector<int> disp_index_recv(size + 1, 0);
-  std::partial_sum(number_index_recv.begin(), number_index_recv.end(),
-                   disp_index_recv.begin() + 1);
+  // Ranks to request data from, and offsets of the requested indices
+  std::vector<int> dest;
+  std::vector<std::int32_t> dest_offsets(1, 0);
+  for (int q = 0; q < size; ++q)
+  {
+    if (number_index_send[q] > 0)
+    {
+      dest.push_back(q);
+      dest_offsets.push_back(disp_index_send[q + 1]);
+    }
+  }
 
-  // Send/receive global indices
-  std::vector<std::int64_t> indices_recv(disp_index_recv.back());
-  MPI_Alltoallv(indices_send.data(), number_index_send.data(),
-                disp_index_send.data(), MPI_INT64_T, indices_recv.data(),
-                number_index_recv.data(), disp_index_recv.data(), MPI_INT64_T,
-                comm);
+  // Send/receive global indices. Only ranks that exchange indices
+  // communicate.
+  const auto [src, indices_recv] = dolfinx::MPI::sparse_all_to_all(
+      comm, dest,
+      graph::AdjacencyList<std::int64_t>(indices_send, dest_offsets));
 
   const int item_size = x.cols();
   assert(item_size != 0);
   // Pack point data to send back (transpose)
-  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> x_return(
-      indices_recv.size(), item_size);
-  for (int p = 0; p < size; ++p)
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& _indices_recv
+      = indices_recv.array();
+  Eigen::Array<T, Eigen::Dynamic, 1> x_return(_indices_recv.rows()
+                                              * item_size);
+  for (Eigen::Index i = 0; i < _indices_recv.rows(); ++i)
   {
-    for (int i = disp_index_recv[p]; i < disp_index_recv[p + 1]; ++i)
-    {
-      const std::int32_t index_local = indices_recv[i] - global_offsets[rank];
-      assert(index_local >= 0);
-      x_return.row(i) = x.row(index_local);
-    }
+    const std::int32_t index_local = _indices_recv[i] - global_offsets[rank];
+    assert(index_local >= 0);
+    x_return.segment(i * item_size, item_size)
+        = x.row(index_local).transpose();
   }
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> offsets_return
+      = indices_recv.offsets() * item_size;
 
-  MPI_Datatype compound_type;
-  MPI_Type_contiguous(item_size, dolfinx::MPI::mpi_type<T>(), &compound_type);
-  MPI_Type_commit(&compound_type);
-
-  // Send back point data
-  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> my_x(
-      disp_index_send.back(), item_size);
-  MPI_Alltoallv(x_return.data(), number_index_recv.data(),
-                disp_index_recv.data(), compound_type, my_x.data(),
-                number_index_send.data(), disp_index_send.data(), compound_type,
-                comm);
+  // Send back point data. The data is received from the ranks that the
+  // indices were sent to, in the same (rank) order.
+  const auto [src_return, x_recv] = dolfinx::MPI::sparse_all_to_all(
+      comm, src,
+      graph::AdjacencyList<T>(std::move(x_return), std::move(offsets_return)));
+  assert(src_return == dest);
+  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> my_x
+      = Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
+                                      Eigen::RowMajor>>(
+          x_recv.array().data(), disp_index_send.back(), item_size);
 
   return my_x;
 }
@@ -25,6 +25,60 @@
 using namespace dolfinx;
 using namespace dolfinx::io;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Add a Grid for a Function to the time series Grid of the Function
+template <typename T>
+void add_function_grid(pugi::xml_document& xml_doc, MPI_Comm comm,
+                       const hid_t h5_id, const function::Function<T>& function,
+                       const double t, const std::string mesh_xpath)
+{
+  const std::string timegrid_xpath
+      = "/Xdmf/Domain/Grid[@GridType='Collection'][@Name='" + function.name
+        + "']";
+  pugi::xml_node timegrid_node
+      = xml_doc.select_node(timegrid_xpath.c_str()).node();
+
+  if (!timegrid_node)
+  {
+    pugi::xml_node domain_node = xml_doc.select_node("/Xdmf/Domain").node();
+    timegrid_node = domain_node.append_child("Grid");
+    timegrid_node.append_attribute("Name") = function.name.c_str();
+    timegrid_node.append_attribute("GridType") = "Collection";
+    timegrid_node.append_attribute("CollectionType") = "Temporal";
+  }
+
+  assert(timegrid_node);
+
+  pugi::xml_node grid_node = timegrid_node.append_child("Grid");
+  assert(grid_node);
+  grid_node.append_attribute("Name") = function.name.c_str();
+  grid_node.append_attribute("GridType") = "Uniform";
+
+  pugi::xml_node mesh_node = xml_doc.select_node(mesh_xpath.c_str()).node();
+  if (!mesh_node)
+    LOG(WARNING) << "No mesh found at '" << mesh_xpath
+                 << "'. Write mesh before function!";
+
+  const std::string ref_path
+      = "xpointer(" + mesh_xpath + "/*[self::Topology or self::Geometry])";
+
+  pugi::xml_node topo_geo_ref = grid_node.append_child("xi:include");
+  topo_geo_ref.append_attribute("xpointer") = ref_path.c_str();
+  assert(topo_geo_ref);
+
+  std::string t_str = boost::lexical_cast<std::string>(t);
+  pugi::xml_node time_node = grid_node.append_child("Time");
+  time_node.append_attribute("Value") = t_str.c_str();
+  assert(time_node);
+
+  // Add the mesh Grid to the domain
+  xdmf_function::add_function(comm, function, t, grid_node, h5_id);
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 XDMFFile::XDMFFile(MPI_Comm comm, const std::string filename,
                    const std::string file_mode, const Encoding encoding)
@@ -213,47 +267,19 @@ XDMFFile::read_geometry_data(const std::string name,
 void XDMFFile::write_function(const function::Function<PetscScalar>& function,
                               const double t, const std::string mesh_xpath)
 {
-  const std::string timegrid_xpath
-      = "/Xdmf/Domain/Grid[@GridType='Collection'][@Name='" + function.name
-        + "']";
-  pugi::xml_node timegrid_node
-      = _xml_doc->select_node(timegrid_xpath.c_str()).node();
-
-  if (!timegrid_node)
-  {
-    pugi::xml_node domain_node = _xml_doc->select_node("/Xdmf/Domain").node();
-    timegrid_node = domain_node.append_child("Grid");
-    timegrid_node.append_attribute("Name") = function.name.c_str();
-    timegrid_node.append_attribute("GridType") = "Collection";
-    timegrid_node.append_attribute("CollectionType") = "Temporal";
-  }
-
-  assert(timegrid_node);
+  add_function_grid(*_xml_doc, _mpi_comm.comm(), _h5_id, function, t,
+                    mesh_xpath);
 
-  pugi::xml_node grid_node = timegrid_node.append_child("Grid");
-  assert(grid_node);
-  grid_node.append_attribute("Name") = function.name.c_str();
-  grid_node.append_attribute("GridType") = "Uniform";
-
-  pugi::xml_node mesh_node = _xml_doc->select_node(mesh_xpath.c_str()).node();
-  if (!mesh_node)
-    LOG(WARNING) << "No mesh found at '" << mesh_xpath
-                 << "'. Write mesh before function!";
-
-  const std::string ref_path
-      = "xpointer(" + mesh_xpath + "/*[self::Topology or self::Geometry])";
-
-  pugi::xml_node topo_geo_ref = grid_node.append_child("xi:include");
-  topo_geo_ref.append_attribute("xpointer") = ref_path.c_str();
-  assert(topo_geo_ref);
-
-  std::string t_str = boost::lexical_cast<std::string>(t);
-  pugi::xml_node time_node = grid_node.append_child("Time");
-  time_node.append_attribute("Value") = t_str.c_str();
-  assert(time_node);
-
-  // Add the mesh Grid to the domain
-  xdmf_function::add_function(_mpi_comm.comm(), function, t, grid_node, _h5_id);
+  // Save XML file (on process 0 only)
+  if (MPI::rank(_mpi_comm.comm()) == 0)
+    _xml_doc->save_file(_filename.c_str(), "  ");
+}
+//-----------------------------------------------------------------------------
+void XDMFFile::write_function(const function::Function<float>& function,
+                              const double t, const std::string mesh_xpath)
+{
+  add_function_grid(*_xml_doc, _mpi_comm.comm(), _h5_id, function, t,
+                    mesh_xpath);
 
   // Save XML file (on process 0 only)
   if (MPI::rank(_mpi_comm.comm()) == 0)
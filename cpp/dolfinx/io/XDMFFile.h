@@ -141,6 +141,16 @@ public:
                       const std::string mesh_xpath
                       = "/Xdmf/Domain/Grid[@GridType='Uniform'][1]");
 
+  /// Write single precision Function
+  /// @param[in] function The Function to write to file
+  /// @param[in] t The time stamp to associate with the Function
+  /// @param[in] mesh_xpath XPath for a Grid under which Function will
+  ///   be inserted
+  void write_function(const function::Function<float>& function,
+                      const double t,
+                      const std::string mesh_xpath
+                      = "/Xdmf/Domain/Grid[@GridType='Uniform'][1]");
+
   /// Write MeshTags
   /// @param[in] meshtags
   /// @param[in] geometry_xpath XPath where Geometry is already stored
@@ -16,7 +16,9 @@
 #include <dolfinx/function/FunctionSpace.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
+#include <complex>
 #include <string>
+#include <type_traits>
 
 using namespace dolfinx;
 using namespace dolfinx::io;
@@ -44,7 +46,8 @@ std::string rank_to_string(int value_rank)
 //-----------------------------------------------------------------------------
 
 /// Returns true for DG0 function::Functions
-bool has_cell_centred_data(const function::Function<PetscScalar>& u)
+template <typename T>
+bool has_cell_centred_data(const function::Function<T>& u)
 {
   int cell_based_dim = 1;
   const int rank = u.function_space()->element()->value_rank();
@@ -61,7 +64,8 @@ bool has_cell_centred_data(const function::Function<PetscScalar>& u)
 
 // Get data width - normally the same as u.value_size(), but expand for
 // 2D vector/tensor because XDMF presents everything as 3D
-int get_padded_width(const function::Function<PetscScalar>& u)
+template <typename T>
+int get_padded_width(const function::Function<T>& u)
 {
   const int width = u.function_space()->element()->value_size();
   const int rank = u.function_space()->element()->value_rank();
@@ -73,13 +77,21 @@ int get_padded_width(const function::Function<PetscScalar>& u)
 }
 //-----------------------------------------------------------------------------
 
-} // namespace
-
+// Check if a scalar type is complex
+template <typename T>
+struct is_complex : std::false_type
+{
+};
+template <typename T>
+struct is_complex<std::complex<T>> : std::true_type
+{
+};
 //-----------------------------------------------------------------------------
-void xdmf_function::add_function(MPI_Comm comm,
-                                 const function::Function<PetscScalar>& u,
-                                 const double t, pugi::xml_node& xml_node,
-                                 const hid_t h5_id)
+
+template <typename T>
+void add_function_impl(MPI_Comm comm, const function::Function<T>& u,
+                       const double t, pugi::xml_node& xml_node,
+                       const hid_t h5_id)
 {
   LOG(INFO) << "Adding function to node \"" << xml_node.path('/') << "\"";
 
@@ -88,7 +100,7 @@ void xdmf_function::add_function(MPI_Comm comm,
   assert(mesh);
 
   // Get function::Function data values and shape
-  std::vector<PetscScalar> data_values;
+  std::vector<T> data_values;
   const bool cell_centred = has_cell_centred_data(u);
   if (cell_centred)
     data_values = xdmf_utils::get_cell_data_values(u);
@@ -109,11 +121,9 @@ void xdmf_function::add_function(MPI_Comm comm,
 
   const int value_rank = u.function_space()->element()->value_rank();
 
-#ifdef PETSC_USE_COMPLEX
-  const std::vector<std::string> components = {"real", "imag"};
-#else
-  const std::vector<std::string> components = {""};
-#endif
+  const std::vector<std::string> components
+      = is_complex<T>::value ? std::vector<std::string>{"real", "imag"}
+                             : std::vector<std::string>{""};
 
   std::string t_str = boost::lexical_cast<std::string>(t);
   std::replace(t_str.begin(), t_str.end(), '.', '_');
@@ -141,33 +151,58 @@ void xdmf_function::add_function(MPI_Comm comm,
     attribute_node.append_attribute("Center") = cell_centred ? "Cell" : "Node";
 
     const bool use_mpi_io = (dolfinx::MPI::size(comm) > 1);
-#ifdef PETSC_USE_COMPLEX
-    // FIXME: Avoid copies by writing directly a compound data
-    std::vector<double> component_data_values(data_values.size());
-    if (component == "real")
+    if constexpr (is_complex<T>::value)
     {
-      for (std::size_t i = 0; i < data_values.size(); i++)
-        component_data_values[i] = data_values[i].real();
+      // FIXME: Avoid copies by writing directly a compound data
+      std::vector<typename T::value_type> component_data_values(
+          data_values.size());
+      if (component == "real")
+      {
+        for (std::size_t i = 0; i < data_values.size(); i++)
+          component_data_values[i] = data_values[i].real();
+      }
+      else if (component == "imag")
+      {
+        for (std::size_t i = 0; i < data_values.size(); i++)
+          component_data_values[i] = data_values[i].imag();
+      }
+
+      // Add data item of component
+      const std::int64_t offset = dolfinx::MPI::global_offset(
+          comm, component_data_values.size() / width, true);
+      xdmf_utils::add_data_item(attribute_node, h5_id, dataset_name,
+                                component_data_values, offset,
+                                {num_values, width}, "", use_mpi_io);
     }
-    else if (component == "imag")
+    else
     {
-      for (std::size_t i = 0; i < data_values.size(); i++)
-        component_data_values[i] = data_values[i].imag();
+      // Add data item
+      const std::int64_t offset = dolfinx::MPI::global_offset(
+          comm, data_values.size() / width, true);
+      xdmf_utils::add_data_item(attribute_node, h5_id, dataset_name,
+                                data_values, offset, {num_values, width}, "",
+                                use_mpi_io);
     }
-
-    // Add data item of component
-    const std::int64_t offset = dolfinx::MPI::global_offset(
-        comm, component_data_values.size() / width, true);
-    xdmf_utils::add_data_item(attribute_node, h5_id, dataset_name,
-                              component_data_values, offset,
-                              {num_values, width}, "", use_mpi_io);
-#else
-    // Add data item
-    const std::int64_t offset
-        = dolfinx::MPI::global_offset(comm, data_values.size() / width, true);
-    xdmf_utils::add_data_item(attribute_node, h5_id, dataset_name, data_values,
-                              offset, {num_values, width}, "", use_mpi_io);
-#endif
   }
 }
 //-----------------------------------------------------------------------------
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+void xdmf_function::add_function(MPI_Comm comm,
+                                 const function::Function<PetscScalar>& u,
+                                 const double t, pugi::xml_node& xml_node,
+                                 const hid_t h5_id)
+{
+  add_function_impl(comm, u, t, xml_node, h5_id);
+}
+//-----------------------------------------------------------------------------
+void xdmf_function::add_function(MPI_Comm comm,
+                                 const function::Function<float>& u,
+                                 const double t, pugi::xml_node& xml_node,
+                                 const hid_t h5_id)
+{
+  add_function_impl(comm, u, t, xml_node, h5_id);
+}
+//-----------------------------------------------------------------------------
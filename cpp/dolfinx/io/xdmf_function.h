@@ -33,6 +33,10 @@ namespace xdmf_function
 void add_function(MPI_Comm comm, const function::Function<PetscScalar>& u,
                   const double t, pugi::xml_node& xml_node, const hid_t h5_id);
 
+/// TODO
+void add_function(MPI_Comm comm, const function::Function<float>& u,
+                  const double t, pugi::xml_node& xml_node, const hid_t h5_id);
+
 } // namespace xdmf_function
 } // namespace io
 } // namespace dolfinx
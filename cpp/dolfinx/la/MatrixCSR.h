@@ -0,0 +1,470 @@
+// Copyright (C) 2026 The DOLFINX authors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "SparsityPattern.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::la
+{
+
+/// Distributed sparse matrix in compressed sparse row (CSR) format
+///
+/// The rows owned by this process are stored first, followed by the
+/// ghost rows, i.e. rows that are owned by other processes and receive
+/// contributions on this process. Column indices are local: owned
+/// columns first, followed by the ghosts of the column IndexMap and
+/// then any other off-process columns that appear only in owned rows.
+/// Local row and column indices therefore agree with the local
+/// indexing of the IndexMaps, and values can be added using, e.g., the
+/// local indices of a dofmap.
+///
+/// Contributions to ghost rows are sent to the owning process by
+/// MatrixCSR::finalize. The communication pattern is computed once,
+/// when the matrix is created.
+
+template <typename T>
+class MatrixCSR
+{
+public:
+  /// Create a matrix from a sparsity pattern
+  /// @param[in] p The sparsity pattern. It must be finalised and not
+  ///   blocked.
+  explicit MatrixCSR(const SparsityPattern& p)
+      : _index_maps({p.index_map(0), p.index_map(1)}), _block_positions(0)
+  {
+    if (p.blocked())
+      throw std::runtime_error("Blocked sparsity patterns are not supported.");
+    const common::IndexMap& map0 = *_index_maps[0];
+    const common::IndexMap& map1 = *_index_maps[1];
+    const int bs0 = map0.block_size();
+    const int bs1 = map1.block_size();
+    const std::array<std::int64_t, 2> range0 = map0.local_range();
+    const std::array<std::int64_t, 2> range1 = map1.local_range();
+    const std::int32_t local_size1 = bs1 * map1.size_local();
+
+    const graph::AdjacencyList<std::int32_t>& diag = p.diagonal_pattern();
+    const graph::AdjacencyList<std::int64_t>& off_diag
+        = p.off_diagonal_pattern();
+    const graph::AdjacencyList<std::int64_t>& ghost_rows
+        = p.ghost_row_pattern();
+    _num_owned_rows = diag.num_nodes();
+
+    // Ghost columns: the (unrolled) ghosts of the column map, followed
+    // by other off-process columns in the owned rows
+    const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts1
+        = map1.ghosts();
+    for (Eigen::Index i = 0; i < ghosts1.rows(); ++i)
+      for (int j = 0; j < bs1; ++j)
+        _ghost_cols.push_back(bs1 * ghosts1[i] + j);
+    std::map<std::int64_t, std::int32_t> global_to_local;
+    for (std::size_t i = 0; i < _ghost_cols.size(); ++i)
+      global_to_local.insert({_ghost_cols[i], local_size1 + i});
+    const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& off_diag_cols
+        = off_diag.array();
+    for (Eigen::Index i = 0; i < off_diag_cols.rows(); ++i)
+    {
+      if (global_to_local
+              .insert({off_diag_cols[i], local_size1 + _ghost_cols.size()})
+              .second)
+      {
+        _ghost_cols.push_back(off_diag_cols[i]);
+      }
+    }
+
+    auto col_to_local = [&](std::int64_t col) -> std::int32_t {
+      if (col >= bs1 * range1[0] and col < bs1 * range1[1])
+        return col - bs1 * range1[0];
+      auto it = global_to_local.find(col);
+      if (it == global_to_local.end())
+        throw std::runtime_error("Column not in the sparsity pattern");
+      return it->second;
+    };
+
+    // Build CSR structure, owned rows followed by ghost rows
+    const std::int32_t num_rows = _num_owned_rows + ghost_rows.num_nodes();
+    _row_ptr.resize(num_rows + 1, 0);
+    for (std::int32_t r = 0; r < _num_owned_rows; ++r)
+      _row_ptr[r + 1] = _row_ptr[r] + diag.num_links(r) + off_diag.num_links(r);
+    for (std::int32_t r = 0; r < ghost_rows.num_nodes(); ++r)
+    {
+      _row_ptr[_num_owned_rows + r + 1]
+          = _row_ptr[_num_owned_rows + r] + ghost_rows.num_links(r);
+    }
+
+    _cols.resize(_row_ptr.back());
+    for (std::int32_t r = 0; r < _num_owned_rows; ++r)
+    {
+      auto cols_diag = diag.links(r);
+      auto cols_off = off_diag.links(r);
+      std::int32_t* row = _cols.data() + _row_ptr[r];
+      std::copy(cols_diag.data(), cols_diag.data() + cols_diag.rows(), row);
+      for (Eigen::Index j = 0; j < cols_off.rows(); ++j)
+        row[cols_diag.rows() + j] = col_to_local(cols_off[j]);
+      std::sort(row, _cols.data() + _row_ptr[r + 1]);
+    }
+    for (std::int32_t r = 0; r < ghost_rows.num_nodes(); ++r)
+    {
+      auto cols = ghost_rows.links(r);
+      std::int32_t* row = _cols.data() + _row_ptr[_num_owned_rows + r];
+      for (Eigen::Index j = 0; j < cols.rows(); ++j)
+        row[j] = col_to_local(cols[j]);
+      std::sort(row, row + cols.rows());
+    }
+    _values.assign(_cols.size(), 0);
+
+    // -- Communication pattern for sending ghost rows to their owners
+
+    MPI_Comm comm = map0.comm(common::IndexMap::Direction::reverse);
+    int indegree(-1), outdegree(-2), weighted(-1);
+    MPI_Dist_graph_neighbors_count(comm, &indegree, &outdegree, &weighted);
+    std::vector<int> src(indegree), dest(outdegree);
+    MPI_Dist_graph_neighbors(comm, indegree, src.data(), MPI_UNWEIGHTED,
+                             outdegree, dest.data(), MPI_UNWEIGHTED);
+
+    // Neighbourhood (destination) index of the owner of each ghost row
+    const Eigen::Array<int, Eigen::Dynamic, 1> owners
+        = map0.ghost_owner_rank();
+    std::vector<int> row_dest(ghost_rows.num_nodes());
+    _send_count.assign(outdegree, 0);
+    for (std::int32_t r = 0; r < ghost_rows.num_nodes(); ++r)
+    {
+      auto it = std::find(dest.begin(), dest.end(), owners[r / bs0]);
+      assert(it != dest.end());
+      row_dest[r] = std::distance(dest.begin(), it);
+      _send_count[row_dest[r]] += ghost_rows.num_links(r);
+    }
+    _send_disp.assign(outdegree + 1, 0);
+    std::partial_sum(_send_count.begin(), _send_count.end(),
+                     _send_disp.begin() + 1);
+
+    // Pack (global row, global column) for each ghost row entry,
+    // ordered by destination, and remember the position of each entry
+    const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts0
+        = map0.ghosts();
+    std::vector<std::int64_t> send_entries(2 * _send_disp.back());
+    _send_pos.resize(_send_disp.back());
+    std::vector<int> offset(_send_disp.begin(), _send_disp.end() - 1);
+    for (std::int32_t r = 0; r < ghost_rows.num_nodes(); ++r)
+    {
+      const std::int64_t row_global = bs0 * ghosts0[r / bs0] + r % bs0;
+      const std::int32_t row = _num_owned_rows + r;
+      for (std::int32_t k = _row_ptr[row]; k < _row_ptr[row + 1]; ++k)
+      {
+        const int pos = offset[row_dest[r]]++;
+        _send_pos[pos] = k;
+        send_entries[2 * pos] = row_global;
+        send_entries[2 * pos + 1]
+            = _cols[k] < local_size1
+                  ? _cols[k] + bs1 * range1[0]
+                  : _ghost_cols[_cols[k] - local_size1];
+      }
+    }
+
+    // Send number of entries to owners
+    _recv_count.resize(indegree);
+    MPI_Neighbor_alltoall(_send_count.data(), 1, MPI_INT, _recv_count.data(),
+                          1, MPI_INT, comm);
+    _recv_disp.assign(indegree + 1, 0);
+    std::partial_sum(_recv_count.begin(), _recv_count.end(),
+                     _recv_disp.begin() + 1);
+
+    // Send (row, column) pairs to owners
+    std::vector<int> send_count2(outdegree), send_disp2(outdegree);
+    std::vector<int> recv_count2(indegree), recv_disp2(indegree);
+    for (int i = 0; i < outdegree; ++i)
+    {
+      send_count2[i] = 2 * _send_count[i];
+      send_disp2[i] = 2 * _send_disp[i];
+    }
+    for (int i = 0; i < indegree; ++i)
+    {
+      recv_count2[i] = 2 * _recv_count[i];
+      recv_disp2[i] = 2 * _recv_disp[i];
+    }
+    std::vector<std::int64_t> recv_entries(2 * _recv_disp.back());
+    MPI_Neighbor_alltoallv(send_entries.data(), send_count2.data(),
+                           send_disp2.data(), MPI_INT64_T, recv_entries.data(),
+                           recv_count2.data(), recv_disp2.data(), MPI_INT64_T,
+                           comm);
+
+    // Compute position in value array of each received entry
+    _recv_pos.resize(_recv_disp.back());
+    for (std::size_t i = 0; i < _recv_pos.size(); ++i)
+    {
+      const std::int32_t row = recv_entries[2 * i] - bs0 * range0[0];
+      assert(row >= 0 and row < _num_owned_rows);
+      _recv_pos[i] = position(row, col_to_local(recv_entries[2 * i + 1]));
+    }
+  }
+
+  /// Move constructor
+  MatrixCSR(MatrixCSR&& A) = default;
+
+  /// Destructor
+  ~MatrixCSR() = default;
+
+  /// Move assignment
+  MatrixCSR& operator=(MatrixCSR&& A) = default;
+
+  /// Return a function with an interface for adding values to the
+  /// matrix, suitable for use in assemblers. Rows and columns are local
+  /// indices. The function can be called concurrently for blocks that
+  /// share no rows. It refers to the matrix storage, not to the matrix
+  /// object, and remains valid if the matrix is moved. It must not be
+  /// used after the matrix has been destroyed.
+  std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                    const std::int32_t*, const T*)>
+  mat_add_values()
+  {
+    const std::int32_t* row_ptr = _row_ptr.data();
+    const std::int32_t* cols = _cols.data();
+    T* values = _values.data();
+    return [row_ptr, cols, values](std::int32_t nrows,
+                                   const std::int32_t* rows,
+                                   std::int32_t ncols,
+                                   const std::int32_t* cols_block,
+                                   const T* x) {
+      for (std::int32_t i = 0; i < nrows; ++i)
+      {
+        for (std::int32_t j = 0; j < ncols; ++j)
+        {
+          values[position(row_ptr, cols, rows[i], cols_block[j])]
+              += x[i * ncols + j];
+        }
+      }
+      return 0;
+    };
+  }
+
+  /// Add a dense block of values to the matrix. The entries must exist
+  /// in the sparsity pattern.
+  /// @param[in] nrows Number of rows in the block
+  /// @param[in] rows Local row indices
+  /// @param[in] ncols Number of columns in the block
+  /// @param[in] cols Local column indices
+  /// @param[in] x The values (row-major, nrows x ncols)
+  void add(std::int32_t nrows, const std::int32_t* rows, std::int32_t ncols,
+           const std::int32_t* cols, const T* x)
+  {
+    for (std::int32_t i = 0; i < nrows; ++i)
+      for (std::int32_t j = 0; j < ncols; ++j)
+        _values[position(rows[i], cols[j])] += x[i * ncols + j];
+  }
+
+  /// Compute the positions in the value array of the entries of the
+  /// dense blocks rows.links(c) x cols.links(c), for every node c, e.g.
+  /// the element matrix entries of each cell for a pair of cell
+  /// dofmaps. The positions of block c are row-major.
+  /// @param[in] rows Local row indices for each node
+  /// @param[in] cols Local column indices for each node
+  /// @return Positions in the value array for each node
+  graph::AdjacencyList<std::int32_t>
+  compute_block_positions(const graph::AdjacencyList<std::int32_t>& rows,
+                          const graph::AdjacencyList<std::int32_t>& cols) const
+  {
+    assert(rows.num_nodes() == cols.num_nodes());
+    std::vector<std::int32_t> offsets(rows.num_nodes() + 1, 0);
+    for (std::int32_t c = 0; c < rows.num_nodes(); ++c)
+      offsets[c + 1] = offsets[c] + rows.num_links(c) * cols.num_links(c);
+    std::vector<std::int32_t> pos(offsets.back());
+    for (std::int32_t c = 0; c < rows.num_nodes(); ++c)
+    {
+      auto r = rows.links(c);
+      auto s = cols.links(c);
+      std::int32_t* p = pos.data() + offsets[c];
+      for (Eigen::Index i = 0; i < r.rows(); ++i)
+        for (Eigen::Index j = 0; j < s.rows(); ++j)
+          *p++ = position(r[i], s[j]);
+    }
+
+    return graph::AdjacencyList<std::int32_t>(pos, offsets);
+  }
+
+  /// Get the positions of the dense blocks rows.links(c) x
+  /// cols.links(c) in the value array (see
+  /// MatrixCSR::compute_block_positions). The positions are cached for
+  /// the most recently used @p key, and are only computed if @p key
+  /// differs from the key of the cached positions.
+  /// @param[in] key Key that identifies @p rows and @p cols, e.g. the
+  ///   ids of the function spaces of a bilinear form. Different
+  ///   (rows, cols) must not use the same key.
+  /// @param[in] rows Local row indices for each node
+  /// @param[in] cols Local column indices for each node
+  /// @return Positions in the value array for each node
+  const graph::AdjacencyList<std::int32_t>&
+  block_positions(const std::array<std::size_t, 2>& key,
+                  const graph::AdjacencyList<std::int32_t>& rows,
+                  const graph::AdjacencyList<std::int32_t>& cols)
+  {
+    if (!_block_positions_key or *_block_positions_key != key)
+    {
+      _block_positions = compute_block_positions(rows, cols);
+      _block_positions_key = key;
+    }
+    assert(_block_positions.num_nodes() == rows.num_nodes());
+    return _block_positions;
+  }
+
+  /// Set all entries (including ghost rows) to a value
+  /// @param[in] x The value
+  void set(T x) { std::fill(_values.begin(), _values.end(), x); }
+
+  /// Send ghost row values to the owning processes and add them to the
+  /// owned rows. Ghost row values are zeroed afterwards.
+  /// @note Collective
+  void finalize()
+  {
+    std::vector<T> send_values(_send_pos.size());
+    for (std::size_t i = 0; i < _send_pos.size(); ++i)
+      send_values[i] = _values[_send_pos[i]];
+
+    std::vector<T> recv_values(_recv_pos.size());
+    MPI_Neighbor_alltoallv(
+        send_values.data(), _send_count.data(), _send_disp.data(),
+        dolfinx::MPI::mpi_type<T>(), recv_values.data(), _recv_count.data(),
+        _recv_disp.data(), dolfinx::MPI::mpi_type<T>(),
+        _index_maps[0]->comm(common::IndexMap::Direction::reverse));
+
+    for (std::size_t i = 0; i < _recv_pos.size(); ++i)
+      _values[_recv_pos[i]] += recv_values[i];
+    std::fill(_values.begin() + _row_ptr[_num_owned_rows], _values.end(), 0);
+  }
+
+  /// Compute the squared Frobenius norm of the matrix (owned rows)
+  /// @note Collective
+  /// @return Squared norm
+  double norm_squared() const
+  {
+    double norm = 0.0;
+    for (std::int32_t k = 0; k < _row_ptr[_num_owned_rows]; ++k)
+      norm += std::norm(_values[k]);
+    MPI_Allreduce(MPI_IN_PLACE, &norm, 1, MPI_DOUBLE, MPI_SUM,
+                  _index_maps[0]->comm());
+    return norm;
+  }
+
+  /// Copy the owned rows to a dense matrix with global column indexing.
+  /// Intended for testing and debugging on small problems.
+  /// @return Dense matrix
+  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  to_dense() const
+  {
+    const common::IndexMap& map1 = *_index_maps[1];
+    const int bs1 = map1.block_size();
+    const std::int32_t local_size1 = bs1 * map1.size_local();
+    const std::int64_t offset1 = bs1 * map1.local_range()[0];
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> A
+        = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic,
+                        Eigen::RowMajor>::Zero(_num_owned_rows,
+                                               bs1 * map1.size_global());
+    for (std::int32_t r = 0; r < _num_owned_rows; ++r)
+    {
+      for (std::int32_t k = _row_ptr[r]; k < _row_ptr[r + 1]; ++k)
+      {
+        const std::int64_t col = _cols[k] < local_size1
+                                     ? _cols[k] + offset1
+                                     : _ghost_cols[_cols[k] - local_size1];
+        A(r, col) = _values[k];
+      }
+    }
+    return A;
+  }
+
+  /// Index maps for the row and column space
+  const std::array<std::shared_ptr<const common::IndexMap>, 2>&
+  index_maps() const
+  {
+    return _index_maps;
+  }
+
+  /// Number of owned rows. Ghost rows follow the owned rows.
+  std::int32_t num_owned_rows() const { return _num_owned_rows; }
+
+  /// Offset of each row (owned and ghost) in the column and value
+  /// arrays
+  const std::vector<std::int32_t>& row_ptr() const { return _row_ptr; }
+
+  /// Local column index of each entry
+  const std::vector<std::int32_t>& cols() const { return _cols; }
+
+  /// Global index of each ghost column, i.e. of local columns from
+  /// bs1 * size_local of the column IndexMap onwards
+  const std::vector<std::int64_t>& ghost_cols() const { return _ghost_cols; }
+
+  /// Matrix values
+  std::vector<T>& values() { return _values; }
+
+  /// Matrix values (const version)
+  const std::vector<T>& values() const { return _values; }
+
+private:
+  // Position of entry (row, col) in the value array of CSR data
+  static std::int32_t position(const std::int32_t* row_ptr,
+                               const std::int32_t* cols, std::int32_t row,
+                               std::int32_t col)
+  {
+    const std::int32_t* begin = cols + row_ptr[row];
+    const std::int32_t* end = cols + row_ptr[row + 1];
+    const std::int32_t* it = std::lower_bound(begin, end, col);
+    if (it == end or *it != col)
+      throw std::runtime_error("Entry not in the sparsity pattern");
+    return std::distance(cols, it);
+  }
+
+  // Position of entry (row, col) in the value array
+  std::int32_t position(std::int32_t row, std::int32_t col) const
+  {
+    return position(_row_ptr.data(), _cols.data(), row, col);
+  }
+
+  // Index maps for the rows and columns
+  std::array<std::shared_ptr<const common::IndexMap>, 2> _index_maps;
+
+  // Number of owned rows
+  std::int32_t _num_owned_rows;
+
+  // CSR data
+  std::vector<std::int32_t> _row_ptr, _cols;
+  std::vector<T> _values;
+
+  // Global indices of ghost columns
+  std::vector<std::int64_t> _ghost_cols;
+
+  // Positions in _values of ghost row entries, ordered by destination
+  // rank, and the number of entries and displacements for each
+  // destination rank
+  std::vector<std::int32_t> _send_pos;
+  std::vector<int> _send_count, _send_disp;
+
+  // Positions in _values for received ghost row entries, and the
+  // number of entries and displacements for each source rank
+  std::vector<std::int32_t> _recv_pos;
+  std::vector<int> _recv_count, _recv_disp;
+
+  // Cached block positions (see MatrixCSR::block_positions) and their
+  // key
+  graph::AdjacencyList<std::int32_t> _block_positions;
+  std::optional<std::array<std::size_t, 2>> _block_positions_key;
+};
+
+} // namespace dolfinx::la
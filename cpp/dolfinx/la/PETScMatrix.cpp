@@ -44,6 +44,11 @@ Mat la::create_petsc_matrix(
 
   // Find common block size across rows/columns
   const int bs = (bs0 == bs1 ? bs0 : 1);
+  if (sparsity_pattern.blocked() and bs0 != bs1)
+  {
+    throw std::runtime_error(
+        "Blocked sparsity pattern requires equal row and column block sizes.");
+  }
 
   // Set matrix size
   ierr = MatSetSizes(A, m, n, M, N);
@@ -56,20 +61,40 @@ Mat la::create_petsc_matrix(
   const graph::AdjacencyList<std::int64_t>& off_diagonal_pattern
       = sparsity_pattern.off_diagonal_pattern();
 
+  // A blocked pattern is stored natively in block compressed row
+  // format (the type can still be changed from the options database)
+  if (sparsity_pattern.blocked())
+  {
+    ierr = MatSetType(A, MATBAIJ);
+    if (ierr != 0)
+      petsc_error(ierr, __FILE__, "MatSetType");
+  }
+
   // Apply PETSc options from the options database to the matrix (this
   // includes changing the matrix type to one specified by the user)
   ierr = MatSetFromOptions(A);
   if (ierr != 0)
     petsc_error(ierr, __FILE__, "MatSetFromOptions");
 
-  // Build data to initialise sparsity pattern (modify for block size)
+  // Build data to initialise sparsity pattern (modify for block size).
+  // The number of nonzero blocks in each block row is needed, which
+  // for a blocked pattern is the number of entries in each row.
   std::vector<PetscInt> _nnz_diag(index_maps[0]->size_local() * bs0 / bs),
       _nnz_offdiag(index_maps[0]->size_local() * bs0 / bs);
-
-  for (std::size_t i = 0; i < _nnz_diag.size(); ++i)
-    _nnz_diag[i] = diagonal_pattern.links(bs * i).rows() / bs;
-  for (std::size_t i = 0; i < _nnz_offdiag.size(); ++i)
-    _nnz_offdiag[i] = off_diagonal_pattern.links(bs * i).rows() / bs;
+  if (sparsity_pattern.blocked())
+  {
+    for (std::size_t i = 0; i < _nnz_diag.size(); ++i)
+      _nnz_diag[i] = diagonal_pattern.num_links(i);
+    for (std::size_t i = 0; i < _nnz_offdiag.size(); ++i)
+      _nnz_offdiag[i] = off_diagonal_pattern.num_links(i);
+  }
+  else
+  {
+    for (std::size_t i = 0; i < _nnz_diag.size(); ++i)
+      _nnz_diag[i] = diagonal_pattern.links(bs * i).rows() / bs;
+    for (std::size_t i = 0; i < _nnz_offdiag.size(); ++i)
+      _nnz_offdiag[i] = off_diagonal_pattern.links(bs * i).rows() / bs;
+  }
 
   // Allocate space for matrix
   ierr = MatXAIJSetPreallocation(A, bs, _nnz_diag.data(), _nnz_offdiag.data(),
@@ -166,20 +191,97 @@ PETScMatrix::add_fn(Mat A)
              std::int32_t m, const std::int32_t* rows, std::int32_t n,
              const std::int32_t* cols, const PetscScalar* vals) mutable {
     PetscErrorCode ierr;
+
+    // Insertion into a PETSc matrix is not thread-safe
+#pragma omp critical(dolfinx_petsc_mat_set)
+    {
 #ifdef PETSC_USE_64BIT_INDICES
-    cache.resize(m + n);
-    std::copy(rows, rows + m, cache.begin());
-    std::copy(cols, cols + n, cache.begin() + m);
-    const PetscInt *_rows = cache.data(), *_cols = _rows + m;
-    ierr = MatSetValuesLocal(A, m, _rows, n, _cols, vals, ADD_VALUES);
+      cache.resize(m + n);
+      std::copy(rows, rows + m, cache.begin());
+      std::copy(cols, cols + n, cache.begin() + m);
+      const PetscInt *_rows = cache.data(), *_cols = _rows + m;
+      ierr = MatSetValuesLocal(A, m, _rows, n, _cols, vals, ADD_VALUES);
 #else
-    ierr = MatSetValuesLocal(A, m, rows, n, cols, vals, ADD_VALUES);
+      ierr = MatSetValuesLocal(A, m, rows, n, cols, vals, ADD_VALUES);
 #endif
+    }
 
-#ifdef DEBUG
     if (ierr != 0)
       la::petsc_error(ierr, __FILE__, "MatSetValuesLocal");
-#endif
+    return 0;
+  };
+}
+//-----------------------------------------------------------------------------
+std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                  const std::int32_t*, const PetscScalar*)>
+PETScMatrix::add_block_fn(Mat A, const std::array<int, 2>& bs,
+                          const std::array<int, 2>& num_nodes)
+{
+  PetscInt bs0 = 1, bs1 = 1;
+  PetscErrorCode ierr = MatGetBlockSizes(A, &bs0, &bs1);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatGetBlockSizes");
+  if (bs0 != bs[0] or bs1 != bs[1])
+    throw std::runtime_error("Matrix block sizes do not match the dofmaps.");
+  if (num_nodes[0] < 1 or num_nodes[1] < 1)
+    throw std::runtime_error("Invalid number of nodes per cell.");
+
+  // Position in the node-major (blocked) ordering of dof b * n + j of a
+  // cell, where n is the number of nodes of the cell
+  auto block_positions = [](int bs, int n) {
+    std::vector<std::int32_t> pos(bs * n);
+    for (int b = 0; b < bs; ++b)
+      for (int j = 0; j < n; ++j)
+        pos[b * n + j] = j * bs + b;
+    return pos;
+  };
+
+  return [A, bs, num_nodes, add = add_fn(A),
+          pos0 = block_positions(bs[0], num_nodes[0]),
+          pos1 = block_positions(bs[1], num_nodes[1])](
+             std::int32_t m, const std::int32_t* rows, std::int32_t n,
+             const std::int32_t* cols, const PetscScalar* vals) {
+    const std::int32_t cell_size0 = bs[0] * num_nodes[0];
+    const std::int32_t cell_size1 = bs[1] * num_nodes[1];
+    if (m % cell_size0 != 0 or n % cell_size1 != 0)
+      return add(m, rows, n, cols, vals);
+
+    // Node indices, and the element matrix re-ordered from
+    // component-major to node-major rows and columns. The work arrays
+    // are per thread, so that only the insertion is serialised.
+    static thread_local std::vector<PetscInt> nodes;
+    static thread_local std::vector<PetscScalar> Ae;
+    const std::int32_t num_cells0 = m / cell_size0;
+    const std::int32_t num_cells1 = n / cell_size1;
+    nodes.resize(m / bs[0] + n / bs[1]);
+    PetscInt* nodes0 = nodes.data();
+    PetscInt* nodes1 = nodes0 + m / bs[0];
+    for (std::int32_t c = 0; c < num_cells0; ++c)
+      for (int j = 0; j < num_nodes[0]; ++j)
+        nodes0[c * num_nodes[0] + j] = rows[c * cell_size0 + j] / bs[0];
+    for (std::int32_t c = 0; c < num_cells1; ++c)
+      for (int j = 0; j < num_nodes[1]; ++j)
+        nodes1[c * num_nodes[1] + j] = cols[c * cell_size1 + j] / bs[1];
+
+    Ae.resize(m * n);
+    for (std::int32_t i = 0; i < m; ++i)
+    {
+      const std::int32_t row
+          = (i / cell_size0) * cell_size0 + pos0[i % cell_size0];
+      for (std::int32_t j = 0; j < n; ++j)
+      {
+        const std::int32_t col
+            = (j / cell_size1) * cell_size1 + pos1[j % cell_size1];
+        Ae[row * n + col] = vals[i * n + j];
+      }
+    }
+
+    PetscErrorCode ierr;
+#pragma omp critical(dolfinx_petsc_mat_set)
+    ierr = MatSetValuesBlockedLocal(A, m / bs[0], nodes0, n / bs[1], nodes1,
+                                    Ae.data(), ADD_VALUES);
+    if (ierr != 0)
+      la::petsc_error(ierr, __FILE__, "MatSetValuesBlockedLocal");
     return 0;
   };
 }
@@ -38,11 +38,33 @@ class PETScMatrix : public PETScOperator
 {
 public:
   /// Return a function with an interface for adding values to the
-  /// matrix A
+  /// matrix A. Insertion is serialised, so the function can be called
+  /// from threaded assemblers.
   static std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
                            const std::int32_t*, const PetscScalar*)>
   add_fn(Mat A);
 
+  /// Return a function with an interface for adding values to the
+  /// block matrix A (e.g. MATBAIJ), which inserts element matrices
+  /// block-wise (MatSetValuesBlockedLocal). The function takes the same
+  /// (unblocked) dof indices and element matrix as the function
+  /// returned by PETScMatrix::add_fn. The dofs must be the dofs of one
+  /// or more cells in the layout of a blocked fem::DofMap, i.e. dof
+  /// b * n + j of a cell is bs * node_j + b, where n is the number of
+  /// nodes of the cell (see fem::DofMap::bs and
+  /// fem::DofMap::list_blocked). Values for a number of dofs that is
+  /// not a multiple of bs * n, e.g. diagonal entries, are inserted as
+  /// for PETScMatrix::add_fn. Insertion is serialised, so the function
+  /// can be called from threaded assemblers.
+  /// @param[in] A The matrix. Its block sizes must be @p bs.
+  /// @param[in] bs The block size of the row and column dofmaps
+  /// @param[in] num_nodes The number of nodes of a cell for the row and
+  ///   column dofmaps
+  static std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                           const std::int32_t*, const PetscScalar*)>
+  add_block_fn(Mat A, const std::array<int, 2>& bs,
+               const std::array<int, 2>& num_nodes);
+
   /// Create holder of a PETSc Mat object from a sparsity pattern
   PETScMatrix(MPI_Comm comm, const SparsityPattern& sparsity_pattern);
 
@@ -11,19 +11,49 @@
 #include <dolfinx/common/log.h>
 #include <dolfinx/fem/utils.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <numeric>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Number of unique entries in the union of two sorted ranges of unique
+// entries
+template <typename T>
+std::int32_t union_size(const T* a0, const T* a1, const T* b0, const T* b1)
+{
+  std::int32_t n = 0;
+  while (a0 != a1 and b0 != b1)
+  {
+    if (*a0 < *b0)
+      ++a0;
+    else if (*b0 < *a0)
+      ++b0;
+    else
+    {
+      ++a0;
+      ++b0;
+    }
+    ++n;
+  }
+  return n + (a1 - a0) + (b1 - b0);
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 SparsityPattern::SparsityPattern(
     MPI_Comm comm,
-    const std::array<std::shared_ptr<const common::IndexMap>, 2>& index_maps)
-    : _mpi_comm(comm), _index_maps(index_maps)
+    const std::array<std::shared_ptr<const common::IndexMap>, 2>& index_maps,
+    bool blocked)
+    : _mpi_comm(comm), _index_maps(index_maps), _blocked(blocked)
 {
+  if (!blocked)
+    _bs = {index_maps[0]->block_size(), index_maps[1]->block_size()};
   const std::int32_t local_size0
-      = index_maps[0]->block_size()
-        * (index_maps[0]->size_local() + index_maps[0]->num_ghosts());
+      = _bs[0] * (index_maps[0]->size_local() + index_maps[0]->num_ghosts());
   _diagonal_cache.resize(local_size0);
   _off_diagonal_cache.resize(local_size0);
 }
@@ -120,12 +150,44 @@ SparsityPattern::SparsityPattern(
         throw std::runtime_error("Sub-sparsity pattern has been finalised. "
                                  "Cannot compute stacked pattern.");
       }
+      if (p->_blocked)
+      {
+        throw std::runtime_error("Sub-sparsity pattern is blocked. "
+                                 "Cannot compute stacked pattern.");
+      }
+
+      // Copy entries of the sub-pattern that were inserted in CSR
+      // format to the caches of the new pattern
+      const int bs1 = maps[1][col].get().block_size();
+      const std::int32_t local_size1
+          = bs1 * maps[1][col].get().size_local();
+      const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts1
+          = maps[1][col].get().ghosts();
+      auto insert_csr_row = [&](std::int32_t i, std::int32_t r_new) {
+        if (!p->_csr_cache)
+          return;
+        auto cols = p->_csr_cache->links(i);
+        for (Eigen::Index j = 0; j < cols.rows(); ++j)
+        {
+          if (cols[j] < local_size1)
+            _diagonal_cache[r_new].push_back(cols[j] + local_offset1[col]);
+          else
+          {
+            const std::div_t div = std::div(cols[j] - local_size1, bs1);
+            auto it = col_old_to_new[col].find(bs1 * ghosts1[div.quot]
+                                               + div.rem);
+            assert(it != col_old_to_new[col].end());
+            _off_diagonal_cache[r_new].push_back(it->second);
+          }
+        }
+      };
 
       // Loop over owned rows
       for (int i = 0; i < num_rows_local; ++i)
       {
         // New local row index
         const std::int32_t r_new = i + local_offset0[row];
+        insert_csr_row(i, r_new);
 
         // Insert diagonal block entries (local column indices)
         const std::vector<std::int32_t>& cols = p->_diagonal_cache[i];
@@ -148,6 +210,7 @@ SparsityPattern::SparsityPattern(
         // New local row index
         const std::int32_t r_new
             = i + local_offset0.back() + ghost_offsets0[row];
+        insert_csr_row(num_rows_local + i, r_new);
 
         // Insert diagonal block entries (local column indices)
         const std::vector<std::int32_t>& cols
@@ -182,6 +245,8 @@ SparsityPattern::index_map(int dim) const
   return _index_maps.at(dim);
 }
 //-----------------------------------------------------------------------------
+bool SparsityPattern::blocked() const { return _blocked; }
+//-----------------------------------------------------------------------------
 void SparsityPattern::insert(
     const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>& rows,
     const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>& cols)
@@ -193,12 +258,12 @@ void SparsityPattern::insert(
   }
 
   assert(_index_maps[0]);
-  const int bs0 = _index_maps[0]->block_size();
+  const int bs0 = _bs[0];
   const std::int32_t size0
       = bs0 * (_index_maps[0]->size_local() + _index_maps[0]->num_ghosts());
 
   assert(_index_maps[1]);
-  const int bs1 = _index_maps[1]->block_size();
+  const int bs1 = _bs[1];
   const std::int32_t local_size1 = _index_maps[1]->size_local();
   const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts1
       = _index_maps[1]->ghosts();
@@ -227,6 +292,49 @@ void SparsityPattern::insert(
   }
 }
 //-----------------------------------------------------------------------------
+void SparsityPattern::insert_csr(graph::AdjacencyList<std::int32_t>&& pattern)
+{
+  if (_diagonal)
+  {
+    throw std::runtime_error(
+        "Cannot insert into sparsity pattern. It has already been assembled");
+  }
+
+  if (pattern.num_nodes() != (std::int32_t)_diagonal_cache.size())
+    throw std::runtime_error("Number of rows does not match sparsity pattern.");
+
+  if (!_csr_cache)
+  {
+    _csr_cache = std::make_shared<graph::AdjacencyList<std::int32_t>>(
+        std::move(pattern));
+    return;
+  }
+
+  // Merge with previously inserted entries
+  const std::int32_t num_rows = pattern.num_nodes();
+  const graph::AdjacencyList<std::int32_t>& p0 = *_csr_cache;
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> offsets(num_rows + 1);
+  offsets[0] = 0;
+  for (std::int32_t r = 0; r < num_rows; ++r)
+  {
+    auto c0 = p0.links(r);
+    auto c1 = pattern.links(r);
+    offsets[r + 1] = offsets[r]
+                     + union_size(c0.data(), c0.data() + c0.rows(),
+                                  c1.data(), c1.data() + c1.rows());
+  }
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> data(offsets[num_rows]);
+  for (std::int32_t r = 0; r < num_rows; ++r)
+  {
+    auto c0 = p0.links(r);
+    auto c1 = pattern.links(r);
+    std::set_union(c0.data(), c0.data() + c0.rows(), c1.data(),
+                   c1.data() + c1.rows(), data.data() + offsets[r]);
+  }
+  _csr_cache = std::make_shared<graph::AdjacencyList<std::int32_t>>(
+      std::move(data), std::move(offsets));
+}
+//-----------------------------------------------------------------------------
 void SparsityPattern::insert_diagonal(
     const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>& rows)
 {
@@ -237,7 +345,7 @@ void SparsityPattern::insert_diagonal(
   }
 
   assert(_index_maps[0]);
-  const int bs0 = _index_maps[0]->block_size();
+  const int bs0 = _bs[0];
   const std::int32_t local_size0
       = bs0 * (_index_maps[0]->size_local() + _index_maps[0]->num_ghosts());
   for (Eigen::Index i = 0; i < rows.rows(); ++i)
@@ -259,7 +367,7 @@ void SparsityPattern::assemble()
   assert(!_off_diagonal);
 
   assert(_index_maps[0]);
-  const int bs0 = _index_maps[0]->block_size();
+  const int bs0 = _bs[0];
   const std::int32_t local_size0 = _index_maps[0]->size_local();
   const std::int32_t num_ghosts0 = _index_maps[0]->num_ghosts();
   const std::array local_range0 = _index_maps[0]->local_range();
@@ -267,15 +375,24 @@ void SparsityPattern::assemble()
       = _index_maps[0]->ghosts();
 
   assert(_index_maps[1]);
-  const int bs1 = _index_maps[1]->block_size();
+  const int bs1 = _bs[1];
   const std::int32_t local_size1 = _index_maps[1]->size_local();
   const std::array local_range1 = _index_maps[1]->local_range();
   const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& ghosts1
       = _index_maps[1]->ghosts();
 
+  // Convert local column index to global column index
+  auto col_to_global = [&](std::int32_t col) -> std::int64_t {
+    if (col < bs1 * local_size1)
+      return col + bs1 * local_range1[0];
+    const std::div_t div = std::div(col, bs1);
+    return bs1 * ghosts1[div.quot - local_size1] + div.rem;
+  };
+
   // For each ghost row, pack and send (global row, global col) pairs to
-  // send to neighborhood
+  // send to neighborhood. Also keep the columns of each ghost row.
   std::vector<std::int64_t> ghost_data;
+  std::vector<std::vector<std::int64_t>> ghost_rows(bs0 * num_ghosts0);
   for (int i = 0; i < num_ghosts0; ++i)
   {
     const std::int64_t row_node_global = ghosts0[i];
@@ -284,29 +401,28 @@ void SparsityPattern::assemble()
     {
       const std::int64_t row_global = bs0 * row_node_global + j;
       const std::int32_t row_local = bs0 * row_node_local + j;
+      std::vector<std::int64_t>& ghost_row
+          = ghost_rows[row_local - bs0 * local_size0];
       assert((std::size_t)row_local < _diagonal_cache.size());
       const std::vector<std::int32_t>& cols = _diagonal_cache[row_local];
       for (std::size_t c = 0; c < cols.size(); ++c)
-      {
-        ghost_data.push_back(row_global);
-
-        // Convert to global column index
-        if (cols[c] < bs1 * local_size1)
-          ghost_data.push_back(cols[c] + bs1 * local_range1[0]);
-        else
-        {
-          const std::div_t div = std::div(cols[c], bs1);
-          const std::int64_t block_global = ghosts1[div.quot - local_size1];
-          ghost_data.push_back(bs1 * block_global + div.rem);
-        }
-      }
+        ghost_row.push_back(col_to_global(cols[c]));
 
       const std::vector<std::int64_t>& cols_off
           = _off_diagonal_cache[row_local];
-      for (std::size_t c = 0; c < cols_off.size(); ++c)
+      ghost_row.insert(ghost_row.end(), cols_off.begin(), cols_off.end());
+
+      if (_csr_cache)
+      {
+        auto cols_csr = _csr_cache->links(row_local);
+        for (Eigen::Index c = 0; c < cols_csr.rows(); ++c)
+          ghost_row.push_back(col_to_global(cols_csr[c]));
+      }
+
+      for (std::int64_t col : ghost_row)
       {
         ghost_data.push_back(row_global);
-        ghost_data.push_back(cols_off[c]);
+        ghost_data.push_back(col);
       }
     }
   }
@@ -361,25 +477,93 @@ void SparsityPattern::assemble()
     }
   }
 
-  _diagonal_cache.resize(bs0 * local_size0);
-  for (std::vector<std::int32_t>& row : _diagonal_cache)
+  // Build the diagonal and off-diagonal blocks for the owned rows from
+  // the caches. The number of entries in each row is computed first, so
+  // that the blocks can be filled directly.
+  const std::int32_t num_owned_rows = bs0 * local_size0;
+  _diagonal_cache.resize(num_owned_rows);
+  _off_diagonal_cache.resize(num_owned_rows);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> offsets_diag(num_owned_rows
+                                                             + 1);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> offsets_off(num_owned_rows
+                                                            + 1);
+  offsets_diag[0] = 0;
+  offsets_off[0] = 0;
+
+  // Columns of row r inserted in CSR format that are in the diagonal
+  // block. These precede the off-diagonal columns as the columns are
+  // sorted.
+  auto csr_diagonal = [&](std::int32_t r) {
+    auto cols = _csr_cache->links(r);
+    const std::int32_t* begin = cols.data();
+    const std::int32_t* end
+        = std::lower_bound(begin, begin + cols.rows(), bs1 * local_size1);
+    return std::pair(begin, end);
+  };
+
+#pragma omp parallel for schedule(static)
+  for (std::int32_t r = 0; r < num_owned_rows; ++r)
   {
-    std::sort(row.begin(), row.end());
-    row.erase(std::unique(row.begin(), row.end()), row.end());
+    std::vector<std::int32_t>& diag = _diagonal_cache[r];
+    std::sort(diag.begin(), diag.end());
+    diag.erase(std::unique(diag.begin(), diag.end()), diag.end());
+    std::vector<std::int64_t>& off = _off_diagonal_cache[r];
+    std::int32_t num_diag = diag.size();
+    if (_csr_cache)
+    {
+      auto [begin, end] = csr_diagonal(r);
+      num_diag = union_size(diag.data(), diag.data() + diag.size(), begin,
+                            end);
+      auto cols = _csr_cache->links(r);
+      for (const std::int32_t* c = end; c != cols.data() + cols.rows(); ++c)
+        off.push_back(col_to_global(*c));
+    }
+    std::sort(off.begin(), off.end());
+    off.erase(std::unique(off.begin(), off.end()), off.end());
+    offsets_diag[r + 1] = num_diag;
+    offsets_off[r + 1] = off.size();
+  }
+  std::partial_sum(offsets_diag.data(),
+                   offsets_diag.data() + offsets_diag.rows(),
+                   offsets_diag.data());
+  std::partial_sum(offsets_off.data(), offsets_off.data() + offsets_off.rows(),
+                   offsets_off.data());
+
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> data_diag(
+      offsets_diag[num_owned_rows]);
+  Eigen::Array<std::int64_t, Eigen::Dynamic, 1> data_off(
+      offsets_off[num_owned_rows]);
+#pragma omp parallel for schedule(static)
+  for (std::int32_t r = 0; r < num_owned_rows; ++r)
+  {
+    const std::vector<std::int32_t>& diag = _diagonal_cache[r];
+    if (_csr_cache)
+    {
+      auto [begin, end] = csr_diagonal(r);
+      std::set_union(diag.begin(), diag.end(), begin, end,
+                     data_diag.data() + offsets_diag[r]);
+    }
+    else
+      std::copy(diag.begin(), diag.end(), data_diag.data() + offsets_diag[r]);
+    const std::vector<std::int64_t>& off = _off_diagonal_cache[r];
+    std::copy(off.begin(), off.end(), data_off.data() + offsets_off[r]);
   }
-  _diagonal
-      = std::make_shared<graph::AdjacencyList<std::int32_t>>(_diagonal_cache);
   std::vector<std::vector<std::int32_t>>().swap(_diagonal_cache);
+  std::vector<std::vector<std::int64_t>>().swap(_off_diagonal_cache);
+  _csr_cache.reset();
+
+  _diagonal = std::make_shared<graph::AdjacencyList<std::int32_t>>(
+      std::move(data_diag), std::move(offsets_diag));
+  _off_diagonal = std::make_shared<graph::AdjacencyList<std::int64_t>>(
+      std::move(data_off), std::move(offsets_off));
 
-  _off_diagonal_cache.resize(bs0 * local_size0);
-  for (std::vector<std::int64_t>& row : _off_diagonal_cache)
+  for (std::vector<std::int64_t>& row : ghost_rows)
   {
     std::sort(row.begin(), row.end());
     row.erase(std::unique(row.begin(), row.end()), row.end());
   }
-  _off_diagonal = std::make_shared<graph::AdjacencyList<std::int64_t>>(
-      _off_diagonal_cache);
-  std::vector<std::vector<std::int64_t>>().swap(_off_diagonal_cache);
+  _ghost_rows
+      = std::make_shared<graph::AdjacencyList<std::int64_t>>(ghost_rows);
 }
 //-----------------------------------------------------------------------------
 std::int64_t SparsityPattern::num_nonzeros() const
@@ -406,5 +590,13 @@ SparsityPattern::off_diagonal_pattern() const
   return *_off_diagonal;
 }
 //-----------------------------------------------------------------------------
+const graph::AdjacencyList<std::int64_t>&
+SparsityPattern::ghost_row_pattern() const
+{
+  if (!_ghost_rows)
+    throw std::runtime_error("Sparsity pattern has not been finalised.");
+  return *_ghost_rows;
+}
+//-----------------------------------------------------------------------------
 MPI_Comm SparsityPattern::mpi_comm() const { return _mpi_comm.comm(); }
 //-----------------------------------------------------------------------------
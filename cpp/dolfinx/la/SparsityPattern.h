@@ -38,9 +38,19 @@ class SparsityPattern
 
 public:
   /// Create an empty sparsity pattern with specified dimensions
+  /// @param[in] comm The MPI communicator
+  /// @param[in] index_maps Index maps for the rows (0) and the columns
+  ///   (1)
+  /// @param[in] blocked If true, the pattern is built on the blocks of
+  ///   the index maps, i.e. row and column indices are block (node)
+  ///   indices of the index maps and each entry of the pattern is a
+  ///   dense bs0 x bs1 block, where bs0 and bs1 are the block sizes of
+  ///   the index maps. Otherwise, the indices are the block size times
+  ///   the index map indices plus the component.
   SparsityPattern(
       MPI_Comm comm,
-      const std::array<std::shared_ptr<const common::IndexMap>, 2>& index_maps);
+      const std::array<std::shared_ptr<const common::IndexMap>, 2>& index_maps,
+      bool blocked = false);
 
   /// Create a new sparsity pattern by concatenating sub-patterns, e.g.
   /// pattern =[ pattern00 ][ pattern 01]
@@ -48,7 +58,8 @@ public:
   ///
   /// @param[in] comm The MPI communicator
   /// @param[in] patterns Rectangular array of sparsity pattern. The
-  ///   patterns must not be finalised. Null block are permited
+  ///   patterns must not be finalised or blocked. Null block are
+  ///   permited
   /// @param[in] maps Index maps for each row block (maps[0]) and column
   ///   blocks (maps[1])
   SparsityPattern(
@@ -69,19 +80,34 @@ public:
   /// Move assignment
   SparsityPattern& operator=(SparsityPattern&& pattern) = default;
 
-  /// Return local range for dimension dim
+  /// Return local range for dimension dim. The range is always for
+  /// the unblocked indices, i.e. the matrix rows or columns.
   std::array<std::int64_t, 2> local_range(int dim) const;
 
   /// Return index map for dimension dim
   std::shared_ptr<const common::IndexMap> index_map(int dim) const;
 
-  /// Insert non-zero locations using local (process-wise) indices
+  /// Return true if the pattern is built on the blocks of the index
+  /// maps (see SparsityPattern::SparsityPattern)
+  bool blocked() const;
+
+  /// Insert non-zero locations using local (process-wise) indices.
+  /// For a blocked pattern the indices are block indices.
   void
   insert(const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
              rows,
          const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
              cols);
 
+  /// Insert non-zero locations given in compressed sparse row format,
+  /// using local (process-wise) indices. The entries are kept in a
+  /// single buffer until the pattern is finalised, which uses much less
+  /// memory than SparsityPattern::insert for large patterns.
+  /// @param[in] pattern The columns of each local row (owned rows
+  ///   followed by ghost rows). The columns of each row must be sorted
+  ///   and unique.
+  void insert_csr(graph::AdjacencyList<std::int32_t>&& pattern);
+
   /// Insert non-zero locations on the diagonal
   /// @param[in] rows The rows in local (process-wise) indices. The
   ///   indices must exist in the row IndexMap.
@@ -92,7 +118,8 @@ public:
   /// Finalize sparsity pattern and communicate off-process entries
   void assemble();
 
-  /// Return number of local nonzeros
+  /// Return number of local nonzeros. For a blocked pattern this is the
+  /// number of nonzero blocks.
   std::int64_t num_nonzeros() const;
 
   /// Sparsity pattern for the owned (diagonal) block. Uses local
@@ -103,6 +130,13 @@ public:
   /// indices for the columns.
   const graph::AdjacencyList<std::int64_t>& off_diagonal_pattern() const;
 
+  /// Sparsity pattern for the ghost rows, i.e. rows that are owned by
+  /// other processes and have entries inserted on this process. Row i
+  /// is the local row bs0 * size_local + i, where bs0 and size_local
+  /// are the block size (one for a blocked pattern) and number of owned
+  /// indices of the row IndexMap. Uses global indices for the columns.
+  const graph::AdjacencyList<std::int64_t>& ghost_row_pattern() const;
+
   /// Return MPI communicator
   MPI_Comm mpi_comm() const;
 
@@ -113,13 +147,26 @@ private:
   // common::IndexMaps for each dimension
   std::array<std::shared_ptr<const common::IndexMap>, 2> _index_maps;
 
+  // True if the pattern indices are the block indices of the index
+  // maps
+  bool _blocked = false;
+
+  // Number of pattern indices per index of each index map (one for a
+  // blocked pattern, otherwise the index map block size)
+  std::array<int, 2> _bs = {1, 1};
+
   // Caches for diagonal and off-diagonal blocks
   std::vector<std::vector<std::int32_t>> _diagonal_cache;
   std::vector<std::vector<std::int64_t>> _off_diagonal_cache;
 
+  // Cache for entries inserted in compressed sparse row format (local
+  // indices)
+  std::shared_ptr<graph::AdjacencyList<std::int32_t>> _csr_cache;
+
   // Sparsity pattern data (computed once pattern is finalised)
   std::shared_ptr<graph::AdjacencyList<std::int32_t>> _diagonal;
   std::shared_ptr<graph::AdjacencyList<std::int64_t>> _off_diagonal;
+  std::shared_ptr<graph::AdjacencyList<std::int64_t>> _ghost_rows;
 };
 } // namespace la
 } // namespace dolfinx
@@ -6,19 +6,40 @@
 
 #pragma once
 
+#include "utils.h"
 #include <Eigen/Dense>
+#include <cmath>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ScatterPlan.h>
+#include <functional>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 namespace dolfinx::la
 {
 
-/// Distributed vector
+/// Distributed vector. The local data holds the values for the owned
+/// indices followed by the values for the ghost indices of the index
+/// map. The values are stored in an Eigen array, and only the Eigen
+/// heap alignment (EIGEN_MAX_ALIGN_BYTES) is guaranteed. This is 16
+/// bytes by default, and larger only when compiling for wider SIMD
+/// instructions (32 bytes with AVX, 64 bytes with AVX-512). Alignment
+/// to a cache line is not enforced.
+///
+/// Reductions (inner products and norms) and the BLAS-1 operations
+/// act on the owned values only. Ghost values are updated by a forward
+/// scatter.
 
 template <typename T>
 class Vector
 {
 public:
+  /// Real type of the scalar type T
+  using real_type = typename Eigen::NumTraits<T>::Real;
+
   /// Create vector
   Vector(const std::shared_ptr<const common::IndexMap>& map) : _map(map)
   {
@@ -29,7 +50,10 @@ public:
   }
 
   /// Copy constructor
-  Vector(const Vector& x) = default;
+  Vector(const Vector& x) : _map(x._map), _x(x._x), _version(x._version)
+  {
+    // Do nothing
+  }
 
   /// Move constructor
   Vector(Vector&& x) noexcept = default;
@@ -49,14 +73,204 @@ public:
   /// Get local part of the vector (const version)
   const Eigen::Matrix<T, Eigen::Dynamic, 1>& array() const { return _x; }
 
-  /// Get local part of the vector
+  /// Get local part of the vector. Modifications through the returned
+  /// reference are not tracked by the version counter: call
+  /// Vector::increment_version after modifying the values.
   Eigen::Matrix<T, Eigen::Dynamic, 1>& array() { return _x; }
 
+  /// Number of owned values, i.e. block size times the number of owned
+  /// indices
+  std::int32_t size_owned() const
+  {
+    return _map->block_size() * _map->size_local();
+  }
+
+  /// Start sending the owned values to the processes that have them as
+  /// ghosts. The owned values can be modified once the call returns.
+  void scatter_fwd_begin()
+  {
+    plan().scatter_fwd_begin(_x.head(size_owned()));
+  }
+
+  /// Complete a forward scatter started with scatter_fwd_begin, setting
+  /// the ghost values
+  void scatter_fwd_end()
+  {
+    plan().scatter_fwd_end(_x.tail(_x.rows() - size_owned()));
+    ++_version;
+  }
+
+  /// Set the ghost values to the values on the owning processes
+  void scatter_fwd()
+  {
+    scatter_fwd_begin();
+    scatter_fwd_end();
+  }
+
+  /// Start sending the ghost values to the owning processes. The ghost
+  /// values can be modified once the call returns.
+  void scatter_rev_begin()
+  {
+    plan().scatter_rev_begin(_x.tail(_x.rows() - size_owned()));
+  }
+
+  /// Complete a reverse scatter started with scatter_rev_begin
+  /// @param[in] op Sum or set received values in the owned values
+  void scatter_rev_end(common::IndexMap::Mode op)
+  {
+    plan().scatter_rev_end(_x.head(size_owned()), op);
+    ++_version;
+  }
+
+  /// Sum or set the ghost values into the owned values on the owning
+  /// processes
+  /// @param[in] op Sum or set received values in the owned values
+  void scatter_rev(common::IndexMap::Mode op)
+  {
+    scatter_rev_begin();
+    scatter_rev_end(op);
+  }
+
+  /// Set all values, including ghosts
+  /// @param[in] alpha The value
+  void set(T alpha)
+  {
+    _x.setConstant(alpha);
+    ++_version;
+  }
+
+  /// Scale the owned values, x = alpha * x
+  /// @param[in] alpha The scaling factor
+  void scale(T alpha)
+  {
+    _x.head(size_owned()) *= alpha;
+    ++_version;
+  }
+
+  /// Compute x = x + alpha * y on the owned values
+  /// @param[in] alpha The scaling factor for y
+  /// @param[in] y A vector with the same layout as this vector
+  void axpy(T alpha, const Vector& y)
+  {
+    const std::int32_t n = size_owned();
+    assert(y.size_owned() == n);
+    _x.head(n).noalias() += alpha * y._x.head(n);
+    ++_version;
+  }
+
+  /// Compute x = alpha * y + beta * z on the owned values
+  /// @param[in] alpha The scaling factor for y
+  /// @param[in] y A vector with the same layout as this vector
+  /// @param[in] beta The scaling factor for z
+  /// @param[in] z A vector with the same layout as this vector
+  void waxpby(T alpha, const Vector& y, T beta, const Vector& z)
+  {
+    const std::int32_t n = size_owned();
+    assert(y.size_owned() == n);
+    assert(z.size_owned() == n);
+    _x.head(n).noalias() = alpha * y._x.head(n) + beta * z._x.head(n);
+    ++_version;
+  }
+
+  /// Compute the inner product of this vector and y. For complex
+  /// vectors this vector is conjugated.
+  /// @param[in] y A vector with the same layout as this vector
+  /// @return The inner product
+  T dot(const Vector& y) const
+  {
+    T value = _x.head(size_owned()).dot(y._x.head(size_owned()));
+    MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI::mpi_type<T>(), MPI_SUM,
+                  _map->comm());
+    return value;
+  }
+
+  /// Compute a norm of the vector
+  /// @param[in] type The norm type. Supported types are l1, l2 and
+  ///   linf.
+  /// @return The norm
+  real_type norm(Norm type = Norm::l2) const
+  {
+    auto x = _x.head(size_owned());
+    real_type value = 0;
+    switch (type)
+    {
+    case Norm::l1:
+      value = x.cwiseAbs().sum();
+      MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI::mpi_type<real_type>(),
+                    MPI_SUM, _map->comm());
+      return value;
+    case Norm::l2:
+      value = x.squaredNorm();
+      MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI::mpi_type<real_type>(),
+                    MPI_SUM, _map->comm());
+      return std::sqrt(value);
+    case Norm::linf:
+      value = x.size() > 0 ? x.cwiseAbs().maxCoeff() : 0;
+      MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI::mpi_type<real_type>(),
+                    MPI_MAX, _map->comm());
+      return value;
+    default:
+      throw std::runtime_error("Norm type not supported.");
+    }
+  }
+
+  /// Version counter. The counter is incremented by the member
+  /// functions that modify the values, and by Vector::increment_version.
+  /// It is used to detect changes, e.g. by cached data that depends on
+  /// the vector values. Writes through Vector::array are not detected
+  /// unless the writer increments the version.
+  /// @return The version
+  std::uint64_t version() const { return _version; }
+
+  /// Mark the vector data as modified. Call this after modifying the
+  /// values through Vector::array.
+  void increment_version() { ++_version; }
+
 private:
+  // Scatter plan, created on first use
+  common::ScatterPlan<T>& plan()
+  {
+    if (!_scatter_plan)
+    {
+      _scatter_plan = std::make_unique<common::ScatterPlan<T>>(
+          *_map, _map->block_size());
+    }
+    return *_scatter_plan;
+  }
+
   // Map describing the data layout
   std::shared_ptr<const common::IndexMap> _map;
 
   // Data
   Eigen::Matrix<T, Eigen::Dynamic, 1> _x;
+
+  // Version counter, incremented on modification of _x
+  std::uint64_t _version = 0;
+
+  // Plan for ghost updates
+  std::unique_ptr<common::ScatterPlan<T>> _scatter_plan;
 };
+
+/// Compute the inner products of x with each of the vectors y, using a
+/// single global reduction. For complex vectors x is conjugated.
+/// @param[in] x A vector
+/// @param[in] y Vectors with the same layout as x
+/// @return The inner products (x, y[i])
+template <typename T>
+std::vector<T>
+inner_products(const Vector<T>& x,
+               const std::vector<std::reference_wrapper<const Vector<T>>>& y)
+{
+  const std::int32_t n = x.size_owned();
+  std::vector<T> values(y.size());
+  for (std::size_t i = 0; i < y.size(); ++i)
+  {
+    assert(y[i].get().size_owned() == n);
+    values[i] = x.array().head(n).dot(y[i].get().array().head(n));
+  }
+  MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(),
+                MPI::mpi_type<T>(), MPI_SUM, x.map()->comm());
+  return values;
+}
+
 } // namespace dolfinx::la
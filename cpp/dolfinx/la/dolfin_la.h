@@ -11,6 +11,7 @@ namespace dolfinx
 
 // DOLFINX la interface
 
+#include <dolfinx/la/MatrixCSR.h>
 #include <dolfinx/la/PETScKrylovSolver.h>
 #include <dolfinx/la/PETScMatrix.h>
 #include <dolfinx/la/PETScOperator.h>
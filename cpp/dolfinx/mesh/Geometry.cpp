@@ -55,11 +55,7 @@ const std::vector<std::int64_t>& Geometry::input_global_indices() const
 std::size_t Geometry::hash() const
 {
   // Compute local hash
-  boost::hash<std::vector<double>> dhash;
-
-  std::vector<double> data(_x.data(), _x.data() + _x.size());
-  const std::size_t local_hash = dhash(data);
-  return local_hash;
+  return boost::hash_range(_x.data(), _x.data() + _x.size());
 }
 //-----------------------------------------------------------------------------
 
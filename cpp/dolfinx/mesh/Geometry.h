@@ -103,9 +103,8 @@ public:
   /// Global user indices
   const std::vector<std::int64_t>& input_global_indices() const;
 
-  /// Hash of coordinate values
-  /// @return A tree-hashed value of the coordinates over all MPI
-  ///   processes
+  /// Hash of coordinate values on this process (not collective)
+  /// @return A hashed value of the coordinates on this process
   std::size_t hash() const;
 
 private:
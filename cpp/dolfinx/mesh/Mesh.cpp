@@ -30,32 +30,22 @@ using namespace dolfinx::mesh;
 namespace
 {
 //-----------------------------------------------------------------------------
-Eigen::ArrayXd cell_h(const mesh::Mesh& mesh)
+const Eigen::ArrayXd& cell_h(const mesh::Mesh& mesh)
 {
-  const int dim = mesh.topology().dim();
-  auto map = mesh.topology().index_map(dim);
-  assert(map);
-  const std::int32_t num_cells = map->size_local() + map->num_ghosts();
-  if (num_cells == 0)
+  const Eigen::ArrayXd& h
+      = mesh.entity_metric(mesh::EntityMetric::h, mesh.topology().dim());
+  if (h.size() == 0)
     throw std::runtime_error("Cannot compute h min/max. No cells.");
-
-  Eigen::ArrayXi cells(num_cells);
-  std::iota(cells.data(), cells.data() + cells.size(), 0);
-  return mesh::h(mesh, cells, dim);
+  return h;
 }
 //-----------------------------------------------------------------------------
-Eigen::ArrayXd cell_r(const mesh::Mesh& mesh)
+const Eigen::ArrayXd& cell_r(const mesh::Mesh& mesh)
 {
-  const int dim = mesh.topology().dim();
-  auto map = mesh.topology().index_map(dim);
-  assert(map);
-  const std::int32_t num_cells = map->size_local() + map->num_ghosts();
-  if (num_cells == 0)
+  const Eigen::ArrayXd& r = mesh.entity_metric(mesh::EntityMetric::inradius,
+                                               mesh.topology().dim());
+  if (r.size() == 0)
     throw std::runtime_error("Cannnot compute inradius min/max. No cells.");
-
-  Eigen::ArrayXi cells(num_cells);
-  std::iota(cells.data(), cells.data() + cells.size(), 0);
-  return mesh::inradius(mesh, cells);
+  return r;
 }
 //-----------------------------------------------------------------------------
 } // namespace
@@ -148,6 +138,24 @@ Geometry& Mesh::geometry() { return _geometry; }
 //-----------------------------------------------------------------------------
 const Geometry& Mesh::geometry() const { return _geometry; }
 //-----------------------------------------------------------------------------
+const Eigen::ArrayXd& Mesh::entity_metric(EntityMetric metric, int dim) const
+{
+  // The coordinates may be modified through a reference to
+  // Geometry::x that is held by the caller, so the cache is validated
+  // against a hash of the coordinates
+  const std::size_t x_hash = _geometry.hash();
+  auto it = _entity_metrics.find({metric, dim});
+  if (it == _entity_metrics.end() or it->second.first != x_hash)
+  {
+    Eigen::ArrayXd values = mesh::compute_entity_metric(*this, metric, dim);
+    it = _entity_metrics
+             .insert_or_assign({metric, dim},
+                               std::pair(x_hash, std::move(values)))
+             .first;
+  }
+  return it->second.second;
+}
+//-----------------------------------------------------------------------------
 double Mesh::hmin() const { return cell_h(*this).minCoeff(); }
 //-----------------------------------------------------------------------------
 double Mesh::hmax() const { return cell_h(*this).maxCoeff(); }
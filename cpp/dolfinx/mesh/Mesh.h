@@ -9,9 +9,12 @@
 #include "Geometry.h"
 #include "Topology.h"
 #include "cell_types.h"
+#include "utils.h"
 #include <Eigen/Dense>
+#include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/UniqueIdGenerator.h>
+#include <map>
 #include <string>
 #include <utility>
 
@@ -99,6 +102,18 @@ public:
   /// @return The geometry object associated with the mesh
   const Geometry& geometry() const;
 
+  /// Get a metric for all entities (owned and ghost) of a given
+  /// dimension. The values are computed by mesh::compute_entity_metric
+  /// on first use and cached. Cached values are recomputed when the
+  /// geometry coordinates on this process have changed, which is
+  /// detected by comparing a hash of the coordinates (see
+  /// Geometry::hash).
+  /// @param[in] metric The metric
+  /// @param[in] dim The topological dimension of the entities
+  /// @return The metric for each entity. The reference is valid until
+  ///   the values are recomputed.
+  const Eigen::ArrayXd& entity_metric(EntityMetric metric, int dim) const;
+
   /// Compute minimum cell size in mesh, measured greatest distance
   /// between any two vertices of a cell.
   /// @return The minimum cell size. The size is computed using
@@ -152,6 +167,12 @@ private:
 
   // Unique identifier
   std::size_t _unique_id = common::UniqueIdGenerator::id();
+
+  // Cached entity metrics for (metric, dimension), with the hash of
+  // the geometry coordinates that they were computed for
+  mutable std::map<std::pair<EntityMetric, int>,
+                   std::pair<std::size_t, Eigen::ArrayXd>>
+      _entity_metrics;
 };
 
 /// Create a mesh
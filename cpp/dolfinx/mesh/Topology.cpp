@@ -299,6 +299,33 @@ mesh::CellType Topology::cell_type() const { return _cell_type; }
 //-----------------------------------------------------------------------------
 MPI_Comm Topology::mpi_comm() const { return _mpi_comm.comm(); }
 //-----------------------------------------------------------------------------
+void Topology::set_cell_traversal_order(
+    const std::vector<std::int32_t>& order)
+{
+  if (!order.empty())
+  {
+    const int tdim = this->dim();
+    assert(_index_map[tdim]);
+    const std::int32_t num_cells = _index_map[tdim]->size_local();
+    std::vector<bool> marker(num_cells, false);
+    if ((std::int32_t)order.size() != num_cells)
+      throw std::runtime_error("Cell order must contain all owned cells.");
+    for (std::int32_t c : order)
+    {
+      if (c < 0 or c >= num_cells or marker[c])
+        throw std::runtime_error("Cell order is not a permutation.");
+      marker[c] = true;
+    }
+  }
+
+  _cell_traversal_order = order;
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::int32_t>& Topology::cell_traversal_order() const
+{
+  return _cell_traversal_order;
+}
+//-----------------------------------------------------------------------------
 Topology
 mesh::create_topology(MPI_Comm comm,
                       const graph::AdjacencyList<std::int64_t>& cells,
@@ -159,6 +159,21 @@ public:
   /// @return The communicator on which the topology is distributed
   MPI_Comm mpi_comm() const;
 
+  /// Set the order in which owned cells are traversed in assembly. The
+  /// order is applied to the cell integration domains of forms created
+  /// after it is set (see fem::FormIntegrals). Improves memory locality
+  /// of the geometry and dof gathers, see
+  /// mesh::compute_cell_traversal_order.
+  /// @param[in] order The owned cells in traversal order (a permutation
+  ///   of 0, ..., num_owned_cells - 1). If empty, cells are traversed in
+  ///   storage order.
+  void set_cell_traversal_order(const std::vector<std::int32_t>& order);
+
+  /// Order in which owned cells are traversed in assembly
+  /// @return The owned cells in traversal order. Empty if cells are
+  ///   traversed in storage order.
+  const std::vector<std::int32_t>& cell_traversal_order() const;
+
 private:
   // MPI communicator
   dolfinx::MPI::Comm _mpi_comm;
@@ -181,6 +196,9 @@ private:
   // Cell permutation info. See the documentation for
   // get_cell_permutation_info for documentation of how this is encoded.
   Eigen::Array<std::uint32_t, Eigen::Dynamic, 1> _cell_permutations;
+
+  // Owned cells in assembly traversal order (empty for storage order)
+  std::vector<std::int32_t> _cell_traversal_order;
 };
 
 /// Create distributed topology
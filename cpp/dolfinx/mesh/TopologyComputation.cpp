@@ -9,12 +9,13 @@
 #include "cell_types.h"
 #include <Eigen/Dense>
 #include <algorithm>
-#include <boost/unordered_map.hpp>
+#include <array>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/sort.h>
 #include <dolfinx/common/utils.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <memory>
@@ -33,20 +34,41 @@ namespace
 {
 //-----------------------------------------------------------------------------
 /// Get the ownership of an entity shared over several processes
-/// @param processes Set of sharing processes
-/// @param vertices Global vertex indices of entity
+/// @param processes Sorted list of sharing processes
+/// @param vertices Sorted global vertex indices of entity
+/// @param n Number of vertices of entity
 /// @return owning process number
-int get_ownership(std::set<int>& processes, std::vector<std::int64_t>& vertices)
+int get_ownership(const std::vector<int>& processes,
+                  const std::int64_t* vertices, int n)
 {
   // Use a deterministic random number generator, seeded with global vertex
   // indices ensuring all processes get the same answer
   std::mt19937 gen;
-  std::seed_seq seq(vertices.begin(), vertices.end());
+  std::seed_seq seq(vertices, vertices + n);
   gen.seed(seq);
-  std::vector<int> p(processes.begin(), processes.end());
-  int index = gen() % p.size();
-  int owner = p[index];
-  return owner;
+  int index = gen() % processes.size();
+  return processes[index];
+}
+
+/// Compute a 64-bit hash of an entity key, i.e. of the sorted global
+/// vertex indices of an entity. Different keys can have the same hash,
+/// so keys with equal hashes must be compared.
+/// @param[in] key The key
+/// @param[in] n The number of entries in the key
+/// @return The hash
+std::uint64_t hash_key(const std::int64_t* key, int n)
+{
+  // Combine entries using the splitmix64 finaliser
+  std::uint64_t h = 0;
+  for (int i = 0; i < n; ++i)
+  {
+    std::uint64_t x = h + static_cast<std::uint64_t>(key[i])
+                      + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    h = x ^ (x >> 31);
+  }
+  return h;
 }
 
 /// Takes an array and computes the sort permutation that would reorder
@@ -76,6 +98,47 @@ sort_by_perm(const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
   std::sort(index.begin(), index.end(), cmp);
   return index;
 }
+
+/// Compute the permutation that sorts the rows of a 2D array with @p N
+/// columns in ascending (lexicographic) order, using a least
+/// significant digit radix sort. Each column is sorted in turn,
+/// starting from the last column, with a stable radix sort of the
+/// column entries. Only as many bits as are needed for the largest
+/// entry are sorted.
+/// @param[in] array The input array (row-major), with non-negative
+///   entries
+/// @param[in] num_rows The number of rows
+/// @return The permutation vector that would order the rows in
+///   ascending order
+template <int N>
+std::vector<std::int32_t> radix_sort_by_perm(const std::int32_t* array,
+                                             std::int32_t num_rows)
+{
+  std::vector<std::int32_t> perm(num_rows);
+  std::iota(perm.begin(), perm.end(), 0);
+  if (num_rows == 0)
+    return perm;
+
+  // Number of bits of the largest entry
+  const std::int32_t max_value = *std::max_element(array, array + N * num_rows);
+  assert(*std::min_element(array, array + N * num_rows) >= 0);
+  int num_bits = 0;
+  while (num_bits < 31 and (max_value >> num_bits) > 0)
+    ++num_bits;
+
+  std::vector<std::int32_t> keys(num_rows);
+  for (int col = N - 1; col >= 0; --col)
+  {
+    // Gather column entries in the current order
+#pragma omp parallel for schedule(static) if (num_rows > 100000)
+    for (std::int32_t i = 0; i < num_rows; ++i)
+      keys[i] = array[perm[i] * N + col];
+
+    common::radix_sort(keys, perm, num_bits);
+  }
+
+  return perm;
+}
 //-----------------------------------------------------------------------------
 
 /// Communicate with sharing processes to find out which entities are
@@ -169,128 +232,208 @@ get_local_indexing(
   for (int i = 0; i < neighbour_size; ++i)
     proc_to_neighbour.insert({neighbours[i], i});
 
-  std::vector<std::vector<std::int64_t>> send_entities(neighbour_size);
-  std::vector<std::vector<std::int32_t>> send_index(neighbour_size);
+  // Flatten the sharing neighbours of each vertex into an adjacency
+  // array indexed by local vertex index
+  const std::int32_t num_local_vertices
+      = vertex_indexmap->size_local() + vertex_indexmap->num_ghosts();
+  std::vector<std::int32_t> vertex_offsets(num_local_vertices + 1, 0);
+  for (auto& q : shared_vertices)
+    vertex_offsets[q.first + 1] = q.second.size();
+  std::partial_sum(vertex_offsets.begin(), vertex_offsets.end(),
+                   vertex_offsets.begin());
+  std::vector<std::int32_t> vertex_neighbours(vertex_offsets.back());
+  for (auto& q : shared_vertices)
+  {
+    std::int32_t pos = vertex_offsets[q.first];
+    for (std::int32_t p : q.second)
+      vertex_neighbours[pos++] = proc_to_neighbour[p];
+  }
 
-  // Get all "possibly shared" entities, based on vertex sharing. Send to
-  // other processes, and see if we get the same back.
+  // Get all "possibly shared" entities, based on vertex sharing. An
+  // entity may be shared with a neighbour if the neighbour shares all
+  // its vertices. Send to other processes, and see if we get the same
+  // back.
+  const int num_vertices = entity_list.cols();
 
-  // Map for entities to entity index, using global vertex indices
-  std::map<std::vector<std::int64_t>, std::int32_t>
-      global_entity_to_entity_index;
+  // Candidate shared entities (entity index) and the local vertices of
+  // each candidate (flat, fixed width)
+  std::vector<std::int32_t> candidates;
+  std::vector<std::int32_t> candidate_vertices_local;
 
-  // Set of sharing procs for each entity, counting vertex hits
-  std::unordered_map<int, int> procs;
-  const int num_vertices = entity_list.cols();
-  std::vector<std::int32_t> vlocal(num_vertices);
-  std::vector<std::int64_t> vglobal(num_vertices);
-  for (int i : unique_row)
+  // (neighbour, candidate) pairs for the candidates to send
+  std::vector<std::array<std::int32_t, 2>> send_pairs;
   {
-    procs.clear();
-    for (int j = 0; j < num_vertices; ++j)
+    std::vector<std::int32_t> entity_neighbours;
+    for (int i : unique_row)
     {
-      const int v = entity_list(i, j);
-      if (auto it = shared_vertices.find(v); it != shared_vertices.end())
+      entity_neighbours.clear();
+      for (int j = 0; j < num_vertices; ++j)
       {
-        for (std::int32_t p : it->second)
-          ++procs[p];
+        const int v = entity_list(i, j);
+        entity_neighbours.insert(entity_neighbours.end(),
+                                 vertex_neighbours.begin() + vertex_offsets[v],
+                                 vertex_neighbours.begin()
+                                     + vertex_offsets[v + 1]);
       }
-    }
+      if ((int)entity_neighbours.size() < num_vertices)
+        continue;
 
-    for (const auto& q : procs)
-    {
-      // If any process shares all vertices, then add to list
-      if (q.second == num_vertices)
+      // Count vertex hits for each neighbour
+      std::sort(entity_neighbours.begin(), entity_neighbours.end());
+      bool is_candidate = false;
+      for (auto it = entity_neighbours.begin(); it != entity_neighbours.end();)
       {
-        const int p = q.first;
-        auto it = proc_to_neighbour.find(p);
-        assert(it != proc_to_neighbour.end());
-        const int np = it->second;
-
-        vlocal.assign(entity_list.row(i).data(),
-                      entity_list.row(i).data() + num_vertices);
-        vglobal = vertex_indexmap->local_to_global(vlocal, false);
-        std::sort(vglobal.begin(), vglobal.end());
-
-        global_entity_to_entity_index.insert({vglobal, entity_index[i]});
-
-        // Do not send entities which are known to be ghosts
-        if (ghost_status[entity_index[i]] != 2)
+        const std::int32_t np = *it;
+        auto it1 = std::find_if(it, entity_neighbours.end(),
+                                [np](std::int32_t q) { return q != np; });
+        if (std::distance(it, it1) == num_vertices)
         {
-          // Entity entity_index[i] may be shared with process p
-          send_entities[np].insert(send_entities[np].end(), vglobal.begin(),
-                                   vglobal.end());
-
-          send_index[np].push_back(entity_index[i]);
+          if (!is_candidate)
+          {
+            candidates.push_back(entity_index[i]);
+            candidate_vertices_local.insert(candidate_vertices_local.end(),
+                                            entity_list.row(i).data(),
+                                            entity_list.row(i).data()
+                                                + num_vertices);
+            is_candidate = true;
+          }
+
+          // Do not send entities which are known to be ghosts
+          if (ghost_status[entity_index[i]] != 2)
+            send_pairs.push_back({np, (std::int32_t)candidates.size() - 1});
         }
+        it = it1;
       }
     }
   }
 
-  // Get shared entities of this dimension, and also match up an index
-  // for the received entities (from other processes) with the indices
-  // of the sent entities (to other processes)
-  std::unordered_map<std::int32_t, std::set<std::int32_t>> shared_entities;
-  std::unordered_map<std::int32_t, std::vector<std::int64_t>>
-      shared_entity_to_global_vertices;
-
-  // Prepare data for neighbour all to all
-  std::vector<std::int64_t> send_entities_data;
-  std::vector<int> send_offsets = {0};
-  for (std::size_t i = 0; i < send_entities.size(); ++i)
+  // Compute keys (sorted global vertex indices) for the candidates, and
+  // sort the candidates by key hash for lookup
+  const std::int32_t num_candidates = candidates.size();
+  const std::vector<std::int64_t> candidate_keys = [&]() {
+    std::vector<std::int64_t> keys
+        = vertex_indexmap->local_to_global(candidate_vertices_local, false);
+    for (std::int32_t c = 0; c < num_candidates; ++c)
+    {
+      std::sort(keys.begin() + c * num_vertices,
+                keys.begin() + (c + 1) * num_vertices);
+    }
+    return keys;
+  }();
+
+  std::vector<std::uint64_t> candidate_hash(num_candidates);
+  for (std::int32_t c = 0; c < num_candidates; ++c)
+  {
+    candidate_hash[c]
+        = hash_key(candidate_keys.data() + c * num_vertices, num_vertices);
+  }
+  std::vector<std::int32_t> hash_order(num_candidates);
+  std::iota(hash_order.begin(), hash_order.end(), 0);
+  std::sort(hash_order.begin(), hash_order.end(),
+            [&candidate_hash](std::int32_t a, std::int32_t b) {
+              return candidate_hash[a] < candidate_hash[b];
+            });
+  std::vector<std::uint64_t> sorted_hash(num_candidates);
+  for (std::int32_t c = 0; c < num_candidates; ++c)
+    sorted_hash[c] = candidate_hash[hash_order[c]];
+
+  // Pack candidate keys and entity indices to send, contiguous by
+  // neighbour
+  std::vector<int> send_offsets(neighbour_size + 1, 0);
+  for (const auto& q : send_pairs)
+    ++send_offsets[q[0] + 1];
+  std::partial_sum(send_offsets.begin(), send_offsets.end(),
+                   send_offsets.begin());
+  std::vector<std::int32_t> send_index(send_offsets.back());
+  std::vector<std::int64_t> send_entities_data(send_offsets.back()
+                                               * num_vertices);
   {
-    send_entities_data.insert(send_entities_data.end(),
-                              send_entities[i].begin(), send_entities[i].end());
-    send_offsets.push_back(send_entities_data.size());
+    std::vector<int> pos(send_offsets.begin(), send_offsets.end() - 1);
+    for (const auto& q : send_pairs)
+    {
+      const std::int32_t c = q[1];
+      const int k = pos[q[0]]++;
+      send_index[k] = candidates[c];
+      std::copy_n(candidate_keys.begin() + c * num_vertices, num_vertices,
+                  send_entities_data.begin() + k * num_vertices);
+    }
   }
+  std::vector<int> send_entities_offsets(send_offsets);
+  for (int& offset : send_entities_offsets)
+    offset *= num_vertices;
 
   const graph::AdjacencyList<std::int64_t> recv_data
-      = dolfinx::MPI::neighbor_all_to_all(neighbour_comm, send_offsets,
+      = dolfinx::MPI::neighbor_all_to_all(neighbour_comm, send_entities_offsets,
                                           send_entities_data);
   const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& recv_entities_data
       = recv_data.array();
   const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& recv_offsets
       = recv_data.offsets();
 
-  // Compare received with sent for each process
-  // Any which are not found will have -1 in recv_index
-  std::vector<std::int32_t> recv_index;
-  std::vector<std::int64_t> recv_vec(num_vertices);
+  // Compare received with sent for each process to get the shared
+  // entities of this dimension as (entity index, sharing rank) pairs,
+  // and also match up an index for the received entities (from other
+  // processes) with the indices of the sent entities (to other
+  // processes). Any which are not found will have -1 in recv_index.
+  std::vector<std::array<std::int32_t, 2>> shared_entities;
+  std::vector<std::int32_t> recv_index(recv_entities_data.rows()
+                                       / num_vertices);
   for (int np = 0; np < neighbour_size; ++np)
   {
-    const int p = neighbours[np];
-
     for (int j = recv_offsets[np]; j < recv_offsets[np + 1]; j += num_vertices)
     {
-      recv_vec.assign(recv_entities_data.data() + j,
-                      recv_entities_data.data() + j + num_vertices);
-      if (auto it = global_entity_to_entity_index.find(recv_vec);
-          it != global_entity_to_entity_index.end())
+      const std::int64_t* key = recv_entities_data.data() + j;
+      const std::uint64_t h = hash_key(key, num_vertices);
+
+      // Search candidates with the same hash, comparing keys to rule
+      // out hash collisions
+      std::int32_t idx = -1;
+      for (auto it = std::lower_bound(sorted_hash.begin(), sorted_hash.end(),
+                                      h);
+           it != sorted_hash.end() and *it == h; ++it)
       {
-        shared_entities[it->second].insert(p);
-        shared_entity_to_global_vertices.insert({it->second, recv_vec});
-        recv_index.push_back(it->second);
+        const std::int32_t c
+            = hash_order[std::distance(sorted_hash.begin(), it)];
+        if (std::equal(key, key + num_vertices,
+                       candidate_keys.begin() + c * num_vertices))
+        {
+          idx = candidates[c];
+          break;
+        }
       }
-      else
-        recv_index.push_back(-1);
+
+      recv_index[j / num_vertices] = idx;
+      if (idx != -1)
+        shared_entities.push_back({idx, neighbours[np]});
     }
   }
+  std::sort(shared_entities.begin(), shared_entities.end());
 
-  // Add this rank to the list of sharing processes
-  const int mpi_rank = dolfinx::MPI::rank(comm);
-  for (auto& q : shared_entities)
-    q.second.insert(mpi_rank);
+  // Position in candidate_keys of the key for each shared entity
+  std::vector<std::int32_t> entity_to_candidate(entity_count, -1);
+  for (std::int32_t c = 0; c < num_candidates; ++c)
+    entity_to_candidate[candidates[c]] = c;
 
   //---------
   // Determine ownership
+  const int mpi_rank = dolfinx::MPI::rank(comm);
   std::vector<std::int32_t> local_index(entity_count, -1);
   std::int32_t num_local;
   {
     std::int32_t c = 0;
+    auto shared_it = shared_entities.begin();
+    std::vector<int> processes;
     // Index non-ghost entities
     for (int i = 0; i < entity_count; ++i)
     {
-      auto it = shared_entities.find(i);
+      // Sharing processes, including this rank
+      processes.clear();
+      for (; shared_it != shared_entities.end() and (*shared_it)[0] == i;
+           ++shared_it)
+      {
+        processes.push_back((*shared_it)[1]);
+      }
+
       std::int8_t gs = ghost_status[i];
       assert(gs > 0);
       // Definitely ghost
@@ -298,17 +441,21 @@ get_local_indexing(
         continue;
 
       // Definitely local
-      if (gs == 1 or it == shared_entities.end())
+      if (gs == 1 or processes.empty())
       {
         local_index[i] = c;
         ++c;
       }
       else
       {
-        const auto global_vertices_it
-            = shared_entity_to_global_vertices.find(i);
-        assert(global_vertices_it != shared_entity_to_global_vertices.end());
-        int owner_rank = get_ownership(it->second, global_vertices_it->second);
+        processes.push_back(mpi_rank);
+        std::sort(processes.begin(), processes.end());
+        processes.erase(std::unique(processes.begin(), processes.end()),
+                        processes.end());
+        assert(entity_to_candidate[i] != -1);
+        const std::int64_t* key
+            = &candidate_keys[entity_to_candidate[i] * num_vertices];
+        int owner_rank = get_ownership(processes, key, num_vertices);
         if (owner_rank == mpi_rank)
         {
           // Take ownership
@@ -339,29 +486,22 @@ get_local_indexing(
     const std::int64_t local_offset
         = dolfinx::MPI::global_offset(comm, num_local, true);
 
-    std::vector<std::int64_t> send_global_index_data;
-    std::vector<int> send_global_index_offsets = {0};
-
     // Send global indices for same entities that we sent before. This
     // uses the same pattern as before, so we can match up the received
     // data to the indices in recv_index
-    for (int np = 0; np < neighbour_size; ++np)
+    std::vector<std::int64_t> send_global_index_data(send_index.size());
+    for (std::size_t j = 0; j < send_index.size(); ++j)
     {
-      for (std::int32_t index : send_index[np])
-      {
-        // If not in our local range, send -1.
-        const std::int64_t gi = (local_index[index] < num_local)
-                                    ? (local_offset + local_index[index])
-                                    : -1;
-
-        send_global_index_data.push_back(gi);
-      }
-
-      send_global_index_offsets.push_back(send_global_index_data.size());
+      // If not in our local range, send -1.
+      const std::int32_t index = send_index[j];
+      send_global_index_data[j] = (local_index[index] < num_local)
+                                      ? (local_offset + local_index[index])
+                                      : -1;
     }
+
     const graph::AdjacencyList<std::int64_t> recv_data
-        = dolfinx::MPI::neighbor_all_to_all(
-            neighbour_comm, send_global_index_offsets, send_global_index_data);
+        = dolfinx::MPI::neighbor_all_to_all(neighbour_comm, send_offsets,
+                                            send_global_index_data);
 
     const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>& recv_global_index_data
         = recv_data.array();
@@ -371,18 +511,18 @@ get_local_indexing(
     assert(recv_global_index_data.size() == (int)recv_index.size());
 
     // Map back received indices
-    for (int j = 0; j < recv_global_index_data.size(); ++j)
+    for (int np = 0; np < neighbour_size; ++np)
     {
-      const std::int64_t gi = recv_global_index_data[j];
-      const std::int32_t idx = recv_index[j];
-      if (gi != -1 and idx != -1)
+      for (int j = recv_offsets[np]; j < recv_offsets[np + 1]; ++j)
       {
-        assert(local_index[idx] >= num_local);
-        ghost_indices[local_index[idx] - num_local] = gi;
-        const auto pos = std::upper_bound(
-            recv_offsets.data(), recv_offsets.data() + recv_offsets.rows(), j);
-        const int owner = std::distance(recv_offsets.data(), pos) - 1;
-        ghost_owners[local_index[idx] - num_local] = neighbours[owner];
+        const std::int64_t gi = recv_global_index_data[j];
+        const std::int32_t idx = recv_index[j];
+        if (gi != -1 and idx != -1)
+        {
+          assert(local_index[idx] >= num_local);
+          ghost_indices[local_index[idx] - num_local] = gi;
+          ghost_owners[local_index[idx] - num_local] = neighbours[np];
+        }
       }
     }
     for (std::int64_t idx : ghost_indices)
@@ -472,14 +612,34 @@ compute_entities_by_key_matching(
   // Copy list and sort vertices of each entity into order
   Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       entity_list_sorted = entity_list;
-  for (int i = 0; i < entity_list_sorted.rows(); ++i)
+  const int num_entities = entity_list_sorted.rows();
+#pragma omp parallel for schedule(static) if (num_entities > 100000)
+  for (int i = 0; i < num_entities; ++i)
   {
     std::sort(entity_list_sorted.row(i).data(),
               entity_list_sorted.row(i).data() + num_vertices_per_entity);
   }
 
-  // Sort the list and label uniquely
-  const std::vector sort_order = sort_by_perm<std::int32_t>(entity_list_sorted);
+  // Sort the list and label uniquely. Use a radix sort for the common
+  // entity sizes.
+  std::vector<std::int32_t> sort_order;
+  switch (num_vertices_per_entity)
+  {
+  case 2:
+    sort_order = radix_sort_by_perm<2>(entity_list_sorted.data(),
+                                       entity_list_sorted.rows());
+    break;
+  case 3:
+    sort_order = radix_sort_by_perm<3>(entity_list_sorted.data(),
+                                       entity_list_sorted.rows());
+    break;
+  case 4:
+    sort_order = radix_sort_by_perm<4>(entity_list_sorted.data(),
+                                       entity_list_sorted.rows());
+    break;
+  default:
+    sort_order = sort_by_perm<std::int32_t>(entity_list_sorted);
+  }
   std::int32_t last = sort_order[0];
   entity_index[last] = 0;
   for (std::size_t i = 1; i < sort_order.size(); ++i)
@@ -579,50 +739,78 @@ compute_from_map(const graph::AdjacencyList<std::int32_t>& c_d0_0,
   assert(d1 > 0);
   assert(d0 > d1);
 
-  // Make a map from the sorted d1 entity vertices to the d1 entity
-  // index
-  boost::unordered_map<std::vector<std::int32_t>, std::int32_t> entity_to_index;
-  entity_to_index.reserve(c_d1_0.num_nodes());
-
-  const std::size_t num_verts_d1
+  // Maximum number of vertices of a d1 entity (quadrilateral)
+  constexpr int max_verts_d1 = 4;
+  const int num_verts_d1
       = mesh::num_cell_vertices(mesh::cell_entity_type(cell_type_d0, d1));
+  assert(num_verts_d1 <= max_verts_d1);
 
-  std::vector<std::int32_t> key(num_verts_d1);
-  for (int e = 0; e < c_d1_0.num_nodes(); ++e)
+  // Sorted vertices of each d1 entity, with fixed width
+  const std::int32_t num_entities_d1 = c_d1_0.num_nodes();
+  std::vector<std::int32_t> sorted_d1(num_entities_d1 * num_verts_d1);
+#pragma omp parallel for schedule(static) if (num_entities_d1 > 100000)
+  for (std::int32_t e = 0; e < num_entities_d1; ++e)
   {
     const std::int32_t* v = c_d1_0.links_ptr(e);
-    std::partial_sort_copy(v, v + num_verts_d1, key.begin(), key.end());
-    entity_to_index.insert({key, e});
+    std::int32_t* key = sorted_d1.data() + e * num_verts_d1;
+    std::copy(v, v + num_verts_d1, key);
+    std::sort(key, key + num_verts_d1);
+  }
+
+  // Make an adjacency array from each vertex to the d1 entities for
+  // which it is the lowest vertex
+  std::int32_t num_vertices = 0;
+  for (std::int32_t e = 0; e < num_entities_d1; ++e)
+    num_vertices = std::max(num_vertices, sorted_d1[e * num_verts_d1] + 1);
+  std::vector<std::int32_t> vertex_offsets(num_vertices + 1, 0);
+  for (std::int32_t e = 0; e < num_entities_d1; ++e)
+    ++vertex_offsets[sorted_d1[e * num_verts_d1] + 1];
+  std::partial_sum(vertex_offsets.begin(), vertex_offsets.end(),
+                   vertex_offsets.begin());
+  std::vector<std::int32_t> vertex_entities(num_entities_d1);
+  {
+    std::vector<std::int32_t> pos(vertex_offsets.begin(),
+                                  vertex_offsets.end() - 1);
+    for (std::int32_t e = 0; e < num_entities_d1; ++e)
+      vertex_entities[pos[sorted_d1[e * num_verts_d1]]++] = e;
   }
 
   Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       connections(c_d0_0.num_nodes(),
                   mesh::cell_num_entities(cell_type_d0, d1));
 
-  // Search for d1 entities of d0 in map, and recover index
-  std::vector<std::int32_t> entities;
+  // Search for the d1 entities of each d0 entity among the d1 entities
+  // of its lowest vertex, and recover index
   const Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       e_vertices_ref = mesh::get_entity_vertices(cell_type_d0, d1);
-  Eigen::Array<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> keys
-      = e_vertices_ref;
-  for (int e = 0; e < c_d0_0.num_nodes(); ++e)
+  const std::int32_t num_entities_d0 = c_d0_0.num_nodes();
+#pragma omp parallel for schedule(static) if (num_entities_d0 > 100000)
+  for (std::int32_t e = 0; e < num_entities_d0; ++e)
   {
-    entities.clear();
-    auto e0 = c_d0_0.links(e);
+    const std::int32_t* e0 = c_d0_0.links_ptr(e);
     for (Eigen::Index i = 0; i < e_vertices_ref.rows(); ++i)
-      for (Eigen::Index j = 0; j < e_vertices_ref.cols(); ++j)
-        keys(i, j) = e0[e_vertices_ref(i, j)];
-    for (Eigen::Index i = 0; i < keys.rows(); ++i)
     {
-      std::partial_sort_copy(keys.row(i).data(),
-                             keys.row(i).data() + keys.row(i).cols(),
-                             key.begin(), key.end());
-      const auto it = entity_to_index.find(key);
-      assert(it != entity_to_index.end());
-      entities.push_back(it->second);
+      std::array<std::int32_t, max_verts_d1> key;
+      for (int j = 0; j < num_verts_d1; ++j)
+        key[j] = e0[e_vertices_ref(i, j)];
+      std::sort(key.begin(), key.begin() + num_verts_d1);
+
+      const std::int32_t v = key[0];
+      assert(v < num_vertices);
+      std::int32_t entity = -1;
+      for (std::int32_t k = vertex_offsets[v]; k < vertex_offsets[v + 1]; ++k)
+      {
+        const std::int32_t e1 = vertex_entities[k];
+        if (std::equal(key.begin(), key.begin() + num_verts_d1,
+                       sorted_d1.begin() + e1 * num_verts_d1))
+        {
+          entity = e1;
+          break;
+        }
+      }
+      assert(entity != -1);
+      connections(e, i) = entity;
     }
-    for (std::size_t k = 0; k < entities.size(); ++k)
-      connections(e, k) = entities[k];
   }
 
   return graph::AdjacencyList<std::int32_t>(connections);
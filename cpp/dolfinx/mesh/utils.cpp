@@ -6,14 +6,20 @@
 
 #include "utils.h"
 #include "Geometry.h"
+#include "GraphBuilder.h"
 #include "MeshTags.h"
 #include "cell_types.h"
 #include <Eigen/Dense>
 #include <algorithm>
+#include <array>
 #include <cfloat>
 #include <cstdlib>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/sort.h>
 #include <dolfinx/fem/ElementDofLayout.h>
+#include <dolfinx/graph/BoostGraphOrdering.h>
+#include <numeric>
 #include <stdexcept>
 #include <unordered_set>
 
@@ -314,6 +320,183 @@ T circumradius_tmpl(const mesh::Mesh& mesh,
 }
 //-----------------------------------------------------------------------------
 
+// Number of entities processed together by the entity metric kernels
+constexpr int batch_size = 32;
+
+// Metric values for a batch of entities
+using Batch = Eigen::Array<double, batch_size, 1>;
+
+// Vertex coordinates for a batch of entities. X[3 * v + k] holds
+// coordinate k of vertex v for all entities in the batch. Entities have
+// at most 8 vertices.
+using BatchCoordinates = std::array<Batch, 24>;
+
+/// Distance between two vertices for a batch of entities
+Batch distance(const BatchCoordinates& X, int v0, int v1)
+{
+  return ((X[3 * v1] - X[3 * v0]).square()
+          + (X[3 * v1 + 1] - X[3 * v0 + 1]).square()
+          + (X[3 * v1 + 2] - X[3 * v0 + 2]).square())
+      .sqrt();
+}
+
+/// Area of the triangle spanned by three vertices for a batch of
+/// entities
+Batch triangle_area(const BatchCoordinates& X, int v0, int v1, int v2)
+{
+  const Batch ax = X[3 * v1] - X[3 * v0];
+  const Batch ay = X[3 * v1 + 1] - X[3 * v0 + 1];
+  const Batch az = X[3 * v1 + 2] - X[3 * v0 + 2];
+  const Batch bx = X[3 * v2] - X[3 * v0];
+  const Batch by = X[3 * v2 + 1] - X[3 * v0 + 1];
+  const Batch bz = X[3 * v2 + 2] - X[3 * v0 + 2];
+  return 0.5
+         * ((ay * bz - az * by).square() + (az * bx - ax * bz).square()
+            + (ax * by - ay * bx).square())
+               .sqrt();
+}
+
+/// Volume of a batch of tetrahedra
+Batch tetrahedron_volume(const BatchCoordinates& X)
+{
+  const Batch ax = X[3] - X[0], ay = X[4] - X[1], az = X[5] - X[2];
+  const Batch bx = X[6] - X[0], by = X[7] - X[1], bz = X[8] - X[2];
+  const Batch cx = X[9] - X[0], cy = X[10] - X[1], cz = X[11] - X[2];
+  return (ax * (by * cz - bz * cy) - ay * (bx * cz - bz * cx)
+          + az * (bx * cy - by * cx))
+             .abs()
+         / 6.0;
+}
+
+/// (Generalized) volume of a batch of simplices with n vertices
+Batch simplex_volume(const BatchCoordinates& X, int n)
+{
+  switch (n)
+  {
+  case 1:
+    return Batch::Ones();
+  case 2:
+    return distance(X, 0, 1);
+  case 3:
+    return triangle_area(X, 0, 1, 2);
+  case 4:
+    return tetrahedron_volume(X);
+  default:
+    throw std::runtime_error("Unknown simplex.");
+  }
+}
+
+/// Circumradius of a batch of simplices with n vertices
+Batch simplex_circumradius(const BatchCoordinates& X, int n)
+{
+  switch (n)
+  {
+  case 1:
+    return Batch::Zero();
+  case 2:
+    return 0.5 * distance(X, 0, 1);
+  case 3:
+  {
+    // Formula for circumradius from
+    // http://mathworld.wolfram.com/Triangle.html
+    return distance(X, 1, 2) * distance(X, 0, 2) * distance(X, 0, 1)
+           / (4.0 * triangle_area(X, 0, 1, 2));
+  }
+  case 4:
+  {
+    // Compute "area" of triangle with strange side lengths. Formula
+    // for circumradius from http://mathworld.wolfram.com/Tetrahedron.html
+    const Batch la = distance(X, 1, 2) * distance(X, 0, 3);
+    const Batch lb = distance(X, 0, 2) * distance(X, 1, 3);
+    const Batch lc = distance(X, 0, 1) * distance(X, 2, 3);
+    const Batch s = 0.5 * (la + lb + lc);
+    const Batch area = (s * (s - la) * (s - lb) * (s - lc)).sqrt();
+    return area / (6.0 * tetrahedron_volume(X));
+  }
+  default:
+    throw std::runtime_error(
+        "Unsupported cell type for circumradius computation.");
+  }
+}
+
+/// Inradius of a batch of simplex cells with n vertices, computed from
+/// the volume and the facet volumes of the cells
+Batch simplex_inradius(const BatchCoordinates& X, int n)
+{
+  // Sum of facet volumes
+  Batch A;
+  switch (n)
+  {
+  case 2:
+    A = Batch::Constant(2.0);
+    break;
+  case 3:
+    A = distance(X, 1, 2) + distance(X, 0, 2) + distance(X, 0, 1);
+    break;
+  case 4:
+    A = triangle_area(X, 1, 2, 3) + triangle_area(X, 0, 2, 3)
+        + triangle_area(X, 0, 1, 3) + triangle_area(X, 0, 1, 2);
+    break;
+  default:
+    throw std::runtime_error("Unsupported cell type for inradius.");
+  }
+
+  // See Jonathan Richard Shewchuk: What Is a Good Linear Finite
+  // Element?, online: http://www.cs.berkeley.edu/~jrs/papers/elemj.pdf
+  const int d = n - 1;
+  const Batch volume = simplex_volume(X, n);
+  return (volume == 0.0).select(Batch::Zero(), d * volume / A);
+}
+
+/// Greatest distance between any two of the n vertices for a batch of
+/// entities
+Batch max_distance(const BatchCoordinates& X, int n)
+{
+  Batch h = Batch::Zero();
+  for (int i = 0; i < n; ++i)
+    for (int j = i + 1; j < n; ++j)
+      h = h.max(distance(X, i, j));
+  return h;
+}
+//-----------------------------------------------------------------------------
+
+/// Compute the geometry node of each mesh vertex
+/// @param[in] mesh The mesh
+/// @return The geometry node (row in Geometry::x) for each vertex
+std::vector<std::int32_t> compute_vertex_to_x(const mesh::Mesh& mesh)
+{
+  const mesh::Topology& topology = mesh.topology();
+  const int tdim = topology.dim();
+
+  // Get geometry dofmap
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+
+  // Build map from vertex -> geometry dof
+  auto c_to_v = topology.connectivity(tdim, 0);
+  assert(c_to_v);
+  auto map_v = topology.index_map(0);
+  assert(map_v);
+  const std::int32_t num_vertices = map_v->size_local() + map_v->num_ghosts();
+  std::vector<std::int32_t> vertex_to_x(num_vertices);
+  auto map_c = topology.index_map(tdim);
+  assert(map_c);
+  for (int c = 0; c < map_c->size_local() + map_c->num_ghosts(); ++c)
+  {
+    auto vertices = c_to_v->links(c);
+    auto dofs = x_dofmap.links(c);
+    for (int i = 0; i < vertices.rows(); ++i)
+    {
+      // FIXME: We are making an assumption here on the
+      // ElementDofLayout. We should use an ElementDofLayout to map
+      // between local vertex index an x dof index.
+      vertex_to_x[vertices[i]] = dofs(i);
+    }
+  }
+
+  return vertex_to_x;
+}
+//-----------------------------------------------------------------------------
+
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -458,6 +641,146 @@ mesh::radius_ratio(const mesh::Mesh& mesh,
   return mesh::cell_dim(mesh.topology().cell_type()) * r / cr;
 }
 //-----------------------------------------------------------------------------
+Eigen::ArrayXd mesh::compute_entity_metric(const mesh::Mesh& mesh,
+                                           EntityMetric metric, int dim)
+{
+  const mesh::Topology& topology = mesh.topology();
+  const int tdim = topology.dim();
+  const mesh::CellType type = cell_entity_type(topology.cell_type(), dim);
+  const bool simplex = mesh::is_simplex(type);
+
+  // Check that the metric is supported for the entity type
+  switch (metric)
+  {
+  case EntityMetric::volume:
+    if (type == mesh::CellType::hexahedron)
+    {
+      throw std::runtime_error(
+          "Volume computation for hexahedral cell not supported.");
+    }
+    else if (type == mesh::CellType::quadrilateral and dim != tdim)
+    {
+      throw std::runtime_error(
+          "Volume computation for quadrilateral facets not supported.");
+    }
+    break;
+  case EntityMetric::h:
+    break;
+  case EntityMetric::circumradius:
+    if (!simplex)
+    {
+      throw std::runtime_error(
+          "Unsupported cell type for circumradius computation.");
+    }
+    break;
+  case EntityMetric::inradius:
+  case EntityMetric::radius_ratio:
+    if (!simplex or dim != tdim)
+    {
+      throw std::runtime_error(
+          "inradius function not implemented for non-simplicial cells");
+    }
+    break;
+  default:
+    throw std::runtime_error("Unknown entity metric.");
+  }
+
+  // FIXME: cleanup these calls as part of topology storage management rework.
+  mesh.topology_mutable().create_entities(dim);
+  auto map = topology.index_map(dim);
+  assert(map);
+  const std::int32_t num_entities = map->size_local() + map->num_ghosts();
+
+  // Quadrilateral cell volumes are not computed in batches
+  if (metric == EntityMetric::volume and !simplex)
+  {
+    Eigen::ArrayXi entities(num_entities);
+    std::iota(entities.data(), entities.data() + entities.size(), 0);
+    return mesh::volume_entities(mesh, entities, dim);
+  }
+
+  // Get the geometry node of each vertex of each entity
+  const int num_vertices = mesh::num_cell_vertices(type);
+  assert(num_vertices <= 8);
+  std::vector<std::int32_t> entity_x(num_entities * num_vertices);
+  if (dim == tdim)
+  {
+    const graph::AdjacencyList<std::int32_t>& x_dofmap
+        = mesh.geometry().dofmap();
+    for (std::int32_t e = 0; e < num_entities; ++e)
+    {
+      auto dofs = x_dofmap.links(e);
+      for (int i = 0; i < num_vertices; ++i)
+        entity_x[e * num_vertices + i] = dofs[i];
+    }
+  }
+  else
+  {
+    const std::vector<std::int32_t> vertex_to_x = compute_vertex_to_x(mesh);
+    if (dim == 0)
+      entity_x = vertex_to_x;
+    else
+    {
+      auto e_to_v = topology.connectivity(dim, 0);
+      assert(e_to_v);
+      for (std::int32_t e = 0; e < num_entities; ++e)
+      {
+        auto vertices = e_to_v->links(e);
+        for (int i = 0; i < num_vertices; ++i)
+          entity_x[e * num_vertices + i] = vertex_to_x[vertices[i]];
+      }
+    }
+  }
+
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = mesh.geometry().x();
+  Eigen::ArrayXd values(num_entities);
+  const std::int32_t num_batches = (num_entities + batch_size - 1) / batch_size;
+#pragma omp parallel for schedule(static) if (num_batches > 64)
+  for (std::int32_t b = 0; b < num_batches; ++b)
+  {
+    // Gather vertex coordinates. The last batch is padded with the
+    // first entity of the batch.
+    const std::int32_t e0 = b * batch_size;
+    const int n = std::min(batch_size, num_entities - e0);
+    BatchCoordinates X;
+    for (int v = 0; v < num_vertices; ++v)
+    {
+      for (int i = 0; i < batch_size; ++i)
+      {
+        const std::int32_t e = e0 + (i < n ? i : 0);
+        const std::int32_t node = entity_x[e * num_vertices + v];
+        for (int k = 0; k < 3; ++k)
+          X[3 * v + k][i] = x(node, k);
+      }
+    }
+
+    Batch result;
+    switch (metric)
+    {
+    case EntityMetric::volume:
+      result = simplex_volume(X, num_vertices);
+      break;
+    case EntityMetric::h:
+      result = max_distance(X, num_vertices);
+      break;
+    case EntityMetric::circumradius:
+      result = simplex_circumradius(X, num_vertices);
+      break;
+    case EntityMetric::inradius:
+      result = simplex_inradius(X, num_vertices);
+      break;
+    case EntityMetric::radius_ratio:
+      result = tdim * simplex_inradius(X, num_vertices)
+               / simplex_circumradius(X, num_vertices);
+      break;
+    }
+    values.segment(e0, n) = result.head(n);
+  }
+
+  return values;
+}
+//-----------------------------------------------------------------------------
 Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>
 mesh::cell_normals(const mesh::Mesh& mesh, int dim)
 {
@@ -544,32 +867,8 @@ Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> mesh::midpoints(
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
       = geometry.x();
 
-  const int tdim = topology.dim();
-
-  // Get geometry dofmap
-  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
-
   // Build map from vertex -> geometry dof
-  auto c_to_v = topology.connectivity(tdim, 0);
-  assert(c_to_v);
-  auto map_v = topology.index_map(0);
-  assert(map_v);
-  const std::int32_t num_vertices = map_v->size_local() + map_v->num_ghosts();
-  std::vector<std::int32_t> vertex_to_x(num_vertices);
-  auto map_c = topology.index_map(tdim);
-  assert(map_c);
-  for (int c = 0; c < map_c->size_local() + map_c->num_ghosts(); ++c)
-  {
-    auto vertices = c_to_v->links(c);
-    auto dofs = x_dofmap.links(c);
-    for (int i = 0; i < vertices.rows(); ++i)
-    {
-      // FIXME: We are making an assumption here on the
-      // ElementDofLayout. We should use an ElementDofLayout to map
-      // between local vertex index an x dof index.
-      vertex_to_x[vertices[i]] = dofs(i);
-    }
-  }
+  const std::vector<std::int32_t> vertex_to_x = compute_vertex_to_x(mesh);
 
   Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> x_mid(
       entities.rows(), 3);
@@ -785,3 +1084,69 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 1> mesh::locate_entities_boundary(
       entities.data(), entities.size());
 }
 //-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+mesh::compute_cell_traversal_order(const mesh::Mesh& mesh,
+                                   mesh::CellOrdering ordering)
+{
+  common::Timer timer("Compute cell traversal order");
+
+  const mesh::Topology& topology = mesh.topology();
+  const int tdim = topology.dim();
+  assert(topology.index_map(tdim));
+  const std::int32_t num_cells = topology.index_map(tdim)->size_local();
+  std::vector<std::int32_t> order(num_cells);
+
+  switch (ordering)
+  {
+  case mesh::CellOrdering::morton:
+  {
+    if (num_cells == 0)
+      return order;
+
+    // Scale cell midpoints to the unit cube
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> x
+        = mesh::midpoints(mesh, tdim,
+                          Eigen::ArrayXi::LinSpaced(num_cells, 0,
+                                                    num_cells - 1));
+    const Eigen::Array3d x0 = x.colwise().minCoeff();
+    const Eigen::Array3d h
+        = (x.colwise().maxCoeff().transpose() - x0).max(DBL_EPSILON);
+
+    // Sort cells by the Morton code of the midpoints
+    std::vector<std::uint64_t> keys(num_cells);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+      keys[c] = common::morton_code((x.row(c).transpose() - x0) / h);
+
+    std::iota(order.begin(), order.end(), 0);
+    common::radix_sort(keys, order, 63);
+    break;
+  }
+  case mesh::CellOrdering::reverse_cuthill_mckee:
+  {
+    // Build local dual graph of owned cells
+    auto c_to_v = topology.connectivity(tdim, 0);
+    assert(c_to_v);
+    const int num_vertices = mesh::num_cell_vertices(topology.cell_type());
+    Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        cell_vertices(num_cells, num_vertices);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+      cell_vertices.row(c) = c_to_v->links(c).cast<std::int64_t>().transpose();
+    const auto [dual_graph, facet_cell_map, num_edges]
+        = mesh::GraphBuilder::compute_local_dual_graph(cell_vertices,
+                                                       topology.cell_type());
+
+    // Compute reverse Cuthill-McKee ordering (map[old] -> new)
+    const std::vector<int> map
+        = graph::BoostGraphOrdering::compute_cuthill_mckee(
+            graph::AdjacencyList<std::int32_t>(dual_graph), true);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+      order[map[c]] = c;
+    break;
+  }
+  default:
+    throw std::runtime_error("Unknown cell ordering.");
+  }
+
+  return order;
+}
+//-----------------------------------------------------------------------------
@@ -21,6 +21,23 @@ namespace mesh
 enum class CellType;
 class Mesh;
 
+/// Orderings of cells for traversal in assembly
+enum class CellOrdering
+{
+  morton,
+  reverse_cuthill_mckee
+};
+
+/// Metrics of mesh entities
+enum class EntityMetric
+{
+  volume,
+  h,
+  circumradius,
+  inradius,
+  radius_ratio
+};
+
 /// Extract topology from cell data, i.e. extract cell vertices
 /// @param[in] cell_type The cell shape
 /// @param[in] layout The layout of geometry 'degrees-of-freedom' on the
@@ -56,6 +73,23 @@ Eigen::ArrayXd inradius(const Mesh& mesh,
 Eigen::ArrayXd radius_ratio(const Mesh& mesh,
                             const Eigen::Ref<const Eigen::ArrayXi>& entities);
 
+/// Compute a metric for all entities (owned and ghost) of a given
+/// dimension. The entities are processed in fixed-size batches, with the
+/// vertex coordinates gathered into contiguous arrays such that the
+/// metric computations are vectorised. Batches are distributed over
+/// threads when OpenMP is enabled. The values are the same as computed
+/// by the corresponding function for a list of entities, e.g. mesh::h.
+/// The inradius and radius ratio are computed for simplex cells only,
+/// and use the facets of the cells without creating facet entities.
+/// Entities of dimension @p dim are created if they do not exist.
+///
+/// @param[in] mesh The mesh
+/// @param[in] metric The metric
+/// @param[in] dim The topological dimension of the entities
+/// @return The metric for each entity
+Eigen::ArrayXd compute_entity_metric(const Mesh& mesh, EntityMetric metric,
+                                     int dim);
+
 /// Compute normal to given cell (viewed as embedded in 3D)
 Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>
 cell_normals(const Mesh& mesh, int dim);
@@ -108,5 +142,20 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 1> locate_entities_boundary(
         const Eigen::Ref<const Eigen::Array<double, 3, Eigen::Dynamic,
                                             Eigen::RowMajor>>&)>& marker);
 
+/// Compute an order for the traversal of owned cells in assembly that
+/// improves memory locality, i.e. such that cells visited after each
+/// other share geometry nodes and dofs. With CellOrdering::morton cells
+/// are sorted along a Morton (Z-order) space-filling curve through the
+/// cell midpoints. With CellOrdering::reverse_cuthill_mckee the
+/// reverse Cuthill-McKee ordering of the local dual graph (cells
+/// connected by facets) is used. The order can be set with
+/// Topology::set_cell_traversal_order.
+///
+/// @param[in] mesh The mesh
+/// @param[in] ordering The ordering method
+/// @return The owned cells in traversal order
+std::vector<std::int32_t> compute_cell_traversal_order(const Mesh& mesh,
+                                                       CellOrdering ordering);
+
 } // namespace mesh
 } // namespace dolfinx
@@ -5,8 +5,10 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include <catch.hpp>
+#include <complex>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ScatterPlan.h>
 #include <numeric>
 #include <set>
 #include <vector>
@@ -98,6 +100,103 @@ void test_scatter_rev()
   sum = std::accumulate(data_local.begin(), data_local.end(), 0);
   CHECK(sum == 2 * n * value * num_ghosts);
 }
+
+void test_scatter_plan()
+{
+  // Block size
+  auto n = GENERATE(1, 5);
+
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 100;
+
+  // Create some ghost entries on next process
+  const int num_ghosts = (mpi_size - 1) * 3;
+  Eigen::Array<std::int64_t, Eigen::Dynamic, 1> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = (mpi_rank + 1) % mpi_size * size_local + i;
+
+  std::vector<int> global_ghost_owner(ghosts.size(), (mpi_rank + 1) % mpi_size);
+
+  // Create an IndexMap
+  common::IndexMap idx_map(
+      MPI_COMM_WORLD, size_local,
+      dolfinx::MPI::compute_graph_edges(
+          MPI_COMM_WORLD,
+          std::set<int>(global_ghost_owner.begin(), global_ghost_owner.end())),
+      ghosts, global_ghost_owner, 1);
+
+  common::ScatterPlan<double> plan(idx_map, n);
+  Eigen::VectorXd data_local(n * size_local);
+  Eigen::VectorXd data_ghost(n * num_ghosts);
+
+  // Scatter forward twice with the same plan and check values received
+  const int owner = (mpi_rank + 1) % mpi_size;
+  for (double val : {11.0, 3.0})
+  {
+    data_local.setConstant(val * mpi_rank);
+    data_ghost.setConstant(-1.0);
+    plan.scatter_fwd_begin(data_local);
+    CHECK_THROWS(plan.scatter_rev_begin(data_ghost));
+    plan.scatter_fwd_end(data_ghost);
+    CHECK((data_ghost.array() == val * owner).all());
+  }
+
+  // Accumulate ghost values on owner
+  const double value = 15.0;
+  data_local.setZero();
+  data_ghost.setConstant(value);
+  plan.scatter_rev_begin(data_ghost);
+  plan.scatter_rev_end(data_local, common::IndexMap::Mode::add);
+  CHECK(data_local.sum() == n * value * num_ghosts);
+
+  plan.scatter_rev_begin(data_ghost);
+  plan.scatter_rev_end(data_local, common::IndexMap::Mode::insert);
+  CHECK(data_local.sum() == n * value * num_ghosts);
+}
+
+template <typename T>
+void test_scatter_inplace()
+{
+  // Block size
+  auto n = GENERATE(1, 3);
+
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 100;
+
+  // Create some ghost entries on next process
+  const int num_ghosts = (mpi_size - 1) * 3;
+  Eigen::Array<std::int64_t, Eigen::Dynamic, 1> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = (mpi_rank + 1) % mpi_size * size_local + i;
+
+  std::vector<int> global_ghost_owner(ghosts.size(), (mpi_rank + 1) % mpi_size);
+
+  // Create an IndexMap
+  common::IndexMap idx_map(
+      MPI_COMM_WORLD, size_local,
+      dolfinx::MPI::compute_graph_edges(
+          MPI_COMM_WORLD,
+          std::set<int>(global_ghost_owner.begin(), global_ghost_owner.end())),
+      ghosts, global_ghost_owner, 1);
+
+  // Owned and ghost values in one array
+  Eigen::Matrix<T, Eigen::Dynamic, 1> data(n * (size_local + num_ghosts));
+  data.head(n * size_local).setConstant(T(2 * mpi_rank));
+  data.tail(n * num_ghosts).setConstant(T(-1));
+  idx_map.scatter_fwd(data, n);
+  CHECK((data.head(n * size_local).array() == T(2 * mpi_rank)).all());
+  CHECK((data.tail(n * num_ghosts).array()
+         == T(2 * ((mpi_rank + 1) % mpi_size)))
+            .all());
+
+  // Accumulate ghost values on owner
+  data.head(n * size_local).setZero();
+  data.tail(n * num_ghosts).setConstant(T(3));
+  idx_map.scatter_rev(data, n, common::IndexMap::Mode::add);
+  CHECK(data.head(n * size_local).sum() == T(3 * n * num_ghosts));
+}
 } // namespace
 
 TEST_CASE("Scatter forward using IndexMap", "[index_map_scatter_fwd]")
@@ -109,3 +208,15 @@ TEST_CASE("Scatter reverse using IndexMap", "[index_map_scatter_rev]")
 {
   CHECK_NOTHROW(test_scatter_rev());
 }
+
+TEST_CASE("Scatter using ScatterPlan", "[index_map_scatter_plan]")
+{
+  CHECK_NOTHROW(test_scatter_plan());
+}
+
+TEST_CASE("Scatter in place using IndexMap", "[index_map_scatter_inplace]")
+{
+  CHECK_NOTHROW(test_scatter_inplace<double>());
+  CHECK_NOTHROW(test_scatter_inplace<float>());
+  CHECK_NOTHROW(test_scatter_inplace<std::complex<double>>());
+}
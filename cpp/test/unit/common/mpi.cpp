@@ -0,0 +1,86 @@
+// Copyright (C) 2026 The DOLFINX authors
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch.hpp>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <set>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+void test_sparse_all_to_all()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Send (rank, i) to rank + i for i = 1, 2 (non-symmetric pattern)
+  std::set<int> dest_set;
+  for (int i = 1; i <= 2 and i < mpi_size; ++i)
+    dest_set.insert((mpi_rank + i) % mpi_size);
+  const std::vector<int> dest(dest_set.begin(), dest_set.end());
+  std::vector<std::int64_t> data;
+  std::vector<std::int32_t> offsets(1, 0);
+  for (int d : dest)
+  {
+    const int i = (d - mpi_rank + mpi_size) % mpi_size;
+    data.insert(data.end(), i, mpi_rank);
+    offsets.push_back(data.size());
+  }
+
+  const auto [src, recv] = dolfinx::MPI::sparse_all_to_all(
+      MPI_COMM_WORLD, dest, graph::AdjacencyList<std::int64_t>(data, offsets));
+
+  std::set<int> src_ref;
+  for (int i = 1; i <= 2 and i < mpi_size; ++i)
+    src_ref.insert((mpi_rank - i + mpi_size) % mpi_size);
+  CHECK(src == std::vector<int>(src_ref.begin(), src_ref.end()));
+  for (std::size_t k = 0; k < src.size(); ++k)
+  {
+    auto links = recv.links(k);
+    const int i = (mpi_rank - src[k] + mpi_size) % mpi_size;
+    CHECK(links.rows() == i);
+    CHECK((links == src[k]).all());
+  }
+
+  // Graph edges are the sources of the exchange
+  CHECK(dolfinx::MPI::compute_graph_edges(MPI_COMM_WORLD, dest_set) == src);
+}
+
+void test_sparse_all_to_all_repeated()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Consecutive exchanges with the same pattern must not receive the
+  // messages of the following exchange
+  const std::vector<int> dest{(mpi_rank + 1) % mpi_size};
+  for (int it = 0; it < 5; ++it)
+  {
+    const std::vector<std::int32_t> data(it + 1, it);
+    const std::vector<std::int32_t> offsets{0, it + 1};
+    const graph::AdjacencyList<std::int32_t> send_data(data, offsets);
+    const auto [src, recv]
+        = dolfinx::MPI::sparse_all_to_all(MPI_COMM_WORLD, dest, send_data);
+    CHECK(src == std::vector<int>{(mpi_rank - 1 + mpi_size) % mpi_size});
+    CHECK(recv.links(0).rows() == it + 1);
+    CHECK((recv.links(0) == it).all());
+  }
+}
+} // namespace
+
+TEST_CASE("Sparse all-to-all exchange", "[mpi_sparse_all_to_all]")
+{
+  CHECK_NOTHROW(test_sparse_all_to_all());
+}
+
+TEST_CASE("Repeated sparse all-to-all exchanges",
+          "[mpi_sparse_all_to_all_repeated]")
+{
+  CHECK_NOTHROW(test_sparse_all_to_all_repeated());
+}
@@ -51,8 +51,12 @@ def create_vector_nest(L: typing.List[typing.Union[Form, cpp.fem.Form]]) -> PETS
 # -- Matrix instantiation ----------------------------------------------------
 
 
-def create_matrix(a: typing.Union[Form, cpp.fem.Form]) -> PETSc.Mat:
-    return cpp.fem.create_matrix(_create_cpp_form(a))
+def create_matrix(a: typing.Union[Form, cpp.fem.Form], blocked: bool = False) -> PETSc.Mat:
+    """Create a matrix for a bilinear form. If blocked is True, a block
+    compressed row matrix (BAIJ) is created from the node-wise sparsity
+    pattern, which requires blocked dofmaps with the same block size for
+    the test and trial spaces"""
+    return cpp.fem.create_matrix(_create_cpp_form(a), blocked)
 
 
 def create_matrix_block(a: typing.List[typing.List[typing.Union[Form, cpp.fem.Form]]]) -> PETSc.Mat:
@@ -63,6 +67,27 @@ def create_matrix_nest(a: typing.List[typing.List[typing.Union[Form, cpp.fem.For
     return cpp.fem.create_matrix_nest(_create_cpp_form(a))
 
 
+def create_assembly_plan(a: typing.Union[Form, cpp.fem.Form]) -> cpp.fem.AssemblyPlan:
+    """Create an insertion plan for repeated assembly of a bilinear form
+    into a matrix created by create_matrix"""
+    _a = _create_cpp_form(a)
+    pattern = cpp.fem.create_sparsity_pattern(_a)
+    pattern.assemble()
+    return cpp.fem.AssemblyPlan(_a, pattern)
+
+
+def create_matrix_free_operator(a: typing.Union[Form, cpp.fem.Form],
+                                bcs: typing.List[DirichletBC] = [],
+                                diagonal: float = 1.0) -> PETSc.Mat:
+    """Create a matrix-free operator (PETSc MatShell) for a bilinear
+    form. The operator supports matrix-vector products and diagonal
+    extraction, e.g. for Krylov solvers with Jacobi preconditioning.
+    Rows and columns for Dirichlet dofs are zeroed and ``diagonal`` is
+    placed on the diagonal of Dirichlet rows.
+    """
+    return cpp.fem.create_matrix_free_operator(_create_cpp_form(a), bcs, diagonal)
+
+
 # -- Scalar assembly ---------------------------------------------------------
 
 
@@ -77,29 +102,38 @@ def assemble_scalar(M: typing.Union[Form, cpp.fem.Form]) -> PETSc.ScalarType:
 
 
 @functools.singledispatch
-def assemble_vector(L: typing.Union[Form, cpp.fem.Form]) -> PETSc.Vec:
+def assemble_vector(L: typing.Union[Form, cpp.fem.Form], scatter: bool = False) -> PETSc.Vec:
     """Assemble linear form into a new PETSc vector. The returned vector is
     not finalised, i.e. ghost values are not accumulated on the owning
-    processes.
+    processes, unless ``scatter`` is True. With ``scatter``, the
+    accumulation is overlapped with the assembly of cells that have no
+    ghost dofs.
 
     """
     _L = _create_cpp_form(L)
     b = cpp.la.create_vector(_L.function_spaces[0].dofmap.index_map)
     with b.localForm() as b_local:
         b_local.set(0.0)
-        cpp.fem.assemble_vector(b_local.array_w, _L)
+        if not scatter:
+            cpp.fem.assemble_vector(b_local.array_w, _L)
+    if scatter:
+        cpp.fem.assemble_vector_petsc(b, _L, True)
     return b
 
 
 @assemble_vector.register(PETSc.Vec)
-def _(b: PETSc.Vec, L: typing.Union[Form, cpp.fem.Form]) -> PETSc.Vec:
+def _(b: PETSc.Vec, L: typing.Union[Form, cpp.fem.Form], scatter: bool = False) -> PETSc.Vec:
     """Assemble linear form into an existing PETSc vector. The vector is not
     zeroed before assembly and it is not finalised, qi.e. ghost values are
-    not accumulated on the owning processes.
+    not accumulated on the owning processes, unless ``scatter`` is True.
+    With ``scatter``, the ghost entries of ``b`` must be zero on entry.
 
     """
-    with b.localForm() as b_local:
-        cpp.fem.assemble_vector(b_local.array_w, _create_cpp_form(L))
+    if scatter:
+        cpp.fem.assemble_vector_petsc(b, _create_cpp_form(L), True)
+    else:
+        with b.localForm() as b_local:
+            cpp.fem.assemble_vector(b_local.array_w, _create_cpp_form(L))
     return b
 
 
@@ -224,18 +258,43 @@ def assemble_matrix(a: typing.Union[Form, cpp.fem.Form],
 def _(A: PETSc.Mat,
       a: typing.Union[Form, cpp.fem.Form],
       bcs: typing.List[DirichletBC] = [],
-      diagonal: float = 1.0) -> PETSc.Mat:
+      diagonal: float = 1.0,
+      plan: cpp.fem.AssemblyPlan = None) -> PETSc.Mat:
     """Assemble bilinear form into a matrix. The returned matrix is not
-    finalised, i.e. ghost values are not accumulated.
+    finalised, i.e. ghost values are not accumulated. If an assembly
+    plan is given, it is used to insert element matrices for repeated
+    assembly of the same form.
 
     """
     _a = _create_cpp_form(a)
-    cpp.fem.assemble_matrix_petsc(A, _a, bcs)
+    if plan is None:
+        cpp.fem.assemble_matrix_petsc(A, _a, bcs)
+    else:
+        cpp.fem.assemble_matrix_petsc(A, plan, _a, bcs)
     if _a.function_spaces[0].id == _a.function_spaces[1].id:
         cpp.fem.add_diagonal(A, _a.function_spaces[0], bcs, diagonal)
     return A
 
 
+def assemble_fused(A: PETSc.Mat, b: PETSc.Vec,
+                   a: typing.Union[Form, cpp.fem.Form],
+                   L: typing.Union[Form, cpp.fem.Form],
+                   bcs: typing.List[DirichletBC] = [],
+                   diagonal: float = 1.0) -> typing.Tuple[PETSc.Mat, PETSc.Vec]:
+    """Assemble a bilinear form into an existing matrix and a linear form
+    into an existing vector in a single pass over the cells, e.g. the
+    Jacobian and residual of a Newton step. The result is the same as
+    for assemble_matrix(A, a, bcs, diagonal) followed by
+    assemble_vector(b, L). Neither A nor b is zeroed or finalised.
+
+    """
+    _a = _create_cpp_form(a)
+    cpp.fem.assemble_fused_petsc(A, b, _a, _create_cpp_form(L), bcs)
+    if _a.function_spaces[0].id == _a.function_spaces[1].id:
+        cpp.fem.add_diagonal(A, _a.function_spaces[0], bcs, diagonal)
+    return A, b
+
+
 # FIXME: Revise this interface
 @functools.singledispatch
 def assemble_matrix_nest(a: typing.List[typing.List[typing.Union[Form, cpp.fem.Form]]],
@@ -128,6 +128,16 @@ class Function(ufl.Coefficient):
             u = np.reshape(u, (-1, ))
         return u
 
+    def eval_distributed(self, x) -> np.ndarray:
+        """Evaluate Function at points x on any process (collective). x is either an array of
+        points with shape (num_points, 3) or a geometry.PointOwnership for repeated evaluation at
+        the same points. Returns the values at the points, with zero values for points that are not
+        in the mesh."""
+        if isinstance(x, cpp.geometry.PointOwnership):
+            return self._cpp_object.eval_distributed(x)
+        x = np.asarray(x, dtype=np.float64).reshape(-1, 3)
+        return self._cpp_object.eval_distributed(x)
+
     def interpolate(self, u) -> None:
         """Interpolate an expression"""
         @singledispatch
@@ -6,10 +6,14 @@
 
 from dolfinx import cpp
 
+TreeBuilder = cpp.geometry.TreeBuilder
+
 
 class BoundingBoxTree:
-    def __init__(self, obj, dim=None):
-        self._cpp_object = cpp.geometry.BoundingBoxTree(obj, dim)
+    def __init__(self, obj, dim=None, builder=TreeBuilder.median):
+        """Create a BoundingBoxTree for the entities of dimension dim of the mesh obj. The builder
+        selects the algorithm used to build the tree (TreeBuilder.median or TreeBuilder.lbvh)."""
+        self._cpp_object = cpp.geometry.BoundingBoxTree(obj, dim, builder)
 
     @classmethod
     def create_midpoint_tree(cls, mesh):
@@ -39,6 +43,25 @@ def compute_colliding_cells(tree: BoundingBoxTree, mesh, x, n=1):
     return cpp.geometry.select_colliding_cells(mesh, candidate_cells, x, n)
 
 
+def compute_collisions_points(tree: BoundingBoxTree, x):
+    """Compute collisions with each point in the array x (shape=(num_points, 3)). Returns an
+    AdjacencyList with the colliding bounding box leaves of each point."""
+    return cpp.geometry.compute_collisions_points(tree._cpp_object, x)
+
+
+def compute_colliding_cells_points(tree: BoundingBoxTree, mesh, x, n=1):
+    """Return for each point in the array x (shape=(num_points, 3)) the cells which the point lies
+    within, as an AdjacencyList. At most n cells are returned for each point, or all if n is 0."""
+    candidate_cells = cpp.geometry.compute_collisions_points(tree._cpp_object, x)
+    return cpp.geometry.select_colliding_cells(mesh, candidate_cells, x, n)
+
+
 def compute_collisions(tree0: BoundingBoxTree, tree1: BoundingBoxTree):
     """Compute collisions with the bounding box"""
     return cpp.geometry.compute_collisions(tree0._cpp_object, tree1._cpp_object)
+
+
+def compute_point_ownership(tree: BoundingBoxTree, mesh, x):
+    """Compute the distributed ownership of the points x (shape=(num_points, 3)) passed on this
+    process (collective). The tree must be built for the cells of the mesh."""
+    return cpp.geometry.PointOwnership(mesh, tree._cpp_object, x)
@@ -77,6 +77,11 @@ void common(py::module& m)
       .def("indices", &dolfinx::common::IndexMap::indices,
            "Return array of global indices for all indices on this process");
 
+  // dolfinx::common::IndexMap::Mode enum
+  py::enum_<dolfinx::common::IndexMap::Mode>(m, "ScatterMode")
+      .value("insert", dolfinx::common::IndexMap::Mode::insert)
+      .value("add", dolfinx::common::IndexMap::Mode::add);
+
   // dolfinx::common::Timer
   py::class_<dolfinx::common::Timer, std::shared_ptr<dolfinx::common::Timer>>(
       m, "Timer", "Timer class")
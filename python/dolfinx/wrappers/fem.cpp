@@ -9,6 +9,7 @@
 #include <Eigen/Dense>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/types.h>
+#include <dolfinx/fem/AssemblyPlan.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/DirichletBC.h>
 #include <dolfinx/fem/DiscreteOperators.h>
@@ -25,6 +26,7 @@
 #include <dolfinx/function/FunctionSpace.h>
 #include <dolfinx/la/PETScMatrix.h>
 #include <dolfinx/la/PETScVector.h>
+#include <dolfinx/la/Vector.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
@@ -98,7 +100,8 @@ void fem(py::module& m)
       "Create nested vector for multiple (stacked) linear forms.");
 
   m.def("create_sparsity_pattern",
-        &dolfinx::fem::create_sparsity_pattern<PetscScalar>,
+        &dolfinx::fem::create_sparsity_pattern<PetscScalar>, py::arg("a"),
+        py::arg("blocked") = false,
         "Create a sparsity pattern for bilinear form.");
   m.def("pack_coefficients", &dolfinx::fem::pack_coefficients<PetscScalar>,
         "Pack coefficients for a UFL form.");
@@ -106,14 +109,28 @@ void fem(py::module& m)
         "Pack constants for a UFL form.");
   m.def(
       "create_matrix",
-      [](const dolfinx::fem::Form<PetscScalar>& a) {
-        auto A = dolfinx::fem::create_matrix(a);
+      [](const dolfinx::fem::Form<PetscScalar>& a, bool blocked) {
+        auto A = dolfinx::fem::create_matrix(a, blocked);
         Mat _A = A.mat();
         PetscObjectReference((PetscObject)_A);
         return _A;
       },
+      py::return_value_policy::take_ownership, py::arg("a"),
+      py::arg("blocked") = false, "Create a PETSc Mat for bilinear form.");
+  m.def(
+      "create_matrix_free_operator",
+      [](std::shared_ptr<const dolfinx::fem::Form<PetscScalar>> a,
+         const std::vector<std::shared_ptr<
+             const dolfinx::fem::DirichletBC<PetscScalar>>>& bcs,
+         PetscScalar diagonal) {
+        auto A = dolfinx::fem::create_matrix_free_operator(a, bcs, diagonal);
+        Mat _A = A.mat();
+        PetscObjectReference((PetscObject)_A);
+        return _A;
+      },
+      py::arg("a"), py::arg("bcs"), py::arg("diagonal") = 1.0,
       py::return_value_policy::take_ownership,
-      "Create a PETSc Mat for bilinear form.");
+      "Create a matrix-free PETSc operator (MatShell) for bilinear form.");
   m.def(
       "create_matrix_block",
       [](const std::vector<std::vector<const dolfinx::fem::Form<PetscScalar>*>>&
@@ -237,7 +254,9 @@ void fem(py::module& m)
       .def_readonly("index_map", &dolfinx::fem::DofMap::index_map)
       .def_readonly("dof_layout", &dolfinx::fem::DofMap::element_dof_layout)
       .def("cell_dofs", &dolfinx::fem::DofMap::cell_dofs)
-      .def("list", &dolfinx::fem::DofMap::list);
+      .def("list", &dolfinx::fem::DofMap::list)
+      .def_property_readonly("bs", &dolfinx::fem::DofMap::bs)
+      .def("list_blocked", &dolfinx::fem::DofMap::list_blocked);
 
   // dolfinx::fem::CoordinateElement
   py::class_<dolfinx::fem::CoordinateElement,
@@ -279,9 +298,24 @@ void fem(py::module& m)
   m.def("assemble_scalar", &dolfinx::fem::assemble_scalar<PetscScalar>,
         "Assemble functional over mesh");
   // Vector
-  m.def("assemble_vector", &dolfinx::fem::assemble_vector<PetscScalar>,
+  m.def("assemble_vector",
+        py::overload_cast<
+            Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>,
+            const dolfinx::fem::Form<PetscScalar>&>(
+            &dolfinx::fem::assemble_vector<PetscScalar>),
         py::arg("b"), py::arg("L"),
         "Assemble linear form into an existing Eigen vector");
+  m.def("assemble_vector",
+        py::overload_cast<dolfinx::la::Vector<PetscScalar>&,
+                          const dolfinx::fem::Form<PetscScalar>&>(
+            &dolfinx::fem::assemble_vector<PetscScalar>),
+        py::arg("b"), py::arg("L"),
+        "Assemble linear form into an existing distributed vector, "
+        "accumulating ghost contributions on the owning processes");
+  m.def("assemble_vector_petsc", &dolfinx::fem::assemble_vector_petsc,
+        py::arg("b"), py::arg("L"), py::arg("scatter") = false,
+        "Assemble linear form into an existing PETSc vector, optionally "
+        "accumulating ghost contributions on the owning processes");
   // Matrices
   m.def("assemble_matrix_petsc",
         [](Mat A, const dolfinx::fem::Form<PetscScalar>& a,
@@ -296,6 +330,33 @@ void fem(py::module& m)
           dolfinx::fem::assemble_matrix(dolfinx::la::PETScMatrix::add_fn(A), a,
                                         rows0, rows1);
         });
+  m.def("assemble_matrix_blocked_petsc",
+        &dolfinx::fem::assemble_matrix_blocked_petsc, py::arg("A"),
+        py::arg("a"), py::arg("bcs"),
+        "Assemble bilinear form into a block matrix with block-wise "
+        "insertion of element matrices");
+  m.def("assemble_matrix_petsc",
+        py::overload_cast<
+            Mat, dolfinx::fem::AssemblyPlan<PetscScalar>&,
+            const dolfinx::fem::Form<PetscScalar>&,
+            const std::vector<std::shared_ptr<
+                const dolfinx::fem::DirichletBC<PetscScalar>>>&>(
+            &dolfinx::fem::assemble_matrix_petsc),
+        py::arg("A"), py::arg("plan"), py::arg("a"), py::arg("bcs"),
+        "Assemble bilinear form into a PETSc matrix using an assembly plan");
+  m.def("assemble_matrix",
+        py::overload_cast<dolfinx::la::MatrixCSR<PetscScalar>&,
+                          const dolfinx::fem::Form<PetscScalar>&,
+                          const std::vector<std::shared_ptr<
+                              const dolfinx::fem::DirichletBC<PetscScalar>>>&>(
+            &dolfinx::fem::assemble_matrix<PetscScalar>),
+        py::arg("A"), py::arg("a"), py::arg("bcs"),
+        "Assemble bilinear form into a CSR matrix");
+  m.def("assemble_fused_petsc", &dolfinx::fem::assemble_fused_petsc,
+        py::arg("A"), py::arg("b"), py::arg("a"), py::arg("L"),
+        py::arg("bcs"),
+        "Assemble bilinear form into a PETSc matrix and linear form into a "
+        "PETSc vector in a single pass over the cells");
   m.def("add_diagonal",
         [](Mat A, const dolfinx::function::FunctionSpace& V,
            const std::vector<std::shared_ptr<
@@ -378,6 +439,19 @@ void fem(py::module& m)
   //              std::shared_ptr<dolfinx::fem::FormCoefficients<PetscScalar>>>(
   //       m, "FormCoefficients", "Variational form coefficients");
 
+  // dolfinx::fem::AssemblyPlan
+  py::class_<dolfinx::fem::AssemblyPlan<PetscScalar>,
+             std::shared_ptr<dolfinx::fem::AssemblyPlan<PetscScalar>>>(
+      m, "AssemblyPlan", "Insertion plan for repeated matrix assembly")
+      .def(py::init<const dolfinx::fem::Form<PetscScalar>&,
+                    const dolfinx::la::SparsityPattern&>(),
+           py::arg("a"), py::arg("pattern"))
+      .def("compatible", &dolfinx::fem::AssemblyPlan<PetscScalar>::compatible)
+      .def_property_readonly(
+          "matrix",
+          py::overload_cast<>(&dolfinx::fem::AssemblyPlan<PetscScalar>::matrix),
+          py::return_value_policy::reference_internal);
+
   // dolfinx::fem::Form
   py::class_<dolfinx::fem::Form<PetscScalar>,
              std::shared_ptr<dolfinx::fem::Form<PetscScalar>>>(
@@ -418,6 +492,26 @@ void fem(py::module& m)
                  const std::uint32_t))addr.cast<std::uintptr_t>();
              self.set_tabulate_tensor(type, i, tabulate_tensor_ptr);
            })
+      .def("set_batch_tabulate_tensor",
+           [](dolfinx::fem::Form<PetscScalar>& self,
+              dolfinx::fem::IntegralType type, int i, py::object addr) {
+             auto tabulate_tensor_ptr
+                 = (void (*)(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*,
+                             const std::uint32_t*, int))addr
+                       .cast<std::uintptr_t>();
+             self.set_batch_tabulate_tensor(type, i, tabulate_tensor_ptr);
+           })
+      .def("packed_coefficients",
+           &dolfinx::fem::Form<PetscScalar>::packed_coefficients,
+           py::return_value_policy::copy,
+           "Packed coefficients used in assembly (cached)")
+      .def("set_packed_coefficients",
+           &dolfinx::fem::Form<PetscScalar>::set_packed_coefficients,
+           "Supply packed coefficients to use in assembly")
+      .def("clear_packed_coefficients",
+           &dolfinx::fem::Form<PetscScalar>::clear_packed_coefficients,
+           "Revert to packing coefficients from the Form coefficients")
       .def_property_readonly("rank", &dolfinx::fem::Form<PetscScalar>::rank)
       .def("mesh", &dolfinx::fem::Form<PetscScalar>::mesh)
       .def_property_readonly("function_spaces",
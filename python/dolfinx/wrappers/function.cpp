@@ -13,6 +13,7 @@
 #include <dolfinx/function/FunctionSpace.h>
 #include <dolfinx/function/interpolate.h>
 #include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/PointOwnership.h>
 #include <dolfinx/la/PETScVector.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <memory>
@@ -42,6 +43,9 @@ void function(py::module& m)
       .def_readwrite("name", &dolfinx::function::Function<PetscScalar>::name)
       .def_property_readonly("id",
                              &dolfinx::function::Function<PetscScalar>::id)
+      .def_property_readonly(
+          "version", &dolfinx::function::Function<PetscScalar>::version,
+          "Version of the expansion coefficients (changes on modification)")
       .def("sub", &dolfinx::function::Function<PetscScalar>::sub,
            "Return sub-function (view into parent Function")
       .def("collapse", &dolfinx::function::Function<PetscScalar>::collapse,
@@ -87,6 +91,18 @@ void function(py::module& m)
       .def("eval", &dolfinx::function::Function<PetscScalar>::eval,
            py::arg("x"), py::arg("cells"), py::arg("values"),
            "Evaluate Function")
+      .def("eval_distributed",
+           py::overload_cast<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                                Eigen::RowMajor>&>(
+               &dolfinx::function::Function<PetscScalar>::eval_distributed,
+               py::const_),
+           py::arg("x"), "Evaluate Function at points on any process")
+      .def("eval_distributed",
+           py::overload_cast<const dolfinx::geometry::PointOwnership&>(
+               &dolfinx::function::Function<PetscScalar>::eval_distributed,
+               py::const_),
+           py::arg("ownership"),
+           "Evaluate Function at points with precomputed ownership")
       .def("compute_point_values",
            &dolfinx::function::Function<PetscScalar>::compute_point_values,
            "Compute values at all mesh points")
@@ -114,7 +130,10 @@ void function(py::module& m)
                              &dolfinx::function::FunctionSpace::dofmap)
       .def("sub", &dolfinx::function::FunctionSpace::sub)
       .def("tabulate_dof_coordinates",
-           &dolfinx::function::FunctionSpace::tabulate_dof_coordinates);
+           &dolfinx::function::FunctionSpace::tabulate_dof_coordinates)
+      .def("dof_coordinate_ownership",
+           &dolfinx::function::FunctionSpace::dof_coordinate_ownership,
+           py::arg("mesh"));
 
   // dolfinx::function::Constant
   py::class_<dolfinx::function::Constant<PetscScalar>,
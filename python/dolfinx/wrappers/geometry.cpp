@@ -7,6 +7,7 @@
 #include <Eigen/Dense>
 #include <dolfinx/geometry/BoundingBoxTree.h>
 #include <dolfinx/geometry/GJK.h>
+#include <dolfinx/geometry/PointOwnership.h>
 #include <dolfinx/geometry/utils.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <memory>
@@ -47,6 +48,11 @@ void geometry(py::module& m)
         py::overload_cast<const dolfinx::geometry::BoundingBoxTree&,
                           const Eigen::Vector3d&>(
             &dolfinx::geometry::compute_collisions));
+  m.def("compute_collisions_points",
+        py::overload_cast<const dolfinx::geometry::BoundingBoxTree&,
+                          const Eigen::Array<double, Eigen::Dynamic, 3,
+                                             Eigen::RowMajor>&>(
+            &dolfinx::geometry::compute_collisions));
   m.def("compute_collisions",
         py::overload_cast<const dolfinx::geometry::BoundingBoxTree&,
                           const dolfinx::geometry::BoundingBoxTree&>(
@@ -54,13 +60,48 @@ void geometry(py::module& m)
 
   m.def("compute_distance_gjk", &dolfinx::geometry::compute_distance_gjk);
   m.def("squared_distance", &dolfinx::geometry::squared_distance);
-  m.def("select_colliding_cells", &dolfinx::geometry::select_colliding_cells);
+  m.def("select_colliding_cells",
+        py::overload_cast<const dolfinx::mesh::Mesh&, const std::vector<int>&,
+                          const Eigen::Vector3d&, int>(
+            &dolfinx::geometry::select_colliding_cells));
+  m.def("select_colliding_cells",
+        py::overload_cast<
+            const dolfinx::mesh::Mesh&,
+            const dolfinx::graph::AdjacencyList<std::int32_t>&,
+            const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&,
+            int>(&dolfinx::geometry::select_colliding_cells));
+
+  // dolfinx::geometry::TreeBuilder enums
+  py::enum_<dolfinx::geometry::TreeBuilder>(m, "TreeBuilder")
+      .value("median", dolfinx::geometry::TreeBuilder::median)
+      .value("lbvh", dolfinx::geometry::TreeBuilder::lbvh);
 
   // dolfinx::geometry::BoundingBoxTree
   py::class_<dolfinx::geometry::BoundingBoxTree,
              std::shared_ptr<dolfinx::geometry::BoundingBoxTree>>(
       m, "BoundingBoxTree")
-      .def(py::init<const dolfinx::mesh::Mesh&, int>())
+      .def(py::init<const dolfinx::mesh::Mesh&, int,
+                    dolfinx::geometry::TreeBuilder>(),
+           py::arg("mesh"), py::arg("tdim"),
+           py::arg("builder") = dolfinx::geometry::TreeBuilder::median)
       .def(py::init<const std::vector<Eigen::Vector3d>&>());
+
+  // dolfinx::geometry::PointOwnership
+  py::class_<dolfinx::geometry::PointOwnership,
+             std::shared_ptr<dolfinx::geometry::PointOwnership>>(
+      m, "PointOwnership", "Distributed ownership of points in a mesh")
+      .def(py::init<const dolfinx::mesh::Mesh&,
+                    const dolfinx::geometry::BoundingBoxTree&,
+                    const Eigen::Array<double, Eigen::Dynamic, 3,
+                                       Eigen::RowMajor>&>(),
+           py::arg("mesh"), py::arg("tree"), py::arg("x"))
+      .def_property_readonly("num_points",
+                             &dolfinx::geometry::PointOwnership::num_points)
+      .def_property_readonly("owners",
+                             &dolfinx::geometry::PointOwnership::owners)
+      .def_property_readonly("points",
+                             &dolfinx::geometry::PointOwnership::points)
+      .def_property_readonly("cells",
+                             &dolfinx::geometry::PointOwnership::cells);
 }
 } // namespace dolfinx_wrappers
@@ -83,7 +83,10 @@ void io(py::module& m)
            py::arg("name") = "mesh", py::arg("xpath") = "/Xdmf/Domain")
       .def("read_cell_type", &dolfinx::io::XDMFFile::read_cell_type,
            py::arg("name") = "mesh", py::arg("xpath") = "/Xdmf/Domain")
-      .def("write_function", &dolfinx::io::XDMFFile::write_function,
+      .def("write_function",
+           py::overload_cast<const dolfinx::function::Function<PetscScalar>&,
+                             double, const std::string>(
+               &dolfinx::io::XDMFFile::write_function),
            py::arg("function"), py::arg("t"), py::arg("mesh_xpath"))
       .def("write_meshtags", &dolfinx::io::XDMFFile::write_meshtags,
            py::arg("meshtags"),
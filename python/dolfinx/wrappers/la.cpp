@@ -7,6 +7,7 @@
 #include "caster_mpi.h"
 #include "caster_petsc.h"
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/MatrixCSR.h>
 #include <dolfinx/la/PETScMatrix.h>
 #include <dolfinx/la/PETScVector.h>
 #include <dolfinx/la/SparsityPattern.h>
@@ -36,9 +37,12 @@ void la(py::module& m)
       .def(py::init(
           [](const MPICommWrapper comm,
              std::array<std::shared_ptr<const dolfinx::common::IndexMap>, 2>
-                 index_maps) {
-            return dolfinx::la::SparsityPattern(comm.get(), index_maps);
-          }))
+                 index_maps,
+             bool blocked) {
+            return dolfinx::la::SparsityPattern(comm.get(), index_maps,
+                                                blocked);
+          }),
+          py::arg("comm"), py::arg("index_maps"), py::arg("blocked") = false)
       .def(py::init(
           [](const MPICommWrapper comm,
              const std::vector<std::vector<const dolfinx::la::SparsityPattern*>>
@@ -51,6 +55,7 @@ void la(py::module& m)
           }))
       .def("local_range", &dolfinx::la::SparsityPattern::local_range)
       .def("index_map", &dolfinx::la::SparsityPattern::index_map)
+      .def_property_readonly("blocked", &dolfinx::la::SparsityPattern::blocked)
       .def("assemble", &dolfinx::la::SparsityPattern::assemble)
       .def("num_nonzeros", &dolfinx::la::SparsityPattern::num_nonzeros)
       .def("insert", &dolfinx::la::SparsityPattern::insert)
@@ -83,11 +88,41 @@ void la(py::module& m)
         return self[i]->vec();
       });
 
+  // dolfinx::la::Norm enum
+  py::enum_<dolfinx::la::Norm>(m, "Norm")
+      .value("l1", dolfinx::la::Norm::l1)
+      .value("l2", dolfinx::la::Norm::l2)
+      .value("linf", dolfinx::la::Norm::linf)
+      .value("frobenius", dolfinx::la::Norm::frobenius);
+
   // dolfinx::la::Vector
   py::class_<dolfinx::la::Vector<PetscScalar>,
              std::shared_ptr<dolfinx::la::Vector<PetscScalar>>>(m, "Vector")
+      .def(py::init<std::shared_ptr<const dolfinx::common::IndexMap>>())
       .def("array",
-           py::overload_cast<>(&dolfinx::la::Vector<PetscScalar>::array));
+           py::overload_cast<>(&dolfinx::la::Vector<PetscScalar>::array))
+      .def("scatter_fwd", &dolfinx::la::Vector<PetscScalar>::scatter_fwd)
+      .def("scatter_rev", &dolfinx::la::Vector<PetscScalar>::scatter_rev)
+      .def("set", &dolfinx::la::Vector<PetscScalar>::set)
+      .def("scale", &dolfinx::la::Vector<PetscScalar>::scale)
+      .def("axpy", &dolfinx::la::Vector<PetscScalar>::axpy)
+      .def("waxpby", &dolfinx::la::Vector<PetscScalar>::waxpby)
+      .def("dot", &dolfinx::la::Vector<PetscScalar>::dot)
+      .def("norm", &dolfinx::la::Vector<PetscScalar>::norm,
+           py::arg("type") = dolfinx::la::Norm::l2);
+
+  // dolfinx::la::MatrixCSR
+  py::class_<dolfinx::la::MatrixCSR<PetscScalar>,
+             std::shared_ptr<dolfinx::la::MatrixCSR<PetscScalar>>>(m,
+                                                                  "MatrixCSR")
+      .def(py::init<const dolfinx::la::SparsityPattern&>())
+      .def("set", &dolfinx::la::MatrixCSR<PetscScalar>::set)
+      .def("finalize", &dolfinx::la::MatrixCSR<PetscScalar>::finalize)
+      .def("norm_squared", &dolfinx::la::MatrixCSR<PetscScalar>::norm_squared)
+      .def("to_dense", &dolfinx::la::MatrixCSR<PetscScalar>::to_dense)
+      .def_property_readonly(
+          "num_owned_rows",
+          &dolfinx::la::MatrixCSR<PetscScalar>::num_owned_rows);
 
   // utils
   m.def("create_vector",
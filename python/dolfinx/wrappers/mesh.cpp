@@ -109,8 +109,27 @@ void mesh(py::module& m)
   m.def("inradius", &dolfinx::mesh::inradius, "Compute inradius of cells.");
   m.def("radius_ratio", &dolfinx::mesh::radius_ratio);
   m.def("midpoints", &dolfinx::mesh::midpoints);
+
+  // dolfinx::mesh::EntityMetric enums
+  py::enum_<dolfinx::mesh::EntityMetric>(m, "EntityMetric")
+      .value("volume", dolfinx::mesh::EntityMetric::volume)
+      .value("h", dolfinx::mesh::EntityMetric::h)
+      .value("circumradius", dolfinx::mesh::EntityMetric::circumradius)
+      .value("inradius", dolfinx::mesh::EntityMetric::inradius)
+      .value("radius_ratio", dolfinx::mesh::EntityMetric::radius_ratio);
+  m.def("compute_entity_metric", &dolfinx::mesh::compute_entity_metric,
+        "Compute a metric for all entities of given dimension.");
   m.def("compute_boundary_facets", &dolfinx::mesh::compute_boundary_facets);
 
+  // dolfinx::mesh::CellOrdering enums
+  py::enum_<dolfinx::mesh::CellOrdering>(m, "CellOrdering")
+      .value("morton", dolfinx::mesh::CellOrdering::morton)
+      .value("reverse_cuthill_mckee",
+             dolfinx::mesh::CellOrdering::reverse_cuthill_mckee);
+  m.def("compute_cell_traversal_order",
+        &dolfinx::mesh::compute_cell_traversal_order,
+        "Compute an order of owned cells for assembly traversal.");
+
   m.def(
       "create_mesh",
       [](const MPICommWrapper comm,
@@ -192,6 +211,11 @@ void mesh(py::module& m)
       .def("connectivity",
            py::overload_cast<int, int>(&dolfinx::mesh::Topology::connectivity,
                                        py::const_))
+      .def("set_cell_traversal_order",
+           &dolfinx::mesh::Topology::set_cell_traversal_order)
+      .def_property_readonly("cell_traversal_order",
+                             &dolfinx::mesh::Topology::cell_traversal_order,
+                             "Owned cells in assembly traversal order")
       .def("hash", &dolfinx::mesh::Topology::hash)
       .def("index_map", &dolfinx::mesh::Topology::index_map)
       .def_property_readonly("cell_type", &dolfinx::mesh::Topology::cell_type)
@@ -215,6 +239,8 @@ void mesh(py::module& m)
       .def_property_readonly(
           "geometry", py::overload_cast<>(&dolfinx::mesh::Mesh::geometry),
           "Mesh geometry")
+      .def("entity_metric", &dolfinx::mesh::Mesh::entity_metric,
+           "Metric for all entities of given dimension (cached).")
       .def("hash", &dolfinx::mesh::Mesh::hash)
       .def("hmax", &dolfinx::mesh::Mesh::hmax)
       .def("hmin", &dolfinx::mesh::Mesh::hmin)
@@ -721,3 +721,291 @@ def test_basic_assembly_constant(mode):
 
     assert (A1 * 3.0 - A2 * 5.0).norm() == pytest.approx(0.0)
     assert (b1 * 3.0 - b2 * 5.0).norm() == pytest.approx(0.0)
+
+
+def test_packed_coefficient_cache():
+    """Check that cached packed coefficients are updated when a
+    coefficient changes, and that user-supplied packed coefficients are
+    used in assembly"""
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 5, 5)
+    V = function.FunctionSpace(mesh, ("Lagrange", 1))
+    v = ufl.TestFunction(V)
+    f = function.Function(V)
+    with f.vector.localForm() as f_local:
+        f_local.set(1.0)
+
+    L = dolfinx.fem.Form(inner(f, v) * dx)
+    b1 = dolfinx.fem.assemble_vector(L)
+    b1.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+
+    # Modify coefficient through the local form and re-assemble
+    version = f.version
+    with f.vector.localForm() as f_local:
+        f_local.set(2.0)
+    assert f.version != version
+    b2 = dolfinx.fem.assemble_vector(L)
+    b2.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    assert (b2 - 2.0 * b1).norm() == pytest.approx(0.0)
+
+    # Modify coefficient through the global vector and re-assemble
+    f.vector.scale(2.0)
+    f.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+    b3 = dolfinx.fem.assemble_vector(L)
+    b3.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    assert (b3 - 4.0 * b1).norm() == pytest.approx(0.0)
+
+    # Modify coefficient by interpolation, which writes to the
+    # underlying vector, and re-assemble
+    version = f.version
+    f.interpolate(lambda x: numpy.full(x.shape[1], 3.0))
+    assert f.version != version
+    b4 = dolfinx.fem.assemble_vector(L)
+    b4.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    assert (b4 - 3.0 * b1).norm() == pytest.approx(0.0)
+
+    # Assemble with user-supplied packed coefficients
+    coeffs = L._cpp_object.packed_coefficients()
+    assert numpy.allclose(coeffs, dolfinx.cpp.fem.pack_coefficients(L._cpp_object))
+    L._cpp_object.set_packed_coefficients(coeffs / 3.0)
+    b5 = dolfinx.fem.assemble_vector(L)
+    b5.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    assert (b5 - b1).norm() == pytest.approx(0.0)
+
+    L._cpp_object.clear_packed_coefficients()
+    b6 = dolfinx.fem.assemble_vector(L)
+    b6.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    assert (b6 - b4).norm() == pytest.approx(0.0)
+
+
+@pytest.mark.parametrize("mode", [dolfinx.cpp.mesh.GhostMode.none, dolfinx.cpp.mesh.GhostMode.shared_facet])
+def test_assemble_matrix_csr(mode):
+    """Compare assembly into a native CSR matrix with PETSc assembly"""
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 8, 8, ghost_mode=mode)
+    V = function.FunctionSpace(mesh, ("Lagrange", 1))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = dolfinx.fem.Form(inner(u, v) * dx + inner(u, v) * ds)
+
+    u_bc = function.Function(V)
+    bdofs = dolfinx.fem.locate_dofs_geometrical(V, lambda x: numpy.isclose(x[0], 0.0))
+    bc = dolfinx.fem.DirichletBC(u_bc, bdofs)
+
+    A = dolfinx.fem.assemble_matrix(a, [bc], diagonal=0.0)
+    A.assemble()
+
+    pattern = dolfinx.cpp.fem.create_sparsity_pattern(a._cpp_object)
+    pattern.assemble()
+    A_csr = dolfinx.cpp.la.MatrixCSR(pattern)
+    for i in range(2):
+        A_csr.set(0.0)
+        dolfinx.cpp.fem.assemble_matrix(A_csr, a._cpp_object, [bc])
+        A_csr.finalize()
+        assert math.sqrt(A_csr.norm_squared()) == pytest.approx(A.norm(PETSc.NormType.FROBENIUS))
+
+    # Compare owned rows
+    r0, r1 = A.getOwnershipRange()
+    assert A_csr.num_owned_rows == r1 - r0
+    A_dense = A_csr.to_dense()
+    for row in range(r0, r1):
+        cols, vals = A.getRow(row)
+        assert numpy.allclose(A_dense[row - r0, cols], vals)
+
+
+@pytest.mark.parametrize("mode", [dolfinx.cpp.mesh.GhostMode.none, dolfinx.cpp.mesh.GhostMode.shared_facet])
+def test_assemble_matrix_plan(mode):
+    """Compare repeated assembly using an assembly plan with standard
+    PETSc assembly"""
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 8, 8, ghost_mode=mode)
+    V = function.FunctionSpace(mesh, ("DG", 1))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    k = function.Function(V)
+    a = dolfinx.fem.Form(k * inner(u, v) * dx + inner(u, v) * ds
+                         + inner(ufl.avg(u), ufl.avg(v)) * ufl.dS)
+
+    u_bc = function.Function(V)
+    bdofs = dolfinx.fem.locate_dofs_geometrical(V, lambda x: numpy.isclose(x[0], 0.0))
+    bc = dolfinx.fem.DirichletBC(u_bc, bdofs)
+
+    plan = dolfinx.fem.create_assembly_plan(a)
+    assert plan.compatible(a._cpp_object)
+    A = dolfinx.fem.create_matrix(a)
+    for i in range(3):
+        with k.vector.localForm() as k_local:
+            k_local.set(1.0 + i)
+        A.zeroEntries()
+        dolfinx.fem.assemble_matrix(A, a, [bc], plan=plan)
+        A.assemble()
+        A0 = dolfinx.fem.assemble_matrix(a, [bc])
+        A0.assemble()
+        assert (A - A0).norm() == pytest.approx(0.0, abs=1.0e-12)
+
+    # Plan does not match form with a different space, so assembly
+    # falls back to standard insertion
+    W = function.FunctionSpace(mesh, ("Lagrange", 1))
+    u, v = ufl.TrialFunction(W), ufl.TestFunction(W)
+    a1 = dolfinx.fem.Form(inner(u, v) * dx)
+    assert not plan.compatible(a1._cpp_object)
+    A = dolfinx.fem.create_matrix(a1)
+    A.zeroEntries()
+    dolfinx.fem.assemble_matrix(A, a1, [], plan=plan)
+    A.assemble()
+    A0 = dolfinx.fem.assemble_matrix(a1, [])
+    A0.assemble()
+    assert (A - A0).norm() == pytest.approx(0.0, abs=1.0e-12)
+
+
+@pytest.mark.parametrize("mode", [dolfinx.cpp.mesh.GhostMode.none, dolfinx.cpp.mesh.GhostMode.shared_facet])
+def test_matrix_free_operator(mode):
+    """Compare the action and diagonal of a matrix-free operator with
+    the assembled matrix, and solve with CG and Jacobi preconditioning"""
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 12, 12, ghost_mode=mode)
+    V = function.FunctionSpace(mesh, ("Lagrange", 2))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = dolfinx.fem.Form(inner(ufl.grad(u), ufl.grad(v)) * dx + inner(u, v) * ds)
+    L = dolfinx.fem.Form(inner(1.0, v) * dx)
+
+    u_bc = function.Function(V)
+    bdofs = dolfinx.fem.locate_dofs_geometrical(V, lambda x: numpy.isclose(x[0], 0.0))
+    bc = dolfinx.fem.DirichletBC(u_bc, bdofs)
+
+    A0 = dolfinx.fem.assemble_matrix(a, [bc])
+    A0.assemble()
+    A = dolfinx.fem.create_matrix_free_operator(a, [bc])
+    assert A.getType() == "shell"
+    assert A.getSizes() == A0.getSizes()
+
+    x = A0.createVecRight()
+    x.setRandom()
+    y, y0 = A0.createVecLeft(), A0.createVecLeft()
+    A.mult(x, y)
+    A0.mult(x, y0)
+    assert (y - y0).norm() == pytest.approx(0.0, abs=1.0e-10)
+
+    d, d0 = A0.createVecLeft(), A0.createVecLeft()
+    A.getDiagonal(d)
+    A0.getDiagonal(d0)
+    assert (d - d0).norm() == pytest.approx(0.0, abs=1.0e-10)
+
+    b = dolfinx.fem.assemble_vector(L)
+    b.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    dolfinx.fem.set_bc(b, [bc])
+
+    solver = PETSc.KSP().create(mesh.mpi_comm())
+    solver.setOperators(A, A0)
+    solver.setType("cg")
+    solver.getPC().setType("jacobi")
+    solver.setTolerances(rtol=1.0e-10)
+    u0 = A0.createVecRight()
+    solver.solve(b, u0)
+    assert solver.getConvergedReason() > 0
+
+    solver.setOperators(A)
+    u1 = A0.createVecRight()
+    solver.solve(b, u1)
+    assert solver.getConvergedReason() > 0
+    assert (u1 - u0).norm() == pytest.approx(0.0, abs=1.0e-8)
+
+
+@pytest.mark.parametrize("mode", [dolfinx.cpp.mesh.GhostMode.none, dolfinx.cpp.mesh.GhostMode.shared_facet])
+def test_assemble_vector_scatter(mode):
+    """Compare assembly with overlapped ghost accumulation against
+    assembly followed by a ghost update"""
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 12, 12, ghost_mode=mode)
+    V = function.FunctionSpace(mesh, ("Lagrange", 2))
+    v = ufl.TestFunction(V)
+    x = ufl.SpatialCoordinate(mesh)
+    L = dolfinx.fem.Form(inner(x[0], v) * dx + inner(x[1], v) * ds)
+
+    b0 = dolfinx.fem.assemble_vector(L)
+    b0.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    b1 = dolfinx.fem.assemble_vector(L, scatter=True)
+    assert (b1 - b0).norm() == pytest.approx(0.0, abs=1.0e-12)
+
+    with b1.localForm() as b_local:
+        b_local.set(0.0)
+    dolfinx.fem.assemble_vector(b1, L, scatter=True)
+    assert (b1 - b0).norm() == pytest.approx(0.0, abs=1.0e-12)
+
+    # Generic (non-PETSc) distributed vector
+    b2 = dolfinx.cpp.la.Vector(V.dofmap.index_map)
+    b2.set(0.0)
+    dolfinx.cpp.fem.assemble_vector(b2, L._cpp_object)
+    size_owned = V.dofmap.index_map.size_local * V.dofmap.index_map.block_size
+    assert numpy.allclose(b2.array()[:size_owned], b0.array)
+
+
+@pytest.mark.parametrize("mode", [dolfinx.cpp.mesh.GhostMode.none, dolfinx.cpp.mesh.GhostMode.shared_facet])
+def test_assemble_fused(mode):
+    """Compare fused assembly of a Jacobian and residual with separate
+    assembly"""
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 12, 12, ghost_mode=mode)
+    V = function.FunctionSpace(mesh, ("Lagrange", 1))
+    u, v = function.Function(V), ufl.TestFunction(V)
+    u.interpolate(lambda x: 1.0 + x[0] * x[1])
+    F = inner((1 + u**2) * ufl.grad(u), ufl.grad(v)) * dx - inner(1.0, v) * dx + inner(u, v) * ds
+    J = derivative(F, u, ufl.TrialFunction(V))
+    a, L = dolfinx.fem.Form(J), dolfinx.fem.Form(F)
+
+    u_bc = function.Function(V)
+    bdofs = dolfinx.fem.locate_dofs_geometrical(V, lambda x: numpy.isclose(x[0], 0.0))
+    bc = dolfinx.fem.DirichletBC(u_bc, bdofs)
+
+    A0 = dolfinx.fem.assemble_matrix(a, [bc])
+    A0.assemble()
+    b0 = dolfinx.fem.assemble_vector(L)
+    b0.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+
+    A = dolfinx.fem.create_matrix(a)
+    A.zeroEntries()
+    b = dolfinx.fem.create_vector(L)
+    with b.localForm() as b_local:
+        b_local.set(0.0)
+    dolfinx.fem.assemble_fused(A, b, a, L, [bc])
+    A.assemble()
+    b.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+
+    assert (A - A0).norm() == pytest.approx(0.0, abs=1.0e-12)
+    assert (b - b0).norm() == pytest.approx(0.0, abs=1.0e-12)
+
+
+@pytest.mark.parametrize("mode", [dolfinx.cpp.mesh.GhostMode.none, dolfinx.cpp.mesh.GhostMode.shared_facet])
+def test_assemble_matrix_blocked(mode):
+    """Compare assembly of a vector-valued problem into a block compressed
+    row matrix with assembly into a standard matrix"""
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 8, 8, ghost_mode=mode)
+    V = function.VectorFunctionSpace(mesh, ("Lagrange", 2))
+    assert V.dofmap.bs == 2
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = dolfinx.fem.Form(inner(ufl.sym(ufl.grad(u)), ufl.grad(v)) * dx + inner(u, v) * ds
+                         + inner(ufl.avg(u), ufl.avg(v)) * ufl.dS)
+
+    u_bc = function.Function(V)
+    bdofs = dolfinx.fem.locate_dofs_geometrical(V, lambda x: numpy.isclose(x[0], 0.0))
+    bc = dolfinx.fem.DirichletBC(u_bc, bdofs)
+
+    pattern = dolfinx.cpp.fem.create_sparsity_pattern(a._cpp_object, blocked=True)
+    pattern.assemble()
+    assert pattern.blocked
+    pattern0 = dolfinx.cpp.fem.create_sparsity_pattern(a._cpp_object)
+    pattern0.assemble()
+    assert 4 * pattern.num_nonzeros() == pattern0.num_nonzeros()
+
+    A = dolfinx.fem.create_matrix(a, blocked=True)
+    assert "baij" in A.getType()
+    assert A.getBlockSize() == 2
+    A.zeroEntries()
+    dolfinx.fem.assemble_matrix(A, a, [bc])
+    A.assemble()
+
+    # Block-wise insertion of element matrices
+    A1 = dolfinx.fem.create_matrix(a, blocked=True)
+    A1.zeroEntries()
+    dolfinx.cpp.fem.assemble_matrix_blocked_petsc(A1, a._cpp_object, [bc])
+    dolfinx.cpp.fem.add_diagonal(A1, a._cpp_object.function_spaces[0], [bc], 1.0)
+    A1.assemble()
+
+    A0 = dolfinx.fem.assemble_matrix(a, [bc])
+    A0.assemble()
+    A1.axpy(-1.0, A)
+    assert A1.norm() == pytest.approx(0.0, abs=1.0e-12)
+    A0.axpy(-1.0, A, structure=PETSc.Mat.Structure.SUBSET_NONZERO_PATTERN)
+    assert A0.norm() == pytest.approx(0.0, abs=1.0e-12)
@@ -96,6 +96,63 @@ def test_numba_assembly():
     list_timings(MPI.COMM_WORLD, [TimingType.wall])
 
 
+c_signature_batch = numba.types.void(
+    numba.types.CPointer(numba.typeof(PETSc.ScalarType())),
+    numba.types.CPointer(numba.typeof(PETSc.ScalarType())),
+    numba.types.CPointer(numba.typeof(PETSc.ScalarType())),
+    numba.types.CPointer(numba.types.double),
+    numba.types.CPointer(numba.types.uint32),
+    numba.types.int32)
+
+
+@numba.cfunc(c_signature_batch, nopython=True)
+def tabulate_tensor_A_batch(A_, w_, c_, coords_, cell_info, n):
+    A = numba.carray(A_, (3, 3, n), dtype=PETSc.ScalarType)
+    coordinate_dofs = numba.carray(coords_, (3, 2, n), dtype=np.float64)
+    for q in range(n):
+        x0, y0 = coordinate_dofs[0, 0, q], coordinate_dofs[0, 1, q]
+        x1, y1 = coordinate_dofs[1, 0, q], coordinate_dofs[1, 1, q]
+        x2, y2 = coordinate_dofs[2, 0, q], coordinate_dofs[2, 1, q]
+        Ae = abs((x0 - x1) * (y2 - y1) - (y0 - y1) * (x2 - x1))
+        B = np.array(
+            [y1 - y2, y2 - y0, y0 - y1, x2 - x1, x0 - x2, x1 - x0],
+            dtype=PETSc.ScalarType).reshape(2, 3)
+        A[:, :, q] = np.dot(B.T, B) / (2 * Ae)
+
+
+@numba.cfunc(c_signature_batch, nopython=True)
+def tabulate_tensor_b_batch(b_, w_, c_, coords_, cell_info, n):
+    b = numba.carray(b_, (3, n), dtype=PETSc.ScalarType)
+    coordinate_dofs = numba.carray(coords_, (3, 2, n), dtype=np.float64)
+    for q in range(n):
+        x0, y0 = coordinate_dofs[0, 0, q], coordinate_dofs[0, 1, q]
+        x1, y1 = coordinate_dofs[1, 0, q], coordinate_dofs[1, 1, q]
+        x2, y2 = coordinate_dofs[2, 0, q], coordinate_dofs[2, 1, q]
+        Ae = abs((x0 - x1) * (y2 - y1) - (y0 - y1) * (x2 - x1))
+        b[:, q] = Ae / 6.0
+
+
+def test_numba_batch_assembly():
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 13, 13)
+    V = FunctionSpace(mesh, ("Lagrange", 1))
+
+    a = cpp.fem.Form([V._cpp_object, V._cpp_object])
+    a.set_tabulate_tensor(IntegralType.cell, -1, tabulate_tensor_A.address)
+    a.set_batch_tabulate_tensor(IntegralType.cell, -1, tabulate_tensor_A_batch.address)
+
+    L = cpp.fem.Form([V._cpp_object])
+    L.set_tabulate_tensor(IntegralType.cell, -1, tabulate_tensor_b.address)
+    L.set_batch_tabulate_tensor(IntegralType.cell, -1, tabulate_tensor_b_batch.address)
+
+    A = dolfinx.fem.assemble_matrix(a)
+    A.assemble()
+    b = dolfinx.fem.assemble_vector(L)
+    b.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+
+    assert np.isclose(A.norm(PETSc.NormType.FROBENIUS), 56.124860801609124)
+    assert np.isclose(b.norm(PETSc.NormType.N2), 0.0739710713711999)
+
+
 def test_coefficient():
     mesh = UnitSquareMesh(MPI.COMM_WORLD, 13, 13)
     V = FunctionSpace(mesh, ("Lagrange", 1))
@@ -17,8 +17,9 @@ from petsc4py import PETSc
 
 import ufl
 import dolfinx
-from dolfinx import (Function, FunctionSpace, TensorFunctionSpace, Mesh,
+from dolfinx import (BoxMesh, Function, FunctionSpace, TensorFunctionSpace, Mesh,
                      UnitCubeMesh, VectorFunctionSpace, cpp, geometry)
+from dolfinx.mesh import create_mesh
 
 
 @pytest.fixture
@@ -71,6 +72,35 @@ def test_compute_point_values(V, W, mesh):
     assert all(u_values == u_values2)
 
 
+def test_compute_point_values_p2_geometry():
+    # Two triangles with curved (P2) edges
+    domain = ufl.Mesh(ufl.VectorElement("Lagrange", "triangle", 2))
+    if MPI.COMM_WORLD.rank == 0:
+        points = np.array([[0.0, 0.0], [1.0, 0.0], [1.0, 1.0], [0.0, 1.0], [1.1, 0.5],
+                           [0.5, 0.55], [0.5, -0.1], [0.5, 1.1], [-0.1, 0.5]])
+        cells = np.array([[0, 1, 2, 4, 5, 6], [0, 2, 3, 7, 8, 5]])
+    else:
+        points, cells = np.zeros((0, 2)), np.zeros((0, 6))
+    mesh = create_mesh(MPI.COMM_WORLD, cells, points, domain)
+
+    # The values of a Nedelec function depend on the Jacobian of the
+    # geometry map
+    V = FunctionSpace(mesh, ("N1curl", 1))
+    u = Function(V)
+    u.vector.array[:] = np.random.RandomState(0).rand(len(u.vector.array))
+    u.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+    values = u.compute_point_values()
+
+    # Reference values from evaluation at the geometry nodes of each
+    # cell, with the last cell of a node taking precedence
+    ref = np.zeros_like(values)
+    num_cells = mesh.topology.index_map(2).size_local + mesh.topology.index_map(2).num_ghosts
+    for c in range(num_cells):
+        nodes = mesh.geometry.dofmap.links(c)
+        ref[nodes] = u.eval(mesh.geometry.x[nodes], np.full(len(nodes), c, dtype=np.int32))
+    assert np.allclose(values, ref)
+
+
 @pytest.mark.skip
 def test_assign(V, W):
     for V0, V1, vector_space in [(V, W, False), (W, V, True)]:
@@ -195,6 +225,66 @@ def test_eval_multiple(W):
     u.eval(x[0], cell)
 
 
+def test_eval_grouped(W):
+    u = Function(W)
+    u.interpolate(lambda x: np.vstack((x[0] + x[1], 2 * x[2], x[0] - x[1])))
+    u.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+
+    # Several points in each of the first cells, in random order and
+    # with cells repeated non-contiguously. The last point is skipped.
+    mesh = W.mesh
+    num_cells = min(mesh.topology.index_map(mesh.topology.dim).size_local, 10)
+    rng = np.random.RandomState(0)
+    cells, x = [], []
+    for c in range(num_cells):
+        nodes = mesh.geometry.x[mesh.geometry.dofmap.links(c)]
+        for _ in range(4):
+            w = rng.rand(len(nodes))
+            x.append(w.dot(nodes) / w.sum())
+            cells.append(c)
+    order = rng.permutation(len(cells))
+    x = np.array(x)[order].reshape(-1, 3)
+    cells = np.array(cells, dtype=np.int32)[order]
+    x = np.vstack((x, [[0.5, 0.5, 0.5]]))
+    cells = np.append(cells, -1).astype(np.int32)
+
+    values = u.eval(x, cells)
+    ref = np.vstack((x[:, 0] + x[:, 1], 2 * x[:, 2], x[:, 0] - x[:, 1])).T
+    ref[-1] = 0.0
+    assert np.allclose(values, ref)
+
+    # Grouped evaluation agrees with evaluation point by point
+    for xi, c, v in zip(x[:-1], cells[:-1], values[:-1]):
+        assert np.allclose(u.eval(xi, [c]), v)
+
+
+def test_eval_distributed(W):
+    u = Function(W)
+    u.interpolate(lambda x: np.vstack((x[0] + x[1], 2 * x[2], x[0] - x[1])))
+    u.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+
+    # Points differ between processes, and the last point is outside
+    # the mesh
+    mesh = W.mesh
+    x = np.random.RandomState(MPI.COMM_WORLD.rank).rand(20, 3)
+    x[-1] = [1.5, 0.5, 0.5]
+    ref = np.vstack((x[:, 0] + x[:, 1], 2 * x[:, 2], x[:, 0] - x[:, 1])).T
+    ref[-1] = 0.0
+
+    values = u.eval_distributed(x)
+    assert np.allclose(values, ref)
+
+    # Reuse the point ownership
+    tree = geometry.BoundingBoxTree(mesh, mesh.topology.dim)
+    ownership = geometry.compute_point_ownership(tree, mesh, x)
+    assert ownership.num_points == len(x)
+    assert np.all(np.asarray(ownership.owners)[:-1] >= 0)
+    assert ownership.owners[-1] == -1
+    u.vector.scale(2.0)
+    u.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+    assert np.allclose(u.eval_distributed(ownership), 2 * ref)
+
+
 @skip_in_parallel
 def test_eval_manifold():
     # Simple two-triangle surface in 3d
@@ -369,6 +459,56 @@ def test_cffi_expression(V):
     assert (f1.vector - f2.vector).norm() < 1.0e-12
 
 
+def test_interpolation_nonmatching_mesh():
+    mesh0 = UnitCubeMesh(MPI.COMM_WORLD, 3, 3, 3)
+    mesh1 = BoxMesh(MPI.COMM_WORLD, [np.array([0.0, 0.0, 0.0]), np.array([2.0, 1.0, 1.0])],
+                    [4, 2, 3], cpp.mesh.CellType.tetrahedron)
+    V0 = FunctionSpace(mesh0, ("CG", 1))
+    V1 = FunctionSpace(mesh1, ("CG", 1))
+
+    def f(x):
+        return 1 + x[0] + 2 * x[1] - x[2]
+
+    u0 = Function(V0)
+    u0.interpolate(f)
+    u0.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+
+    # Mesh1 has vertices on the plane x = 1. Dofs outside mesh0 (x > 1)
+    # are set to zero.
+    u1 = Function(V1)
+    u1.interpolate(u0)
+    x = V1.tabulate_dof_coordinates()
+    ref = np.where(x[:, 0] < 1.0 + 1.0e-12, f(x.T), 0.0)
+    assert np.allclose(u1.vector.array, ref[:len(u1.vector.array)])
+
+    # The ownership of the dof coordinates is cached and reused
+    ownership = V1._cpp_object.dof_coordinate_ownership(mesh0)
+    assert ownership is V1._cpp_object.dof_coordinate_ownership(mesh0)
+    u0.vector.scale(2.0)
+    u0.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+    u1.interpolate(u0)
+    assert np.allclose(u1.vector.array, 2 * ref[:len(u1.vector.array)])
+
+    # Interpolate back onto the original mesh
+    w0 = Function(V0)
+    w0.interpolate(u1)
+    assert np.allclose(w0.vector.array, u0.vector.array)
+
+    # Only the ownership for the most recently used mesh is cached
+    V1._cpp_object.dof_coordinate_ownership(mesh1)
+    assert ownership is not V1._cpp_object.dof_coordinate_ownership(mesh0)
+
+
+def test_interpolation_nonmatching_mesh_value_size():
+    mesh0 = UnitCubeMesh(MPI.COMM_WORLD, 3, 3, 3)
+    mesh1 = UnitCubeMesh(MPI.COMM_WORLD, 2, 2, 2)
+    V0 = VectorFunctionSpace(mesh0, ("CG", 1))
+    V1 = FunctionSpace(mesh1, ("CG", 1))
+    u0, u1 = Function(V0), Function(V1)
+    with pytest.raises(RuntimeError):
+        u1.interpolate(u0)
+
+
 def test_interpolation_function(mesh):
     V = FunctionSpace(mesh, ("CG", 1))
     u = Function(V)
@@ -105,6 +105,40 @@ def test_compute_collisions_tree_3d():
         assert entities_B == references[i][1]
 
 
+def test_compute_collisions_points():
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 5, 5, 5)
+    tree = BoundingBoxTree(mesh, mesh.topology.dim)
+    points = numpy.random.RandomState(1).rand(50, 3)
+    points[:10, 2] += 1.0
+
+    candidates = geometry.compute_collisions_points(tree, points)
+    cells = geometry.compute_colliding_cells_points(tree, mesh, points, n=0)
+    first_cell = geometry.compute_colliding_cells_points(tree, mesh, points)
+    assert candidates.num_nodes == cells.num_nodes == len(points)
+    for i, p in enumerate(points):
+        assert list(candidates.links(i)) == list(geometry.compute_collisions_point(tree, p))
+        assert list(cells.links(i)) == list(geometry.compute_colliding_cells(tree, mesh, p, 0))
+        assert list(first_cell.links(i)) == list(geometry.compute_colliding_cells(tree, mesh, p, 1))
+
+
+@pytest.mark.parametrize("mesh", [UnitIntervalMesh(MPI.COMM_WORLD, 16), UnitSquareMesh(MPI.COMM_WORLD, 6, 5),
+                                  UnitCubeMesh(MPI.COMM_WORLD, 4, 3, 5)])
+def test_tree_builders(mesh):
+    tdim = mesh.topology.dim
+    tree = BoundingBoxTree(mesh, tdim)
+    tree_lbvh = BoundingBoxTree(mesh, tdim, geometry.TreeBuilder.lbvh)
+    points = numpy.zeros((40, 3))
+    points[:, :tdim] = numpy.random.RandomState(2).rand(40, tdim)
+
+    for p in points:
+        assert set(geometry.compute_collisions_point(tree, p)) == set(
+            geometry.compute_collisions_point(tree_lbvh, p))
+        assert set(geometry.compute_colliding_cells(tree, mesh, p, 0)) == set(
+            geometry.compute_colliding_cells(tree_lbvh, mesh, p, 0))
+    assert set(map(tuple, geometry.compute_collisions(tree, tree_lbvh))) == set(
+        map(tuple, geometry.compute_collisions(tree, tree)))
+
+
 @skip_in_parallel
 def test_compute_closest_entity_1d():
     reference = (0, 1.0)
@@ -9,7 +9,9 @@ import numpy as np
 import pytest
 from mpi4py import MPI
 
+import ufl
 from dolfinx import FunctionSpace, UnitSquareMesh, cpp
+from dolfinx.fem import Form
 from dolfinx.cpp.mesh import CellType
 # from dolfinx_utils.test.fixtures import fixture
 
@@ -168,3 +170,23 @@ def xtest_insert_local_global(mesh, V):
             assert nnz_od[local_row] == (nnz_off_diagonal if
                                          local_row in primary_dim_local_entries
                                          else 0)
+
+
+@pytest.mark.parametrize("degree", [1, 2])
+def test_create_sparsity_pattern(mesh, degree):
+    """Compare pattern created from the dofmaps with a pattern created
+    by inserting the dofs of each cell"""
+    V = FunctionSpace(mesh, ("Lagrange", degree))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    a = Form(ufl.inner(u, v) * ufl.dx)
+    sp0 = cpp.fem.create_sparsity_pattern(a._cpp_object)
+    sp0.assemble()
+
+    index_map = V.dofmap.index_map
+    sp1 = cpp.la.SparsityPattern(mesh.mpi_comm(), [index_map, index_map])
+    cell_map = mesh.topology.index_map(mesh.topology.dim)
+    for c in range(cell_map.size_local + cell_map.num_ghosts):
+        dofs = np.asarray(V.dofmap.cell_dofs(c), dtype=np.int32)
+        sp1.insert(dofs, dofs)
+    sp1.assemble()
+    assert sp0.num_nonzeros() == sp1.num_nonzeros()
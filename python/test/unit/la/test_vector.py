@@ -0,0 +1,77 @@
+# Copyright (C) 2026 The DOLFINX authors
+#
+# This file is part of DOLFINX (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+"""Unit tests for the distributed la::Vector"""
+
+import numpy as np
+import pytest
+from mpi4py import MPI
+from petsc4py import PETSc
+
+from dolfinx import Function, FunctionSpace, UnitSquareMesh, cpp
+from dolfinx.cpp.mesh import GhostMode
+
+
+@pytest.fixture
+def V():
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 8, 8, ghost_mode=GhostMode.shared_facet)
+    return FunctionSpace(mesh, ("Lagrange", 1))
+
+
+def test_reductions(V):
+    u = Function(V)
+    u.interpolate(lambda x: x[0] - 2 * x[1])
+    v = Function(V)
+    v.interpolate(lambda x: 1 + x[1])
+
+    # The PETSc vectors share storage with the la::Vectors
+    x, y = u.x, v.x
+    assert x.norm() == pytest.approx(u.vector.norm())
+    assert x.norm(cpp.la.Norm.l1) == pytest.approx(u.vector.norm(PETSc.NormType.N1))
+    assert x.norm(cpp.la.Norm.linf) == pytest.approx(u.vector.norm(PETSc.NormType.NORM_INFINITY))
+    assert x.dot(y) == pytest.approx(v.vector.dot(u.vector))
+
+
+def test_blas1(V):
+    u = Function(V)
+    u.interpolate(lambda x: x[0] - 2 * x[1])
+    v = Function(V)
+    v.interpolate(lambda x: 1 + x[1])
+    w = Function(V)
+    ref = 2 * u.vector.array + 3 * v.vector.array
+
+    w.x.waxpby(2.0, u.x, 3.0, v.x)
+    assert np.allclose(w.vector.array, ref)
+
+    w.x.axpy(-3.0, v.x)
+    w.x.scale(0.5)
+    assert np.allclose(w.vector.array, u.vector.array)
+
+
+def test_scatter(V):
+    index_map = V.dofmap.index_map
+    owners = index_map.ghost_owner_rank()
+    rank = MPI.COMM_WORLD.rank
+    u = Function(V)
+    x = u.x
+
+    # Forward: ghosts take the value of the owner
+    x.set(-1.0)
+    with u.vector.localForm() as loc:
+        loc.array[:index_map.size_local] = rank
+    x.scatter_fwd()
+    with u.vector.localForm() as loc:
+        assert np.allclose(loc.array[index_map.size_local:], owners)
+        assert np.allclose(loc.array[:index_map.size_local], rank)
+
+    # Reverse: owners accumulate the ghost values
+    x.set(0.0)
+    with u.vector.localForm() as loc:
+        loc.array[index_map.size_local:] = 1.0
+    x.scatter_rev(cpp.common.ScatterMode.add)
+    with u.vector.localForm() as loc:
+        num_shared = loc.array[:index_map.size_local].sum()
+    total = MPI.COMM_WORLD.allreduce(num_shared, op=MPI.SUM)
+    assert total == pytest.approx(MPI.COMM_WORLD.allreduce(index_map.num_ghosts, op=MPI.SUM))
@@ -333,6 +333,68 @@ def test_rmin_rmax(mesh1d, mesh2d, mesh3d):
     # assert round(mesh3d.rmin() - 0.0, 7) == 0
     # assert round(mesh3d.rmax() - math.sqrt(3.0) / 6.0, 7) == 0
 
+
+@skip_in_parallel
+def test_entity_metric_cells(c0, c1, c5):
+    mesh, tdim = c0[0], c0[1]
+    EntityMetric = cpp.mesh.EntityMetric
+    r = cpp.mesh.compute_entity_metric(mesh, EntityMetric.inradius, tdim)
+    assert r[c0[2]] == pytest.approx((3.0 - math.sqrt(3.0)) / 6.0)
+    assert r[c1[2]] == pytest.approx(0.0)
+    assert r[c5[2]] == pytest.approx(math.sqrt(3.0) / 6.0)
+    cr = cpp.mesh.compute_entity_metric(mesh, EntityMetric.circumradius, tdim)
+    assert cr[c0[2]] == pytest.approx(math.sqrt(3.0) / 2.0)
+    assert cr[c5[2]] == pytest.approx(math.sqrt(3.0) / 2.0)
+    ratio = cpp.mesh.compute_entity_metric(mesh, EntityMetric.radius_ratio, tdim)
+    assert ratio[c0[2]] == pytest.approx(math.sqrt(3.0) - 1.0)
+    assert ratio[c5[2]] == pytest.approx(1.0)
+
+
+def test_entity_metric(cube):
+    tdim = cube.topology.dim
+    index_map = cube.topology.index_map(tdim)
+    cells = range(index_map.size_local + index_map.num_ghosts)
+    EntityMetric = cpp.mesh.EntityMetric
+    metric = cpp.mesh.compute_entity_metric
+    assert np.allclose(metric(cube, EntityMetric.volume, tdim), cpp.mesh.volume_entities(cube, cells, tdim))
+    assert np.allclose(metric(cube, EntityMetric.h, tdim), cpp.mesh.h(cube, cells, tdim))
+    assert np.allclose(metric(cube, EntityMetric.circumradius, tdim), cpp.mesh.circumradius(cube, cells, tdim))
+
+    # The size of an edge is its length
+    assert np.allclose(metric(cube, EntityMetric.h, 1), metric(cube, EntityMetric.volume, 1))
+
+    # Facets of the unit cube mesh are right triangles with legs of
+    # length 1/3 or 1/3 and sqrt(2)/3
+    areas = metric(cube, EntityMetric.volume, tdim - 1)
+    assert np.all(np.isclose(areas, 1 / 18) | np.isclose(areas, math.sqrt(2.0) / 18))
+
+
+def test_entity_metric_cache(cube):
+    tdim = cube.topology.dim
+    hmax, rmax = cube.hmax(), cube.rmax()
+    assert np.allclose(cube.entity_metric(cpp.mesh.EntityMetric.h, tdim).max(), hmax)
+
+    # Cached values are recomputed after the geometry is modified
+    cube.geometry.x[:] *= 2.0
+    assert cube.hmax() == pytest.approx(2.0 * hmax)
+    assert cube.rmax() == pytest.approx(2.0 * rmax)
+
+
+def test_entity_metric_cache_held_view(cube):
+    tdim = cube.topology.dim
+    x = cube.geometry.x
+    hmin = cube.hmin()
+
+    # Reading the coordinates does not discard the cached values
+    h = cube.entity_metric(cpp.mesh.EntityMetric.h, tdim)
+    assert cube.geometry.x.shape == x.shape
+    assert np.allclose(cube.entity_metric(cpp.mesh.EntityMetric.h, tdim), h)
+
+    # Modification through a view obtained before the values were cached
+    x[:] *= 2.0
+    assert cube.hmin() == pytest.approx(2.0 * hmin)
+    assert np.allclose(cube.entity_metric(cpp.mesh.EntityMetric.h, tdim), 2.0 * h)
+
 # - Facilities to run tests on combination of meshes
 
 
@@ -430,6 +492,29 @@ def test_UnitHexMesh_assemble():
     assert(vol == pytest.approx(1, rel=1e-9))
 
 
+@pytest.mark.parametrize("ordering", [cpp.mesh.CellOrdering.morton,
+                                      cpp.mesh.CellOrdering.reverse_cuthill_mckee])
+def test_cell_traversal_order(ordering):
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 5, 4, 3)
+    tdim = mesh.topology.dim
+    num_cells = mesh.topology.index_map(tdim).size_local
+    order = cpp.mesh.compute_cell_traversal_order(mesh, ordering)
+    assert sorted(order) == list(range(num_cells))
+
+    vol0 = assemble_scalar(dolfinx.fem.Form(1 * dx(mesh)))
+    mesh.topology.set_cell_traversal_order(order)
+    assert mesh.topology.cell_traversal_order == order
+    M = dolfinx.fem.Form(1 * dx(mesh))
+    assert np.array_equal(M._cpp_object.integrals.integral_domains(dolfinx.fem.IntegralType.cell, 0), order)
+    vol1 = assemble_scalar(M)
+    assert vol1 == pytest.approx(vol0, rel=1e-12)
+
+    with pytest.raises(RuntimeError):
+        mesh.topology.set_cell_traversal_order(order[:-1])
+    mesh.topology.set_cell_traversal_order([])
+    assert mesh.topology.cell_traversal_order == []
+
+
 def xtest_mesh_order_unchanged_triangle():
     points = [[0, 0], [1, 0], [1, 1]]
     cells = [[0, 1, 2]]